@@ -0,0 +1,574 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_bench.cpp                                                ///
+///                                                                             ///
+/// Penguin2DBench measures the throughput of the renderer, sprites, text and   ///
+/// the game loop without a GPU or a visible window, and prints the results as  ///
+/// JSON so they can be compared across releases.                               ///
+///                                                                             ///
+/// The benchmarks run on SDL's offscreen video driver (falling back to the     ///
+/// dummy driver) with the software renderer, so results depend only on the    ///
+/// CPU. Usage: Penguin2DBench [--frames N] [--output results.json]             ///
+///////////////////////////////////////////////////////////////////////////////////
+
+// Penguin2D related include files
+#include "penguin_init.hpp"
+#include "penguin_game_window.hpp"
+#include "penguin_base_game.hpp"
+#include "penguin_state_buffer.hpp"
+#include "penguin_sprite.hpp"
+#include "penguin_sprite_batch.hpp"
+#include "penguin_text.hpp"
+#include "penguin_world.hpp"
+#include "penguin_entity.hpp"
+#include "penguin_spatial_hash.hpp"
+#include "penguin_aabb_tree.hpp"
+#include "rect2_batch.hpp"
+#include "vector2_array.hpp"
+#include "json_escape.hpp"
+
+// SDL related include files
+#include <SDL3/SDL.h>
+
+// C++ library files
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Penguin2D;
+
+#ifndef PENGUIN_BENCH_FONT
+#define PENGUIN_BENCH_FONT "fonts/pixelify_sans_regular.ttf"
+#endif
+
+namespace {
+
+	constexpr int WINDOW_WIDTH = 640; /// The width of the benchmark window.
+	constexpr int WINDOW_HEIGHT = 480; /// The height of the benchmark window.
+	constexpr int DRAWS_PER_FRAME = 1000; /// The number of draws made in each frame of a draw benchmark.
+	constexpr int ENTITIES = 100000; /// The number of entities updated in each frame of an entity benchmark.
+	constexpr int COLLIDERS = 20000; /// The number of colliders moved in each frame of a collision benchmark.
+	constexpr int AREA_QUERIES = 100; /// The number of area queries made in each frame of a query benchmark.
+
+	/// @brief The measurements of a single benchmark.
+	struct BenchResult {
+		std::string name; /// The name of the benchmark.
+		int frames; /// The number of frames measured.
+		long long operations; /// The number of operations measured (e.g., draw calls).
+		double total_ms; /// The total time of the measured frames in milliseconds.
+	};
+
+	/// @brief Runs and records benchmarks.
+	class BenchRunner {
+	public:
+		BenchRunner(int frames) : frames(frames) {}
+
+		/// @brief Measures a benchmark made of frames of a fixed number of operations.
+		///
+		/// One unmeasured frame is run first, so caches and scratch buffers are warm.
+		///
+		/// @param name: The name of the benchmark.
+		/// @param operations_per_frame: The number of operations made by each frame.
+		/// @param frame: Runs a single frame of the benchmark.
+		void measure(const std::string& name, int operations_per_frame, const std::function<void()>& frame) {
+			frame();
+
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < frames; i++) {
+				frame();
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			record(BenchResult{ name, frames, (long long)frames * operations_per_frame, std::chrono::duration<double, std::milli>(end - start).count() });
+		}
+
+		/// @brief Records a benchmark that was measured elsewhere.
+		/// @param result: The measurements of the benchmark.
+		void record(const BenchResult& result) {
+			std::cerr << result.name << ": " << result.total_ms << " ms" << std::endl;
+			results.push_back(result);
+		}
+
+		/// @brief Adds a value computed by a benchmark to the checksum written with the results.
+		///
+		/// Counting a benchmark's results (e.g., query hits) into the output keeps the compiler
+		/// from discarding the work being measured.
+		///
+		/// @param value: The value to add.
+		void add_checksum(size_t value) {
+			checksum += value;
+		}
+
+		/// @brief Writes every result as a JSON document.
+		/// @param out: The stream to write to.
+		/// @param video_driver: The name of the SDL video driver in use.
+		/// @param render_driver: The name of the SDL render driver in use.
+		void write_json(std::ostream& out, const std::string& video_driver, const std::string& render_driver) const {
+			out << "{\n";
+			out << "  \"video_driver\": \"" << json_escape(video_driver) << "\",\n";
+			out << "  \"render_driver\": \"" << json_escape(render_driver) << "\",\n";
+			out << "  \"window\": [" << WINDOW_WIDTH << ", " << WINDOW_HEIGHT << "],\n";
+			out << "  \"checksum\": " << checksum << ",\n";
+			out << "  \"results\": [\n";
+			for (size_t i = 0; i < results.size(); i++) {
+				const BenchResult& result = results[i];
+				double seconds = result.total_ms / 1000.0;
+				out << "    { \"name\": \"" << json_escape(result.name) << "\""
+					<< ", \"frames\": " << result.frames
+					<< ", \"operations\": " << result.operations
+					<< ", \"total_ms\": " << result.total_ms
+					<< ", \"ms_per_frame\": " << result.total_ms / result.frames
+					<< ", \"ns_per_operation\": " << (result.operations > 0 ? result.total_ms * 1.0e6 / result.operations : 0.0)
+					<< ", \"operations_per_second\": " << (seconds > 0.0 ? result.operations / seconds : 0.0)
+					<< " }" << (i + 1 < results.size() ? "," : "") << "\n";
+			}
+			out << "  ]\n";
+			out << "}\n";
+		}
+
+		int frames; /// The number of frames measured per benchmark.
+
+	private:
+		std::vector<BenchResult> results; /// The recorded results, in the order they ran.
+		size_t checksum = 0; /// The sum of the values added with add_checksum().
+	};
+
+	/// @brief A game that draws a fixed scene and closes its window after a number of frames.
+	///
+	/// The squares are handed from update() to draw() through a PenguinStateBuffer, so the
+	/// game can also run with pipelining enabled.
+	class SyntheticGame : public PenguinBaseGame {
+	public:
+		SyntheticGame(PenguinGameWindow& window, int frames) : PenguinBaseGame(window), frames_left(frames) {}
+
+		int updates = 0; /// The number of fixed updates run.
+		int draws = 0; /// The number of frames drawn.
+
+	protected:
+		void update(double delta_time) override {
+			for (Vector2<float>& ball : balls.get_update_state()) {
+				ball.x = ball.x + (float)(120.0 * delta_time);
+				if (ball.x > WINDOW_WIDTH) {
+					ball.x -= WINDOW_WIDTH;
+				}
+			}
+			updates++;
+		}
+
+		void publish_state() override {
+			balls.publish();
+		}
+
+		void draw(double alpha) override {
+			game_window.renderer.clear();
+			for (const Vector2<float>& ball : balls.get_draw_state()) {
+				game_window.renderer.draw_filled_rect(Rect2<float>(ball.x, ball.y, 8.0f, 8.0f), Colours::YELLOW);
+			}
+			game_window.renderer.present();
+
+			draws++;
+			if (--frames_left <= 0) {
+				game_window.close_window();
+			}
+		}
+
+		void init() override {
+			std::vector<Vector2<float>> initial_balls;
+			for (int i = 0; i < 200; i++) {
+				initial_balls.push_back(Vector2<float>((float)((i * 37) % WINDOW_WIDTH), (float)((i * 53) % WINDOW_HEIGHT)));
+			}
+			balls.reset(initial_balls);
+		}
+
+	private:
+		int frames_left; /// The number of frames left before the window closes.
+		PenguinStateBuffer<std::vector<Vector2<float>>> balls; /// The positions of the moving squares.
+	};
+
+	/// @brief Writes a small checkerboard image for the sprite benchmarks.
+	/// @return The path to the image.
+	std::string write_bench_image() {
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "penguin_bench_sprite.bmp";
+
+		std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)> surface(SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA32), &SDL_DestroySurface);
+		Exception::throw_if(!surface, "The benchmark image could not be created.", INIT_ERROR);
+		for (int y = 0; y < 32; y += 8) {
+			for (int x = 0; x < 32; x += 8) {
+				SDL_Rect cell = { x, y, 8, 8 };
+				SDL_FillSurfaceRect(surface.get(), &cell, ((x + y) / 8) % 2 ? 0xFFFFFFFF : 0xFF000000);
+			}
+		}
+		Exception::throw_if(!SDL_SaveBMP(surface.get(), path.string().c_str()), "The benchmark image could not be saved.", INIT_ERROR);
+		return path.string();
+	}
+
+	/// @brief Runs every renderer primitive in each render mode.
+	void bench_primitives(BenchRunner& runner, PenguinRenderer& renderer) {
+		const std::pair<PenguinRenderMode, const char*> modes[] = {
+			{ PenguinRenderMode::IMMEDIATE, "immediate" },
+			{ PenguinRenderMode::BATCHED, "batched" },
+			{ PenguinRenderMode::SORTED, "sorted" }
+		};
+		const Colour palette[] = { Colours::RED, Colours::GREEN, Colours::BLUE, Colours::YELLOW };
+
+		const std::pair<const char*, std::function<void(int)>> primitives[] = {
+			{ "draw_pixel", [&](int i) { renderer.draw_pixel(Vector2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT)), palette[i % 4]); } },
+			{ "draw_line", [&](int i) { renderer.draw_line(Vector2<float>((float)(i % WINDOW_WIDTH), 0.0f), Vector2<>((float)((i * 7) % WINDOW_WIDTH), (float)WINDOW_HEIGHT), palette[i % 4]); } },
+			{ "draw_rect", [&](int i) { renderer.draw_rect(Rect2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT), 16.0f, 16.0f), palette[i % 4]); } },
+			{ "draw_filled_rect", [&](int i) { renderer.draw_filled_rect(Rect2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT), 16.0f, 16.0f), palette[i % 4]); } },
+			{ "draw_circle", [&](int i) { renderer.draw_circle(Vector2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT)), 8 + i % 4, palette[i % 4]); } },
+			{ "draw_filled_circle", [&](int i) { renderer.draw_filled_circle(Vector2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT)), 8 + i % 4, palette[i % 4]); } },
+			{ "draw_ellipse", [&](int i) { renderer.draw_ellipse(Vector2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT)), 12, 6 + i % 4, palette[i % 4]); } },
+			{ "draw_filled_ellipse", [&](int i) { renderer.draw_filled_ellipse(Vector2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT)), 12, 6 + i % 4, palette[i % 4]); } }
+		};
+
+		for (const auto& [mode, mode_name] : modes) {
+			renderer.set_render_mode(mode);
+			for (const auto& [primitive_name, draw] : primitives) {
+				runner.measure(std::string("renderer.") + primitive_name + "." + mode_name, DRAWS_PER_FRAME, [&]() {
+					renderer.clear();
+					for (int i = 0; i < DRAWS_PER_FRAME; i++) {
+						draw(i);
+					}
+					renderer.present();
+				});
+			}
+		}
+		renderer.set_render_mode(PenguinRenderMode::IMMEDIATE);
+	}
+
+	/// @brief Runs sprite draws, one at a time and through a sprite batch.
+	void bench_sprites(BenchRunner& runner, PenguinRenderer& renderer) {
+		PenguinSprite sprite(renderer, write_bench_image());
+		PenguinSpriteBatch batch(renderer);
+
+		runner.measure("sprite.draw_sprite", DRAWS_PER_FRAME, [&]() {
+			renderer.clear();
+			for (int i = 0; i < DRAWS_PER_FRAME; i++) {
+				sprite.draw_sprite(Rect2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT), 32.0f, 32.0f));
+			}
+			renderer.present();
+		});
+
+		runner.measure("sprite.draw_sprite_region", DRAWS_PER_FRAME, [&]() {
+			renderer.clear();
+			for (int i = 0; i < DRAWS_PER_FRAME; i++) {
+				sprite.draw_sprite_region(Rect2<float>(8.0f, 8.0f, 16.0f, 16.0f), Rect2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT), 16.0f, 16.0f));
+			}
+			renderer.present();
+		});
+
+		runner.measure("sprite.batch", DRAWS_PER_FRAME, [&]() {
+			renderer.clear();
+			batch.begin();
+			for (int i = 0; i < DRAWS_PER_FRAME; i++) {
+				batch.draw(sprite, Rect2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT), 32.0f, 32.0f), (float)(i % 360));
+			}
+			batch.end();
+			renderer.present();
+		});
+	}
+
+	/// @brief Runs static and changing text draws.
+	void bench_text(BenchRunner& runner, PenguinRenderer& renderer, PenguinTextRenderer& text_renderer) {
+		constexpr int LABELS = 100;
+		std::vector<std::unique_ptr<PenguinText>> labels;
+		for (int i = 0; i < LABELS; i++) {
+			labels.push_back(std::make_unique<PenguinText>(text_renderer, PENGUIN_BENCH_FONT, "Static label " + std::to_string(i), 16.0f));
+		}
+
+		runner.measure("text.draw_static", LABELS, [&]() {
+			renderer.clear();
+			for (int i = 0; i < LABELS; i++) {
+				labels[i]->draw_text(Vector2<float>(0.0f, (float)(i * 4 % WINDOW_HEIGHT)));
+			}
+			renderer.present();
+		});
+
+		int frame = 0;
+		runner.measure("text.draw_changing", LABELS, [&]() {
+			renderer.clear();
+			for (int i = 0; i < LABELS; i++) {
+				labels[i]->set_text_string("Score: " + std::to_string(frame * LABELS + i));
+				labels[i]->draw_text(Vector2<float>(0.0f, (float)(i * 4 % WINDOW_HEIGHT)));
+			}
+			renderer.present();
+			frame++;
+		});
+	}
+
+	/// @brief A position component for the entity benchmarks.
+	struct BenchPosition {
+		float x, y;
+	};
+
+	/// @brief A velocity component for the entity benchmarks.
+	struct BenchVelocity {
+		float x, y;
+	};
+
+	/// @brief An entity that moves itself, updated through the PenguinEntity interface.
+	class BenchMover : public PenguinEntity {
+	public:
+		BenchMover(float x, float y, float velocity_x, float velocity_y) : position{ x, y }, velocity{ velocity_x, velocity_y } {}
+
+		void init() override {}
+
+		void update(float delta_time) override {
+			position.x += velocity.x * delta_time;
+			position.y += velocity.y * delta_time;
+		}
+
+	private:
+		BenchPosition position;
+		BenchVelocity velocity;
+	};
+
+	/// @brief Moves entities by their velocity, stored as separate heap objects, in a PenguinWorld and in Vector2Arrays.
+	void bench_entities(BenchRunner& runner) {
+		constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+		std::vector<std::unique_ptr<PenguinEntity>> movers;
+		for (int i = 0; i < ENTITIES; i++) {
+			movers.push_back(std::make_unique<BenchMover>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT), 1.0f, 2.0f));
+		}
+
+		runner.measure("entities.virtual_update", ENTITIES, [&]() {
+			for (std::unique_ptr<PenguinEntity>& mover : movers) {
+				mover->update(DELTA_TIME);
+			}
+		});
+
+		PenguinWorld world;
+		for (int i = 0; i < ENTITIES; i++) {
+			world.create(BenchPosition{ (float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT) }, BenchVelocity{ 1.0f, 2.0f });
+		}
+
+		runner.measure("entities.world_each", ENTITIES, [&]() {
+			world.each<BenchPosition, const BenchVelocity>([](BenchPosition& position, const BenchVelocity& velocity) {
+				position.x += velocity.x * DELTA_TIME;
+				position.y += velocity.y * DELTA_TIME;
+			});
+		});
+
+		Vector2Array positions;
+		Vector2Array velocities(ENTITIES, Vector2<float>(1.0f, 2.0f));
+		for (int i = 0; i < ENTITIES; i++) {
+			positions.push_back(Vector2<float>((float)(i % WINDOW_WIDTH), (float)(i % WINDOW_HEIGHT)));
+		}
+
+		runner.measure("entities.vector2_array_integrate", ENTITIES, [&]() {
+			positions.integrate(velocities, DELTA_TIME);
+		});
+	}
+
+	/// @brief Moves colliders around a wrapping field and finds the overlapping pairs each frame.
+	void bench_collision(BenchRunner& runner) {
+		constexpr float FIELD_SIZE = 4000.0f;
+
+		std::vector<Rect2<float>> bounds;
+		std::vector<Vector2<float>> velocities;
+		PenguinSpatialHash spatial_hash(16.0f);
+		for (int i = 0; i < COLLIDERS; i++) {
+			bounds.push_back(Rect2<float>((float)((i * 7919) % 4000), (float)((i * 104729) % 4000), 4.0f + i % 8, 4.0f + i % 5));
+			velocities.push_back(Vector2<float>((float)(i % 7) - 3.0f, (float)(i % 5) - 2.0f));
+			spatial_hash.insert((PenguinColliderId)i, bounds.back());
+		}
+
+		std::vector<PenguinColliderPair> pairs;
+		runner.measure("collision.spatial_hash", COLLIDERS, [&]() {
+			for (int i = 0; i < COLLIDERS; i++) {
+				Rect2<float>& collider = bounds[i];
+				collider += velocities[i];
+				collider.position.x = collider.position.x < 0.0f ? collider.position.x + FIELD_SIZE : (collider.position.x > FIELD_SIZE ? collider.position.x - FIELD_SIZE : collider.position.x);
+				collider.position.y = collider.position.y < 0.0f ? collider.position.y + FIELD_SIZE : (collider.position.y > FIELD_SIZE ? collider.position.y - FIELD_SIZE : collider.position.y);
+				spatial_hash.move((PenguinColliderId)i, collider);
+			}
+			spatial_hash.query_pairs(pairs);
+		});
+	}
+
+	/// @brief Checks that the batch rect tests match Rect2::has_intersection() before they are timed.
+	///
+	/// The rects sit on a coarse grid, so many of them touch at an edge or a corner, and include
+	/// empty and zero-sized ones. Every count up to a few SIMD widths is tested, so the vector
+	/// loop and its scalar tail are both covered. If a result differs, an exception is thrown.
+	void check_rect2_batch() {
+		std::vector<Rect2<float>> rects;
+		for (int i = 0; i < 200; i++) {
+			float sizes[] = { -1.0f, 0.0f, 4.0f, 8.0f, 16.0f };
+			rects.push_back(Rect2<float>((float)(i % 5 - 2) * 8.0f, (float)(i / 5 % 5 - 2) * 8.0f, sizes[i % 5], sizes[i / 3 % 5]));
+		}
+
+		std::vector<uint8_t> results(rects.size());
+		std::vector<uint32_t> indices(rects.size());
+		for (const Rect2<float>& rect : { Rect2<float>(0.0f, 0.0f, 8.0f, 8.0f), Rect2<float>(-4.0f, 4.0f, 0.0f, 0.0f), Rect2<float>(8.0f, -8.0f, 16.0f, 4.0f), Rect2<float>(0.0f, 0.0f, -1.0f, 8.0f) }) {
+			for (size_t count = 0; count <= 67; count++) {
+				size_t hits = rect2_intersect_batch(rect, rects.data(), count, results.data());
+				size_t found = rect2_find_intersections(rect, rects.data(), count, indices.data());
+
+				size_t expected_hits = 0;
+				for (size_t i = 0; i < count; i++) {
+					bool expected = rect.has_intersection(rects[i]);
+					Exception::throw_if((results[i] != 0) != expected, "rect2_intersect_batch() disagrees with Rect2::has_intersection() at index " + std::to_string(i) + ".", RUNTIME_ERROR);
+					if (expected) {
+						Exception::throw_if(expected_hits >= found || indices[expected_hits] != i, "rect2_find_intersections() missed index " + std::to_string(i) + ".", RUNTIME_ERROR);
+						expected_hits++;
+					}
+				}
+				Exception::throw_if(hits != expected_hits || found != expected_hits, "The batch rect tests counted the wrong number of hits.", RUNTIME_ERROR);
+			}
+		}
+	}
+
+	/// @brief Runs area queries against an AABB tree and against a loop over every collider, at several collider counts.
+	void bench_area_queries(BenchRunner& runner) {
+		for (int collider_count : { 1000, 10000, 100000 }) {
+			// Keep the density constant, so each query finds about the same number of colliders.
+			float field_size = std::sqrt((float)collider_count) * 40.0f;
+			std::vector<Rect2<float>> bounds;
+			std::vector<std::pair<PenguinColliderId, Rect2<float>>> level;
+			for (int i = 0; i < collider_count; i++) {
+				bounds.push_back(Rect2<float>(std::fmod(i * 7919.0f, field_size), std::fmod(i * 104729.0f * 0.37f, field_size), 4.0f + i % 8, 4.0f + i % 5));
+				level.emplace_back((PenguinColliderId)i, bounds.back());
+			}
+
+			std::vector<Rect2<float>> areas;
+			for (int i = 0; i < AREA_QUERIES; i++) {
+				areas.push_back(Rect2<float>(std::fmod(i * 3571.0f, field_size), std::fmod(i * 6151.0f, field_size), 64.0f, 64.0f));
+			}
+
+			std::string suffix = "." + std::to_string(collider_count);
+			size_t hits = 0;
+			runner.measure("collision.naive_query" + suffix, AREA_QUERIES, [&]() {
+				for (const Rect2<float>& area : areas) {
+					for (const Rect2<float>& collider : bounds) {
+						hits += area.has_intersection(collider) ? 1 : 0;
+					}
+				}
+			});
+
+			std::vector<uint32_t> indices(bounds.size());
+			runner.measure("collision.batch_query" + suffix, AREA_QUERIES, [&]() {
+				for (const Rect2<float>& area : areas) {
+					hits += rect2_find_intersections(area, bounds.data(), bounds.size(), indices.data());
+				}
+			});
+
+			PenguinAABBTree tree;
+			tree.build(level, false);
+			std::vector<PenguinColliderId> results;
+			runner.measure("collision.aabb_tree_query" + suffix, AREA_QUERIES, [&]() {
+				for (const Rect2<float>& area : areas) {
+					tree.query_rect(area, results);
+					hits += results.size();
+				}
+			});
+
+			int frame = 0;
+			runner.measure("collision.aabb_tree_move" + suffix, collider_count, [&]() {
+				Vector2<float> displacement(frame % 2 ? -1.5f : 1.5f, 0.5f);
+				for (int i = 0; i < collider_count; i++) {
+					bounds[i] += displacement;
+					tree.move((PenguinColliderId)i, bounds[i], displacement);
+				}
+				frame++;
+			});
+			runner.add_checksum(hits);
+		}
+	}
+
+	/// @brief Runs the full game loop with a synthetic game until it has drawn the requested frames.
+	/// @param name: The name of the benchmark.
+	void bench_game_loop(BenchRunner& runner, PenguinGameWindow& game_window, const std::string& name) {
+		auto game = std::make_unique<SyntheticGame>(game_window, runner.frames);
+		SyntheticGame& synthetic_game = *game;
+		game_window.connect_game(std::move(game));
+
+		auto start = std::chrono::steady_clock::now();
+		game_window.run();
+		auto end = std::chrono::steady_clock::now();
+
+		runner.record(BenchResult{ name, synthetic_game.draws, synthetic_game.draws, std::chrono::duration<double, std::milli>(end - start).count() });
+	}
+}
+
+int main(int argc, char* argv[]) {
+	int frames = 200;
+	std::string output_path;
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "--frames" && i + 1 < argc) {
+			frames = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (argument == "--output" && i + 1 < argc) {
+			output_path = argv[++i];
+		}
+		else {
+			std::cerr << "Usage: Penguin2DBench [--frames N] [--output results.json]" << std::endl;
+			return 1;
+		}
+	}
+
+	// Run without a display or GPU. The offscreen driver is preferred, as the dummy driver
+	// cannot create renderers on every platform.
+	SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+	if (!SDL_Init(SDL_INIT_VIDEO)) {
+		SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+	}
+	SDL_Quit();
+
+	try {
+		PenguinInit();
+
+		std::string video_driver;
+		std::string render_driver;
+		{
+			BenchRunner runner(frames);
+			PenguinGameWindow game_window("Penguin2DBench", WINDOW_WIDTH, WINDOW_HEIGHT);
+
+			const char* current_video_driver = SDL_GetCurrentVideoDriver();
+			const char* current_render_driver = SDL_GetRendererName(game_window.renderer.get_renderer());
+			video_driver = current_video_driver ? current_video_driver : "unknown";
+			render_driver = current_render_driver ? current_render_driver : "unknown";
+
+			bench_primitives(runner, game_window.renderer);
+			bench_sprites(runner, game_window.renderer);
+			bench_text(runner, game_window.renderer, game_window.text_renderer);
+			bench_entities(runner);
+			bench_collision(runner);
+			check_rect2_batch();
+			bench_area_queries(runner);
+			bench_game_loop(runner, game_window, "game_window.run");
+
+			// A closed window cannot be reopened, so the pipelined loop gets a window of its own.
+			PenguinGameWindow pipelined_window("Penguin2DBench (pipelined)", WINDOW_WIDTH, WINDOW_HEIGHT);
+			pipelined_window.set_pipelined(true);
+			bench_game_loop(runner, pipelined_window, "game_window.run_pipelined");
+
+			if (output_path.empty()) {
+				runner.write_json(std::cout, video_driver, render_driver);
+			}
+			else {
+				std::ofstream output(output_path);
+				Exception::throw_if(!output, "The results file could not be opened: " + output_path, RUNTIME_ERROR);
+				runner.write_json(output, video_driver, render_driver);
+			}
+		}
+
+		PenguinQuit();
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		PenguinQuit();
+		return 1;
+	}
+}
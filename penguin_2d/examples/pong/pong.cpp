@@ -24,11 +24,17 @@ void PongGame::init() {
     game_floor.position = Vector2<float>(0.0f, game_window.height - 10.0f);
     game_ceiling.position = Vector2<float>(0.0f, 0.0f);
 
+    // Draw the ball and paddles between their last two updated positions
+    game_window.interpolation.clear();
+    game_window.interpolation.add(BALL_ID, pong_ball.ball_rect.position);
+    game_window.interpolation.add(FIRST_PADDLE_ID, first_player.paddle.position);
+    game_window.interpolation.add(SECOND_PADDLE_ID, second_player.paddle.position);
+
     // Set the initial points of the two players
     points_first_player.set_text_string(std::to_string(0));
-    points_first_player.font.set_font_size(64.0f);
+    points_first_player.set_font_size(64.0f);
     points_second_player.set_text_string(std::to_string(0));
-    points_second_player.font.set_font_size(64.0f);
+    points_second_player.set_font_size(64.0f);
 
     // Randomize the pong ball's direction and velocity
     reset_ball_velocity(true);
@@ -60,12 +66,13 @@ void PongGame::update(double delta_time) {
             else {
                 move_right_paddle_ai(delta_time);
             }
+            store_positions();
         }
     }
 }
 
 /// @brief Draws the game objects onto the screen, including paddles, ball floor, ceiling, and score text.
-/// @param alpha: Interpolation factor for smooth rendering (experimental).
+/// @param alpha: Interpolation factor, already applied to the positions in game_window.interpolation.
 void PongGame::draw(double alpha) {
     if (!is_playing) {
         display_title_screen();
@@ -75,7 +82,7 @@ void PongGame::draw(double alpha) {
         game_window.renderer.clear();
 
         // Draw pong ball onto the screen
-        game_window.renderer.draw_filled_rect(pong_ball.ball_rect, Colours::WHITE);
+        game_window.renderer.draw_filled_rect(Rect2<float>(game_window.interpolation.get_render_position(BALL_ID), pong_ball.ball_rect.size), Colours::WHITE);
 
         // Draw floor and ceiling to the screen
         game_window.renderer.draw_filled_rect(game_floor, Colours::WHITE);
@@ -85,8 +92,8 @@ void PongGame::draw(double alpha) {
         game_window.renderer.draw_line(Vector2<float>((float)game_window.width / 2.0f + 4.0f, 0.0f), Vector2<float>((float)game_window.width / 2.0f + 4.0f, (float)game_window.height), Colours::WHITE);
 
         // Draw the players onto the screen
-        game_window.renderer.draw_filled_rect(first_player.paddle, Colours::WHITE);
-        game_window.renderer.draw_filled_rect(second_player.paddle, Colours::WHITE);
+        game_window.renderer.draw_filled_rect(Rect2<float>(game_window.interpolation.get_render_position(FIRST_PADDLE_ID), first_player.paddle.size), Colours::WHITE);
+        game_window.renderer.draw_filled_rect(Rect2<float>(game_window.interpolation.get_render_position(SECOND_PADDLE_ID), second_player.paddle.size), Colours::WHITE);
 
         // Draw player scores
         points_first_player.draw_text(Vector2<float>(game_window.width / 4.0f - 10.0f, 20.0f));
@@ -110,13 +117,13 @@ void PongGame::draw(double alpha) {
 void PongGame::update_title_screen() {
     if (game_window.input.is_key_pressed(PenguinKey::KEY_W) || game_window.input.is_key_pressed(PenguinKey::UP)) {
         is_two_player = false;
-        one_player_text.font.set_font_size(48.0f);
-        two_player_text.font.set_font_size(32.0f);
+        one_player_text.set_font_size(48.0f);
+        two_player_text.set_font_size(32.0f);
     }
     if (game_window.input.is_key_pressed(PenguinKey::KEY_S) || game_window.input.is_key_pressed(PenguinKey::DOWN)) {
         is_two_player = true;
-        one_player_text.font.set_font_size(32.0f);
-        two_player_text.font.set_font_size(48.0f);
+        one_player_text.set_font_size(32.0f);
+        two_player_text.set_font_size(48.0f);
     }
     if (game_window.input.is_key_pressed(PenguinKey::ENTER)) {
         is_playing = true;
@@ -252,6 +259,7 @@ void PongGame::handle_out_of_bounds() {
 
         // Reset ball back to the middle of the screen
         pong_ball.ball_rect.position = Vector2<float>((float)game_window.width / 2.0f, (float)game_window.height / 2.0f); 
+        game_window.interpolation.teleport(BALL_ID, pong_ball.ball_rect.position);
         reset_ball_velocity(false); // Ball moves towards player 1
     }
     // Pong ball goes out of the screen on the right-hand side
@@ -261,6 +269,7 @@ void PongGame::handle_out_of_bounds() {
 
         // Reset ball back to the middle of the screen
         pong_ball.ball_rect.position = Vector2<float>((float)game_window.width / 2.0f, (float)game_window.height / 2.0f); 
+        game_window.interpolation.teleport(BALL_ID, pong_ball.ball_rect.position);
         reset_ball_velocity(true); // Ball moves towards player 2
     }
 }
@@ -276,10 +285,17 @@ void PongGame::reset_ball_velocity(bool to_second_player) {
     pong_ball.velocity.y = speed * sin(angle);
 }
 
+/// @brief Stores the updated positions of the ball and paddles, to be interpolated before drawing.
+void PongGame::store_positions() {
+    game_window.interpolation.set_position(BALL_ID, pong_ball.ball_rect.position);
+    game_window.interpolation.set_position(FIRST_PADDLE_ID, first_player.paddle.position);
+    game_window.interpolation.set_position(SECOND_PADDLE_ID, second_player.paddle.position);
+}
+
 /// @brief Checks if the game should be closed based on user input.
-/// @return bool: True if any key is pressed, false otherwise.
+/// @return bool: True if any key was pressed since the last update, false otherwise.
 bool PongGame::close_game() {
-    if (game_window.input.is_any_key_pressed()) {
+    if (game_window.input.is_any_key_just_pressed()) {
         return true;
     }
     return false;
@@ -79,6 +79,11 @@ private:
     const int GOAL_POINTS = 11;
     const float MIN_DIFF = 10.0f;
 
+    // Ids of the objects drawn at their interpolated positions
+    static constexpr PenguinInterpolationId BALL_ID = 0;
+    static constexpr PenguinInterpolationId FIRST_PADDLE_ID = 1;
+    static constexpr PenguinInterpolationId SECOND_PADDLE_ID = 2;
+
     void update_title_screen();
     void display_title_screen();
     void move_left_paddle(double delta_time);
@@ -90,6 +95,7 @@ private:
     void handle_wall_collision();
     void handle_out_of_bounds();
     void reset_ball_velocity(bool to_second_player);
+    void store_positions();
     bool close_game();
 };
 
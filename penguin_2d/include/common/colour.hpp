@@ -35,6 +35,17 @@ struct Colour {
     constexpr Colour(unsigned int r, unsigned int g, unsigned int b, unsigned int a)
         : red(r), green(g), blue(b), alpha(a) {
     }
+
+    /// @brief Packs the colour into a single 32-bit RGBA value.
+    /// @return The colour as 0xRRGGBBAA.
+    constexpr unsigned int to_rgba() const {
+        return ((red & 0xFF) << 24) | ((green & 0xFF) << 16) | ((blue & 0xFF) << 8) | (alpha & 0xFF);
+    }
+
+    // Equality operators
+
+    constexpr bool operator==(const Colour& other_colour) const { return to_rgba() == other_colour.to_rgba(); }
+    constexpr bool operator!=(const Colour& other_colour) const { return to_rgba() != other_colour.to_rgba(); }
 };
 
 /// @brief Provides a collection of predefined color constants.
@@ -0,0 +1,29 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: file_path.hpp                                                    ///
+///                                                                             ///
+/// Defines get_canonical_path(), which turns file paths into the keys that     ///
+/// caches of loaded files (textures, fonts) look them up by, so two paths to   ///
+/// the same file share one entry.                                              ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FILE_PATH_HPP
+#define FILE_PATH_HPP
+
+// C++ library files
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace Penguin2D {
+
+	/// @brief Converts a file path into the key used to look up its loaded file.
+	/// @param path: The file path to convert.
+	/// @return The canonical form of the path, or the path itself if it cannot be resolved.
+	inline std::string get_canonical_path(const std::string& path) {
+		std::error_code error;
+		std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+		return error ? path : canonical.generic_string();
+	}
+}
+
+#endif // FILE_PATH_HPP
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: json_escape.hpp                                                  ///
+///                                                                             ///
+/// Defines json_escape(), which makes a string safe to write between quotes    ///
+/// in a JSON document, such as a profiler trace or benchmark results.          ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_ESCAPE_HPP
+#define JSON_ESCAPE_HPP
+
+// C++ library files
+#include <string>
+#include <string_view>
+
+namespace Penguin2D {
+
+	/// @brief Escapes a string for use as a JSON string value, without the surrounding quotes.
+	///
+	/// Quotes and backslashes are escaped, and control characters are written as \uXXXX
+	/// (or their short forms). Other bytes, including UTF-8 sequences, are kept as they are.
+	///
+	/// @param text: The string to escape.
+	/// @return The escaped string.
+	inline std::string json_escape(std::string_view text) {
+		static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+		std::string escaped;
+		escaped.reserve(text.size());
+		for (char character : text) {
+			switch (character) {
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\b': escaped += "\\b"; break;
+			case '\f': escaped += "\\f"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\r': escaped += "\\r"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if ((unsigned char)character < 0x20) {
+					escaped += "\\u00";
+					escaped += HEX_DIGITS[(unsigned char)character >> 4];
+					escaped += HEX_DIGITS[(unsigned char)character & 0xF];
+				}
+				else {
+					escaped += character;
+				}
+			}
+		}
+		return escaped;
+	}
+}
+
+#endif // JSON_ESCAPE_HPP
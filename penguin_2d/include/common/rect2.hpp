@@ -1,14 +1,17 @@
 ///////////////////////////////////////////////////////////////////////////////////
 /// File name: rect2.hpp                                                        ///
 ///                                                                             ///
-/// Defines the Rect2 struct, which represents a rectangle in 2D space.			///
-///																				///
-/// The Rect2 struct includes position and size attributes, represented as		///
-/// Vector2 objects.															///
-/// 																			///
-/// It provides various operations, including intersection detection via		///
-/// has_intersection().															///
-///																				///
+/// Defines the Rect2 struct, which represents a rectangle in 2D space.         ///
+///                                                                             ///
+/// The Rect2 struct includes position and size attributes, represented as      ///
+/// Vector2 objects.                                                            ///
+///                                                                             ///
+/// It provides intersection, containment, union and clipping operations. They  ///
+/// are constexpr and inline, and follow SDL's rules: floating point rects      ///
+/// include their edges and are empty only with a negative size, integer rects  ///
+/// exclude their far edges and are empty with a size of zero or less. See      ///
+/// rect2_batch.hpp to test one rect against an array of rects.                 ///
+///                                                                             ///
 /// Reference: https://github.com/aardhyn/sdl3-template-project/tree/main       ///
 ///////////////////////////////////////////////////////////////////////////////////
 
@@ -39,28 +42,30 @@ struct Rect2 final {
 	/// @brief Constructs a Rect2 with specified position and size.
 	/// @param position The position of the top-left corner.
 	/// @param size The size of the rectangle.
-	Rect2(Vector2<T> position, Vector2<T> size) : position{ position }, size{ size } {}
+	constexpr Rect2(Vector2<T> position, Vector2<T> size) : position{ position }, size{ size } {}
 
 	/// @brief Constructs a Rect2 with a size and position set to the origin (0, 0).
 	/// @param size The size of the rectangle.
-	Rect2(Vector2<T> size) : position{ Vector2<T>(0, 0) }, size{ size } {}
+	constexpr Rect2(Vector2<T> size) : position{ Vector2<T>(0, 0) }, size{ size } {}
 
 	/// @brief Constructs a Rect2 with specified x, y position and x, y size.
 	/// @param x_pos: The x position of the top-left corner.
 	/// @param y_pos: The y position of the top-left corner.
 	/// @param x_size: The width (x size) of the rectangle.
 	/// @param y_size: The height (y size) of the rectangle.
-	Rect2(T x_pos, T y_pos, T x_size, T y_size) : position{ Vector2<T>(x_pos, y_pos) }, size{ Vector2<T>(x_size, y_size) } {}
+	constexpr Rect2(T x_pos, T y_pos, T x_size, T y_size) : position{ Vector2<T>(x_pos, y_pos) }, size{ Vector2<T>(x_size, y_size) } {}
 
 	/// @brief Constructs a `Rect2` with specified width and height, position set to the origin.
 	/// @param x_size: The width (x size) of the rectangle.
 	/// @param y_size: The height (y size) of the rectangle.
-	Rect2(T x_size, T y_size) : position{ Vector2<T>(0, 0) }, size{ Vector2<T>(x_size, y_size) } {}
+	constexpr Rect2(T x_size, T y_size) : position{ Vector2<T>(0, 0) }, size{ Vector2<T>(x_size, y_size) } {}
 
 	// Equality operators
 
-	inline bool operator==(const Rect2<T>& other_rect) const { return position == other_rect.position && size == other_rect.size; }
-	inline bool operator!=(const Rect2<T>& other_rect) const { return *this != other_rect; }
+	inline constexpr bool operator==(const Rect2<T>& other_rect) const {
+		return position.x == other_rect.position.x && position.y == other_rect.position.y && size.x == other_rect.size.x && size.y == other_rect.size.y;
+	}
+	inline constexpr bool operator!=(const Rect2<T>& other_rect) const { return !(*this == other_rect); }
 
 	// Addition & subtraction operators (returns new Rect)
 
@@ -87,27 +92,88 @@ struct Rect2 final {
 		return SDL_FRect{ (float)position.x, (float)position.y, (float)size.x, (float)size.y };
 	}
 
+	/// @brief Checks if the rectangle is empty, so it intersects and contains nothing.
+	/// @return True if a floating point rectangle has a negative size, or an integer rectangle a size of zero or less.
+	inline constexpr bool is_empty() const {
+		if constexpr (std::is_floating_point_v<T>) {
+			return !(size.x >= 0 && size.y >= 0);
+		}
+		else {
+			return size.x <= 0 || size.y <= 0;
+		}
+	}
+
 	/// @brief Checks if two rectangles intersect.
+	///
+	/// Floating point rectangles that only share an edge intersect, integer rectangles do not.
+	///
 	/// @param other_rect: The other rectangle to check for an intersection.
-	inline bool has_intersection(const Rect2<T>& other_rect) const {
-		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-			SDL_FRect sdl_this_rect = { static_cast<float>(this->position.x), static_cast<float>(this->position.y), static_cast<float>(this->size.x), static_cast<float>(this->size.y) };
-			SDL_FRect sdl_other_rect = { static_cast<float>(other_rect.position.x), static_cast<float>(other_rect.position.y), static_cast<float>(other_rect.size.x), static_cast<float>(other_rect.size.y) };
+	/// @return True if the rectangles intersect, otherwise false.
+	inline constexpr bool has_intersection(const Rect2<T>& other_rect) const {
+		if (is_empty() || other_rect.is_empty()) {
+			return false;
+		}
 
-			return SDL_HasRectIntersectionFloat(&sdl_this_rect, &sdl_other_rect);
+		if constexpr (std::is_floating_point_v<T>) {
+			return position.x <= other_rect.position.x + other_rect.size.x && other_rect.position.x <= position.x + size.x
+				&& position.y <= other_rect.position.y + other_rect.size.y && other_rect.position.y <= position.y + size.y;
 		}
 		else {
-			SDL_Rect sdl_this_rect = { static_cast<int>(this->position.x), static_cast<int>(this->position.y), static_cast<int>(this->size.x), static_cast<int>(this->size.y) };
-			SDL_Rect sdl_other_rect = { static_cast<int>(other_rect.position.x), static_cast<int>(other_rect.position.y), static_cast<int>(other_rect.size.x), static_cast<int>(other_rect.size.y) };
-
-			// Use SDL_HasIntersection for integer rects
-			return SDL_HasRectIntersection(&sdl_this_rect, &sdl_other_rect);
+			return position.x < other_rect.position.x + other_rect.size.x && other_rect.position.x < position.x + size.x
+				&& position.y < other_rect.position.y + other_rect.size.y && other_rect.position.y < position.y + size.y;
 		}
 	}
 
 	/// @brief Checks if a point exists in the rectangle.
-	/// @return True if the point is within the rectangle, false otherwise.
-	inline bool contains_point(Vector2<T> point) const { return point < position + size && point > position; }
+	/// @return True if the point is strictly within the rectangle, false otherwise.
+	inline constexpr bool contains_point(Vector2<T> point) const {
+		return point.x > position.x && point.y > position.y && point.x < position.x + size.x && point.y < position.y + size.y;
+	}
+
+	/// @brief Checks if another rectangle lies entirely within this one.
+	/// @param other_rect: The other rectangle.
+	/// @return True if neither rectangle is empty and the other one is within this one, edges included, otherwise false.
+	inline constexpr bool contains(const Rect2<T>& other_rect) const {
+		return !is_empty() && !other_rect.is_empty()
+			&& other_rect.position.x >= position.x && other_rect.position.y >= position.y
+			&& other_rect.position.x + other_rect.size.x <= position.x + size.x && other_rect.position.y + other_rect.size.y <= position.y + size.y;
+	}
+
+	/// @brief Clips two rectangles to their intersection.
+	/// @param other_rect: The other rectangle.
+	/// @param result: Set to the intersection, or a zero size rectangle if either rectangle is empty.
+	/// @return True if the intersection is not empty, otherwise false.
+	inline constexpr bool get_intersection(const Rect2<T>& other_rect, Rect2<T>& result) const {
+		if (is_empty() || other_rect.is_empty()) {
+			result = Rect2<T>(position, Vector2<T>(0, 0));
+			return false;
+		}
+
+		T min_x = position.x > other_rect.position.x ? position.x : other_rect.position.x;
+		T min_y = position.y > other_rect.position.y ? position.y : other_rect.position.y;
+		T max_x = position.x + size.x < other_rect.position.x + other_rect.size.x ? position.x + size.x : other_rect.position.x + other_rect.size.x;
+		T max_y = position.y + size.y < other_rect.position.y + other_rect.size.y ? position.y + size.y : other_rect.position.y + other_rect.size.y;
+		result = Rect2<T>(min_x, min_y, max_x - min_x, max_y - min_y);
+		return !result.is_empty();
+	}
+
+	/// @brief Gets the smallest rectangle that contains two rectangles. An empty rectangle is ignored.
+	/// @param other_rect: The other rectangle.
+	/// @return The union, or a zero rectangle at the origin if both rectangles are empty.
+	inline constexpr Rect2<T> get_union(const Rect2<T>& other_rect) const {
+		if (is_empty()) {
+			return other_rect.is_empty() ? Rect2<T>(0, 0, 0, 0) : other_rect;
+		}
+		if (other_rect.is_empty()) {
+			return *this;
+		}
+
+		T min_x = position.x < other_rect.position.x ? position.x : other_rect.position.x;
+		T min_y = position.y < other_rect.position.y ? position.y : other_rect.position.y;
+		T max_x = position.x + size.x > other_rect.position.x + other_rect.size.x ? position.x + size.x : other_rect.position.x + other_rect.size.x;
+		T max_y = position.y + size.y > other_rect.position.y + other_rect.size.y ? position.y + size.y : other_rect.position.y + other_rect.size.y;
+		return Rect2<T>(min_x, min_y, max_x - min_x, max_y - min_y);
+	}
 };
 
 #endif // RECT2_HPP
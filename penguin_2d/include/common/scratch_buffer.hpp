@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: scratch_buffer.hpp                                               ///
+///                                                                             ///
+/// Defines the ScratchBuffer class, a growable arena of trivially copyable     ///
+/// elements that is reset rather than freed between uses.                      ///
+///                                                                             ///
+/// Once a ScratchBuffer has grown to fit a frame's worth of data, writing into ///
+/// it no longer allocates. Every growth is counted so that steady-state        ///
+/// allocations can be verified in benchmarks.                                  ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SCRATCH_BUFFER_HPP
+#define SCRATCH_BUFFER_HPP
+
+// C++ library files
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace Penguin2D {
+
+	/// @brief A growable arena of trivially copyable elements that keeps its capacity when reset.
+	///
+	/// Elements are written at the end of the buffer, either one at a time with push_back()
+	/// or in bulk by reserving space with begin_write() and committing it with end_write().
+	/// Pointers returned by data() and begin_write() are invalidated when the buffer grows.
+	template<typename T>
+	class ScratchBuffer {
+		static_assert(std::is_trivially_copyable_v<T>, "ScratchBuffer only supports trivially copyable types.");
+	public:
+		ScratchBuffer() = default;
+		~ScratchBuffer() = default;
+
+		/// @brief Reserves space for up to max_count elements at the end of the buffer.
+		/// @param max_count: The most elements that will be written.
+		/// @return A pointer to the first reserved element.
+		inline T* begin_write(size_t max_count) {
+			reserve(used + max_count);
+			return storage.get() + used;
+		}
+
+		/// @brief Commits elements written after a call to begin_write().
+		/// @param count: The number of elements written, which must not exceed the reserved count.
+		inline void end_write(size_t count) { used += count; }
+
+		/// @brief Appends an element to the end of the buffer.
+		/// @param value: The element to append.
+		inline void push_back(const T& value) {
+			reserve(used + 1);
+			storage[used++] = value;
+		}
+
+		/// @brief Appends a range of elements to the end of the buffer.
+		/// @param values: The first element to append.
+		/// @param count: The number of elements to append.
+		inline void append(const T* values, size_t count) {
+			std::memcpy(begin_write(count), values, count * sizeof(T));
+			end_write(count);
+		}
+
+		/// @brief Ensures the buffer can hold at least the given number of elements without growing.
+		/// @param new_capacity: The number of elements to make room for.
+		inline void reserve(size_t new_capacity) {
+			if (new_capacity <= capacity) {
+				return;
+			}
+
+			// Grow geometrically so that a buffer filled one element at a time settles quickly.
+			size_t grown_capacity = std::max(new_capacity, capacity * 2);
+			std::unique_ptr<T[]> grown_storage(new T[grown_capacity]);
+			if (used > 0) {
+				std::memcpy(grown_storage.get(), storage.get(), used * sizeof(T));
+			}
+			storage = std::move(grown_storage);
+			capacity = grown_capacity;
+			allocations++;
+		}
+
+		/// @brief Shrinks the buffer back to the given number of elements, keeping its capacity.
+		/// @param new_size: The number of elements to keep.
+		inline void rewind(size_t new_size) { used = std::min(used, new_size); }
+
+		/// @brief Removes all elements, keeping the buffer's capacity.
+		inline void reset() { used = 0; }
+
+		inline T* data() { return storage.get(); }
+		inline const T* data() const { return storage.get(); }
+		inline T& operator[](size_t index) { return storage[index]; }
+		inline const T& operator[](size_t index) const { return storage[index]; }
+		inline size_t size() const { return used; }
+		inline bool empty() const { return used == 0; }
+
+		/// @brief Gets the number of elements the buffer can hold without growing.
+		/// @return The capacity of the buffer.
+		inline size_t get_capacity() const { return capacity; }
+
+		/// @brief Gets the number of times the buffer has grown since it was created.
+		/// @return The number of heap allocations made by the buffer.
+		inline size_t get_allocation_count() const { return allocations; }
+
+	private:
+		std::unique_ptr<T[]> storage; /// The elements of the buffer.
+		size_t capacity = 0; /// The number of elements the storage can hold.
+		size_t used = 0; /// The number of elements written since the last reset.
+		size_t allocations = 0; /// The number of times the storage has grown.
+	};
+}
+
+#endif // SCRATCH_BUFFER_HPP
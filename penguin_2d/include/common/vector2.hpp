@@ -6,6 +6,10 @@
 ///                                                                             ///
 /// The Vector2 struct provides arithmetic operations, comparison operators,    ///
 /// and scalar operations, allowing for flexible mathematical computations.     ///
+/// It also provides the dot and cross products, length, normalization,         ///
+/// distance, interpolation and rotation. Everything except the operations      ///
+/// that need a square root or trigonometry is constexpr. See                   ///
+/// vector2_array.hpp for batches of vectors.                                   ///
 ///                                                                             ///
 /// It supports type conversion between int, float, and double representations. ///
 ///                                                                             ///
@@ -15,6 +19,9 @@
 #ifndef VECTOR2_HPP
 #define VECTOR2_HPP
 
+// C++ library files
+#include <cmath>
+
 /// @brief Represents a 2D vector with x and y components.
 ///
 /// This struct is used to store and manipulate 2D vectors,
@@ -31,36 +38,37 @@ struct Vector2 {
     /// @brief Constructs a Vector2 with specified x and y components.
     /// @param x_pos: The x component of the vector.
     /// @param y_pos: The y component of the vector.
-    Vector2(T x_pos, T y_pos) : x(x_pos), y(y_pos) {}
+    constexpr Vector2(T x_pos, T y_pos) : x(x_pos), y(y_pos) {}
 
     /// @brief Constructs a Vector2 at the origin (0, 0).
-    Vector2() : x{ ORIGIN }, y{ ORIGIN } {}
+    constexpr Vector2() : x{ ORIGIN }, y{ ORIGIN } {}
 
     // Returning new Vector2
 
-    inline Vector2<T> operator+(const Vector2<T>& other_vect) const { return Vector2<T>(x + other_vect.x, y + other_vect.y); }
-    inline Vector2<T> operator-(const Vector2<T>& other_vect) const { return Vector2<T>(x - other_vect.x, y - other_vect.y); }
-    inline Vector2<T> operator*(const Vector2<T>& other_vect) const { return Vector2<T>(x * other_vect.x, y * other_vect.y); }
-    inline Vector2<T> operator/(const Vector2<T>& other_vect) const { return Vector2<T>(x / other_vect.x, y / other_vect.y); }
+    inline constexpr Vector2<T> operator-() const { return Vector2<T>(-x, -y); }
+    inline constexpr Vector2<T> operator+(const Vector2<T>& other_vect) const { return Vector2<T>(x + other_vect.x, y + other_vect.y); }
+    inline constexpr Vector2<T> operator-(const Vector2<T>& other_vect) const { return Vector2<T>(x - other_vect.x, y - other_vect.y); }
+    inline constexpr Vector2<T> operator*(const Vector2<T>& other_vect) const { return Vector2<T>(x * other_vect.x, y * other_vect.y); }
+    inline constexpr Vector2<T> operator/(const Vector2<T>& other_vect) const { return Vector2<T>(x / other_vect.x, y / other_vect.y); }
 
     // Modifying original Vector2
 
-    inline Vector2<T>& operator+=(const Vector2<T>& other_vect) {
+    inline constexpr Vector2<T>& operator+=(const Vector2<T>& other_vect) {
         x += other_vect.x;
         y += other_vect.y;
         return *this;
     }
-    inline Vector2<T>& operator-=(const Vector2<T>& other_vect) {
+    inline constexpr Vector2<T>& operator-=(const Vector2<T>& other_vect) {
         x -= other_vect.x;
         y -= other_vect.y;
         return *this;
     }
-    inline Vector2<T>& operator*=(const Vector2<T>& other_vect) {
+    inline constexpr Vector2<T>& operator*=(const Vector2<T>& other_vect) {
         x *= other_vect.x;
         y *= other_vect.y;
         return *this;
     }
-    inline Vector2<T>& operator/=(const Vector2<T>& other_vect) {
+    inline constexpr Vector2<T>& operator/=(const Vector2<T>& other_vect) {
         x /= other_vect.x;
         y /= other_vect.y;
         return *this;
@@ -68,37 +76,37 @@ struct Vector2 {
 
     // Scalar operations (returning new Vector2)
 
-    inline Vector2<T> operator+(const T scalar_val) const {
+    inline constexpr Vector2<T> operator+(const T scalar_val) const {
         return Vector2<T>(x + scalar_val, y + scalar_val);
     }
-    inline Vector2<T> operator-(const T scalar_val) const {
+    inline constexpr Vector2<T> operator-(const T scalar_val) const {
         return Vector2<T>(x - scalar_val, y - scalar_val);
     }
-    inline Vector2<T> operator*(const T scalar_val) const {
+    inline constexpr Vector2<T> operator*(const T scalar_val) const {
         return Vector2<T>(x * scalar_val, y * scalar_val);
     }
-    inline Vector2<T> operator/(const T scalar_val) const {
+    inline constexpr Vector2<T> operator/(const T scalar_val) const {
         return Vector2<T>(x / scalar_val, y / scalar_val);
     }
 
     // Scalar operations (modifying original Vector2)
 
-    inline Vector2<T>& operator+=(const T scalar_val) {
+    inline constexpr Vector2<T>& operator+=(const T scalar_val) {
         x += scalar_val;
         y += scalar_val;
         return *this;
     }
-    inline Vector2<T>& operator-=(const T scalar_val) {
+    inline constexpr Vector2<T>& operator-=(const T scalar_val) {
         x -= scalar_val;
         y -= scalar_val;
         return *this;
     }
-    inline Vector2<T>& operator*=(const T scalar_val) {
+    inline constexpr Vector2<T>& operator*=(const T scalar_val) {
         x *= scalar_val;
         y *= scalar_val;
         return *this;
     }
-    inline Vector2<T>& operator/=(const T scalar_val) {
+    inline constexpr Vector2<T>& operator/=(const T scalar_val) {
         x /= scalar_val;
         y /= scalar_val;
         return *this;
@@ -106,19 +114,77 @@ struct Vector2 {
 
     // Comparision operators
 
-    inline bool operator==(const Vector2<T>& other_vect) const { return x == other_vect.x && y == other_vect.y; }
-    inline bool operator!=(const Vector2<T>& other_vect) const { return x != other_vect.x || y != other_vect.y; }
-    inline bool operator<(const Vector2<T>& other_vect) const { return x < other_vect.x && y < other_vect.y; }
-    inline bool operator>(const Vector2<T>& other_vect) const { return x > other_vect.x && y > other_vect.y; }
-    inline bool operator<=(const Vector2<T>& other_vect) const { return x <= other_vect.x && y <= other_vect.y; }
-    inline bool operator>=(const Vector2<T>& other_vect) const { return x >= other_vect.x && y >= other_vect.y; }
-    inline bool operator!() const { return x == ORIGIN && y == ORIGIN; } // Checks if vector is at the origin (0, 0)
+    inline constexpr bool operator==(const Vector2<T>& other_vect) const { return x == other_vect.x && y == other_vect.y; }
+    inline constexpr bool operator!=(const Vector2<T>& other_vect) const { return x != other_vect.x || y != other_vect.y; }
+    inline constexpr bool operator<(const Vector2<T>& other_vect) const { return x < other_vect.x && y < other_vect.y; }
+    inline constexpr bool operator>(const Vector2<T>& other_vect) const { return x > other_vect.x && y > other_vect.y; }
+    inline constexpr bool operator<=(const Vector2<T>& other_vect) const { return x <= other_vect.x && y <= other_vect.y; }
+    inline constexpr bool operator>=(const Vector2<T>& other_vect) const { return x >= other_vect.x && y >= other_vect.y; }
+    inline constexpr bool operator!() const { return x == ORIGIN && y == ORIGIN; } // Checks if vector is at the origin (0, 0)
+
+    // Vector math
+
+    /// @brief Gets the dot product with another vector.
+    /// @param other_vect: The other vector.
+    /// @return The dot product.
+    inline constexpr T dot(const Vector2<T>& other_vect) const { return x * other_vect.x + y * other_vect.y; }
+
+    /// @brief Gets the cross product with another vector: the z component of their 3D cross product.
+    /// @param other_vect: The other vector.
+    /// @return The cross product, positive if the other vector is clockwise from this one on screen (y down).
+    inline constexpr T cross(const Vector2<T>& other_vect) const { return x * other_vect.y - y * other_vect.x; }
+
+    /// @brief Gets the squared length of the vector, which is cheaper than length() for comparisons.
+    /// @return The squared length.
+    inline constexpr T length_squared() const { return x * x + y * y; }
+
+    /// @brief Gets the length of the vector.
+    /// @return The length.
+    inline T length() const { return (T)std::sqrt(length_squared()); }
+
+    /// @brief Gets the vector scaled to a length of one.
+    /// @return The unit vector, or (0, 0) if the vector has no length.
+    inline Vector2<T> normalized() const {
+        T vect_length = length();
+        return vect_length > 0 ? Vector2<T>(x / vect_length, y / vect_length) : Vector2<T>();
+    }
+
+    /// @brief Gets the squared distance to another point.
+    /// @param other_vect: The other point.
+    /// @return The squared distance.
+    inline constexpr T distance_squared_to(const Vector2<T>& other_vect) const { return (other_vect - *this).length_squared(); }
+
+    /// @brief Gets the distance to another point.
+    /// @param other_vect: The other point.
+    /// @return The distance.
+    inline T distance_to(const Vector2<T>& other_vect) const { return (other_vect - *this).length(); }
+
+    /// @brief Interpolates linearly towards another vector.
+    /// @param other_vect: The vector to interpolate towards.
+    /// @param weight: How far to interpolate, 0 for this vector and 1 for the other one.
+    /// @return The interpolated vector.
+    inline constexpr Vector2<T> lerp(const Vector2<T>& other_vect, T weight) const {
+        return Vector2<T>(x + (other_vect.x - x) * weight, y + (other_vect.y - y) * weight);
+    }
+
+    /// @brief Gets the vector rotated by an angle.
+    /// @param angle: The angle in radians, clockwise on screen (y down).
+    /// @return The rotated vector.
+    inline Vector2<T> rotated(double angle) const {
+        double cos_angle = std::cos(angle);
+        double sin_angle = std::sin(angle);
+        return Vector2<T>((T)(x * cos_angle - y * sin_angle), (T)(x * sin_angle + y * cos_angle));
+    }
+
+    /// @brief Gets the vector rotated by a quarter turn, clockwise on screen (y down).
+    /// @return The perpendicular vector.
+    inline constexpr Vector2<T> perpendicular() const { return Vector2<T>(-y, x); }
 
     // Declaring Vector2 types (int, float, double)
 
-    inline operator Vector2<int>() const { return { (int)x, (int)y }; }
-    inline operator Vector2<float>() const { return { (float)x, (float)y }; }
-    inline operator Vector2<double>() const { return { (double)x, (double)y }; }
+    inline constexpr operator Vector2<int>() const { return { (int)x, (int)y }; }
+    inline constexpr operator Vector2<float>() const { return { (float)x, (float)y }; }
+    inline constexpr operator Vector2<double>() const { return { (double)x, (double)y }; }
 };
 
 #endif // VECTOR2_HPP
\ No newline at end of file
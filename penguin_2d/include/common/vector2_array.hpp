@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: vector2_array.hpp                                                ///
+///                                                                             ///
+/// Defines the Vector2Array class, an array of Vector2<float> stored as        ///
+/// separate x and y arrays (structure of arrays) so batch operations can       ///
+/// process several vectors per instruction.                                    ///
+///                                                                             ///
+/// Batch operations run with AVX or SSE2 when the CPU supports them, chosen    ///
+/// once at runtime, and with scalar code otherwise. Every path gives the same  ///
+/// results.                                                                    ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECTOR2_ARRAY_HPP
+#define VECTOR2_ARRAY_HPP
+
+// Penguin2D related include files
+#include "vector2.hpp"
+
+// C++ library files
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief An array of Vector2<float> stored as separate x and y arrays, with batch operations.
+	///
+	/// Use it for large sets of positions or velocities updated every tick, such as particles.
+	/// Pointers returned by get_x_data() and get_y_data() are invalidated when the array grows.
+	class Vector2Array {
+	public:
+		Vector2Array() = default;
+		~Vector2Array() = default;
+
+		/// @brief Constructs a Vector2Array of count copies of a vector.
+		/// @param count: The number of vectors.
+		/// @param value: The value of each vector (optional, defaults to (0, 0)).
+		explicit Vector2Array(size_t count, Vector2<float> value = Vector2<float>());
+
+		/// @brief Gets the number of vectors.
+		/// @return The number of vectors.
+		inline size_t size() const { return xs.size(); }
+
+		/// @brief Checks if the array holds no vectors.
+		/// @return True if the array is empty, otherwise false.
+		inline bool empty() const { return xs.empty(); }
+
+		/// @brief Reserves memory for a number of vectors.
+		/// @param count: The number of vectors.
+		void reserve(size_t count);
+
+		/// @brief Resizes the array, filling new vectors with a value.
+		/// @param count: The new number of vectors.
+		/// @param value: The value of each new vector (optional, defaults to (0, 0)).
+		void resize(size_t count, Vector2<float> value = Vector2<float>());
+
+		/// @brief Removes every vector, keeping the memory.
+		void clear();
+
+		/// @brief Appends a vector.
+		/// @param value: The vector to append.
+		inline void push_back(Vector2<float> value) {
+			xs.push_back(value.x);
+			ys.push_back(value.y);
+		}
+
+		/// @brief Gets a vector.
+		/// @param index: The index of the vector.
+		/// @return The vector.
+		inline Vector2<float> get(size_t index) const { return Vector2<float>(xs[index], ys[index]); }
+
+		/// @brief Sets a vector.
+		/// @param index: The index of the vector.
+		/// @param value: The new value of the vector.
+		inline void set(size_t index, Vector2<float> value) {
+			xs[index] = value.x;
+			ys[index] = value.y;
+		}
+
+		/// @brief Gets the x components of every vector.
+		/// @return A pointer to size() x components.
+		inline float* get_x_data() { return xs.data(); }
+		inline const float* get_x_data() const { return xs.data(); }
+
+		/// @brief Gets the y components of every vector.
+		/// @return A pointer to size() y components.
+		inline float* get_y_data() { return ys.data(); }
+		inline const float* get_y_data() const { return ys.data(); }
+
+		/// @brief Moves every vector by a velocity over a time step: value += velocity * delta_time.
+		/// @param velocities: The velocity of each vector, the same size as this array.
+		/// @param delta_time: The time step in seconds.
+		void integrate(const Vector2Array& velocities, float delta_time);
+
+		/// @brief Sets every vector by interpolating between two arrays, such as the previous and current positions.
+		/// @param from: The vectors at weight 0, the same size as this array.
+		/// @param to: The vectors at weight 1, the same size as this array.
+		/// @param weight: How far to interpolate (e.g., the render interpolation alpha).
+		void lerp(const Vector2Array& from, const Vector2Array& to, float weight);
+
+		/// @brief Gets the squared distance from every vector to a point.
+		/// @param point: The point.
+		/// @param results: Filled with size() squared distances.
+		void distance_squared_to(Vector2<float> point, float* results) const;
+
+		/// @brief Finds every vector within a radius of a point, edges included.
+		/// @param point: The point.
+		/// @param radius: The radius.
+		/// @param indices: Cleared, then filled in increasing order with the index of each vector within the radius.
+		void find_within(Vector2<float> point, float radius, std::vector<uint32_t>& indices) const;
+
+	private:
+		std::vector<float> xs; /// The x component of each vector.
+		std::vector<float> ys; /// The y component of each vector.
+	};
+}
+
+#endif // VECTOR2_ARRAY_HPP
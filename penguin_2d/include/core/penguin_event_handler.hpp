@@ -1,16 +1,17 @@
 ///////////////////////////////////////////////////////////////////////////////////
 /// File name: penguin_event_handler.hpp                                        ///
 ///                                                                             ///
-/// Defines the PenguinEventHandler class, which manages SDL event handling.	///
-///																				///
+/// Defines the PenguinEventHandler class, which manages SDL event handling.    ///
+///                                                                             ///
 /// It allows for polling events, registering event listeners, and checking the ///
-/// application's quit state.													///
-///																				///
-/// The event handler stores callback functions that process SDL events when	///
-/// polled, enabling flexible event handling, such as user input through		///
-/// PenguinInput. It also tracks whether the user has requested to close the	///
-///	window.																		///
-///																				///
+/// application's quit state.                                                   ///
+///                                                                             ///
+/// Listeners are registered for an event type or a range of types (e.g., all   ///
+/// key events), so an event only reaches the listeners interested in it, such  ///
+/// as user input through PenguinInput. High frequency events such as mouse     ///
+/// motion can be coalesced into one event per poll. It also tracks whether the ///
+/// user has requested to close the window.                                     ///
+///                                                                             ///
 /// Reference: https://github.com/aardhyn/sdl3-template-project/tree/main       ///
 ///////////////////////////////////////////////////////////////////////////////////
 
@@ -21,39 +22,150 @@
 #include <SDL3/SDL_events.h>
 
 // C++ standard library files
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 namespace Penguin2D {
+
+	/// @brief Identifies an event listener, to remove it later.
+	using PenguinEventListenerId = uint32_t;
+
+	/// @brief A callable taking a const SDL_Event&, stored inline without allocating.
+	///
+	/// Unlike std::function, it only holds small, trivially copyable callables, such as
+	/// function pointers and lambdas capturing a few pointers (e.g., [this]), so listeners
+	/// can be kept in a flat array and called through a single function pointer.
+	class PenguinEventListener {
+	public:
+		static constexpr size_t CAPACITY = 4 * sizeof(void*); /// The largest callable that fits.
+
+		/// @brief Constructs a listener from a callable.
+		/// @param function: The callable, called with each event the listener receives.
+		template<typename Function,
+			typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, PenguinEventListener>>>
+		PenguinEventListener(Function function) {
+			static_assert(std::is_invocable_v<Function&, const SDL_Event&>, "An event listener must be callable with a const SDL_Event&.");
+			static_assert(std::is_trivially_copyable_v<Function> && std::is_trivially_destructible_v<Function>,
+				"An event listener must be trivially copyable. Capture pointers, or register a std::function instead.");
+			static_assert(sizeof(Function) <= CAPACITY && alignof(Function) <= alignof(std::max_align_t),
+				"An event listener must fit in PenguinEventListener::CAPACITY bytes.");
+
+			new (storage) Function(function);
+			invoke = [](void* p_storage, const SDL_Event& p_event) {
+				(*std::launder(static_cast<Function*>(p_storage)))(p_event);
+			};
+		}
+
+		/// @brief Calls the listener.
+		/// @param p_event: The event.
+		inline void operator()(const SDL_Event& p_event) { invoke(storage, p_event); }
+
+	private:
+		alignas(std::max_align_t) unsigned char storage[CAPACITY]; /// The callable.
+		void (*invoke)(void*, const SDL_Event&); /// Calls the callable in storage.
+	};
+
 	/// @brief Manages window event polling and event listener callbacks.
 	///
 	/// This class is responsible for handling window events,
 	/// invoking registered event listener callbacks, and tracking whether a quit
 	/// event has been requested. It allows external components to register event
-	/// listeners that will be triggered whenever an event is polled.
+	/// listeners for the event types they handle, which are triggered whenever
+	/// such an event is polled.
+	///
+	/// Listeners cannot be added or removed from within a listener.
 	class PenguinEventHandler {
 	public:
 		PenguinEventHandler() = default;
 		~PenguinEventHandler() = default;
 
-		/// @brief Polls events and invokes all registered event listener callbacks.
+		/// @brief Polls events and invokes the listeners registered for each event's type.
 		void poll_events();
 
-		/// @brief Adds an event listener to be triggered during event polling.
-		/// 
+		/// @brief Adds an event listener to be triggered by every event during event polling.
+		///
 		/// @param callback_function: Function to be called when an event occurs.
-		void add_event_listener(const std::function<void(const SDL_Event&)>& callback_function);
+		/// @return The id of the listener.
+		PenguinEventListenerId add_event_listener(const std::function<void(const SDL_Event&)>& callback_function);
+
+		/// @brief Adds an event listener to be triggered by events of one type.
+		/// @param type: The event type (e.g., SDL_EVENT_MOUSE_MOTION).
+		/// @param listener: Called with each event of that type.
+		/// @return The id of the listener.
+		PenguinEventListenerId add_event_listener(Uint32 type, PenguinEventListener listener);
+
+		/// @brief Adds an event listener to be triggered by events in a range of types.
+		/// @param first_type: The first event type (e.g., SDL_EVENT_KEY_DOWN).
+		/// @param last_type: The last event type, included (e.g., SDL_EVENT_KEY_UP).
+		/// @param listener: Called with each event in the range.
+		/// @return The id of the listener.
+		PenguinEventListenerId add_event_listener(Uint32 first_type, Uint32 last_type, PenguinEventListener listener);
+
+		/// @brief Removes an event listener.
+		/// @param id: The id returned when the listener was added.
+		void remove_event_listener(PenguinEventListenerId id);
+
+		/// @brief Sets whether consecutive events of a type are merged into one per poll.
+		///
+		/// Merged mouse motion events keep the latest position and add up the relative motion.
+		/// Other types keep the latest event.
+		///
+		/// @param type: The event type (e.g., SDL_EVENT_MOUSE_MOTION).
+		/// @param coalesce: True to merge the events, false to deliver each one.
+		void set_coalesced(Uint32 type, bool coalesce);
+
+		/// @brief Checks if consecutive events of a type are merged into one per poll.
+		/// @param type: The event type.
+		/// @return True if the events are merged, otherwise false.
+		bool is_coalesced(Uint32 type) const;
 
 		/// @brief Checks if the user has requested to close the application.
-		/// 
+		///
 		/// @return True if a quit event has been detected, otherwise false.
 		bool should_quit() const;
 	private:
-		/// Stores all registered event callbacks.
-		std::vector<std::function<void(const SDL_Event&)>> callback_functions; 
+		static constexpr size_t TYPE_GROUP_BITS = 8; /// Event types are grouped by their high bits (e.g., 0x3xx are key events).
+		static constexpr size_t TYPE_GROUP_COUNT = ((size_t)SDL_EVENT_LAST >> TYPE_GROUP_BITS) + 1;
+
+		/// @brief A registered listener and the range of types it receives.
+		struct ListenerEntry {
+			Uint32 first_type;
+			Uint32 last_type;
+			PenguinEventListener listener;
+			std::unique_ptr<std::function<void(const SDL_Event&)>> callback_function; /// Owns the function of a listener added as std::function.
+			bool active;
+		};
+
+		/// Stores all registered listeners, indexed by id.
+		std::vector<ListenerEntry> listeners;
+
+		/// The listeners of type group g are group_listeners[group_offsets[g]] to group_listeners[group_offsets[g + 1]].
+		std::array<uint32_t, TYPE_GROUP_COUNT + 1> group_offsets{};
+		std::vector<uint32_t> group_listeners;
+
+		/// The event types merged into one per poll.
+		std::vector<Uint32> coalesced_types;
+
+		/// The last event of a coalesced type, not yet dispatched.
+		SDL_Event pending_event{};
+		bool has_pending_event = false;
+
+		/// Tracks whether listeners are being called.
+		bool dispatching = false;
 
 		/// Tracks whether a quit event has been received.
-		bool quit = false; 
+		bool quit = false;
+
+		void dispatch(const SDL_Event& p_event);
+		void flush_pending_event();
+		bool try_merge_pending_event(const SDL_Event& p_event);
+		void rebuild_groups();
 	};
 }
 
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_frame_pacer.hpp                                          ///
+///                                                                             ///
+/// Defines the PenguinFramePacer class, which waits until a deadline more      ///
+/// precisely than a plain sleep.                                               ///
+///                                                                             ///
+/// OS sleeps routinely wake a millisecond or two late, which is a large part   ///
+/// of a 16.7 ms frame. The pacer sleeps for most of the wait and yields in a   ///
+/// loop for the last slice, sized from how late sleeps are measured to wake.   ///
+///                                                                             ///
+/// The class is used internally by PenguinTimer to cap the frame rate.         ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_FRAME_PACER_HPP
+#define PENGUIN_FRAME_PACER_HPP
+
+// C++ library files
+#include <chrono>
+
+namespace Penguin2D {
+
+	/// @brief How a PenguinFramePacer waits.
+	enum class PenguinPacingMode {
+		SLEEP, /// Sleep for the whole wait. Cheapest, but wakes as late as the OS does.
+		HYBRID, /// Sleep, then yield until the deadline for a slice sized once by calibrate().
+		ADAPTIVE /// Like HYBRID, but the slice keeps learning from how late each sleep wakes.
+	};
+
+	/// @brief The state of a PenguinFramePacer's sleep error estimate.
+	struct PenguinPacerStats {
+		double spin_threshold_ms = 0.0; /// How long before a deadline the pacer stops sleeping.
+		double overshoot_mean_ms = 0.0; /// The estimated mean time sleeps wake late by.
+		double overshoot_deviation_ms = 0.0; /// The estimated mean deviation of that lateness.
+		bool calibrated = false; /// Whether calibrate() has run.
+	};
+
+	/// @brief Waits until deadlines by sleeping coarsely and yielding for the last slice.
+	class PenguinFramePacer {
+	public:
+		using penguin_clock = std::chrono::steady_clock;
+
+		/// @brief Constructs a PenguinFramePacer.
+		/// @param mode: How the pacer waits (optional, defaults to ADAPTIVE).
+		explicit PenguinFramePacer(PenguinPacingMode mode = PenguinPacingMode::ADAPTIVE) : mode(mode) {}
+		~PenguinFramePacer() = default;
+
+		/// @brief Blocks the calling thread until a deadline.
+		///
+		/// Never calibrates, so a wait costs no more than the wait itself. Until calibrate() runs,
+		/// the spin slice is a default 2 ms.
+		///
+		/// @param deadline: The time to wake at.
+		void wait_until(penguin_clock::time_point deadline);
+
+		/// @brief Measures how late short sleeps wake, and sizes the spin slice from it.
+		///
+		/// Takes a few milliseconds, so it is called before the game loop starts (see PenguinTimer::calibrate_frame_pacer()).
+		void calibrate();
+
+		/// @brief Sets how the pacer waits.
+		/// @param new_mode: The new pacing mode.
+		void set_mode(PenguinPacingMode new_mode);
+
+		/// @brief Gets how the pacer waits.
+		/// @return The pacing mode.
+		PenguinPacingMode get_mode() const;
+
+		/// @brief Gets the pacer's sleep error estimate.
+		/// @return The pacer's statistics.
+		PenguinPacerStats get_stats() const;
+
+	private:
+		PenguinPacingMode mode; /// How the pacer waits.
+		bool calibrated = false; /// Whether calibrate() has run.
+		double overshoot_mean = 0.0; /// The estimated mean sleep lateness in seconds.
+		double overshoot_deviation = 0.0; /// The estimated mean deviation of the lateness in seconds.
+		double spin_threshold = 0.002; /// How long before a deadline sleeping stops, in seconds.
+
+		void learn_overshoot(double overshoot);
+		void update_spin_threshold();
+	};
+}
+
+#endif // PENGUIN_FRAME_PACER_HPP
@@ -10,6 +10,9 @@
 ///  - update(delta_time) -> Game logic goes here.                              ///
 ///  - draw(alpha) -> Render game objects to the screen.                        ///
 ///  - quit() -> Cleanup and free resources.                                    ///
+///                                                                             ///
+/// Games that run with pipelining enabled also override publish_state(), which ///
+/// hands the simulated state to draw() (see PenguinStateBuffer).               ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #ifndef PENGUIN_GAME_HPP
@@ -37,6 +40,15 @@ namespace Penguin2D {
 		/// @param alpha: The interpolation factor used for rendering.
 		virtual void draw(double alpha) = 0;
 
+		/// @brief Hands the state produced by update() to draw().
+		///
+		/// Called once per frame, after the frame's updates and before draw(), while neither
+		/// of them is running. When the game window is pipelined, update() runs on a worker
+		/// thread at the same time as draw(), so draw() must only read state copied here
+		/// (e.g., with PenguinStateBuffer::publish()). The default does nothing, which is
+		/// only safe when the game is not pipelined.
+		virtual void publish_state() {}
+
 		/// @brief Quits the game and cleans up any resources.
 		virtual void quit() = 0;
 	};
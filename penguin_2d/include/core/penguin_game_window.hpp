@@ -23,6 +23,10 @@
 #include "penguin_input.hpp"
 #include "penguin_event_handler.hpp"
 #include "penguin_timer.hpp"
+#include "penguin_profiler.hpp"
+#include "penguin_update_worker.hpp"
+#include "penguin_job_system.hpp"
+#include "penguin_interpolation_store.hpp"
 #include "penguin_game.hpp"
 #include "vector2.hpp"
 #include "rect2.hpp"
@@ -35,6 +39,7 @@
 // C++ library files
 #include <memory>
 #include <algorithm>
+#include <atomic>
 
 namespace Penguin2D {
 
@@ -70,6 +75,9 @@ namespace Penguin2D {
 		PenguinRenderer renderer; /// The renderer used for rendering graphics.
 		PenguinTextRenderer text_renderer; /// The text renderer for rendering text.
 		PenguinTimer timer; /// The game timer used to manage frame times.
+		PenguinProfiler profiler; /// Records the time spent in each phase of the game loop, and in user-defined zones.
+		PenguinJobSystem job_system; /// Runs jobs across CPU cores. Jobs started by update() are joined before the frame is drawn.
+		PenguinInterpolationStore interpolation; /// Positions set in update(), interpolated by the timer's alpha before each draw().
 		PenguinEventHandler event_handler; /// Handles user input and events.
 		PenguinInput input; /// Manages keyboard input.
 		int width; /// The width of the game window.
@@ -95,15 +103,39 @@ namespace Penguin2D {
 
 		/// @brief Closes the game window.
 		void close_window();
+
+		/// @brief Enables or disables pipelined update and draw.
+		///
+		/// When enabled, the updates for the next frame run on a worker thread while the main
+		/// thread draws the state published for the current one, so draw() shows the simulation
+		/// one frame late. The game must override publish_state(), and update() must not use the
+		/// renderer. Takes effect the next time the game is initialized.
+		///
+		/// @param enable: True to pipeline update and draw, otherwise false.
+		void set_pipelined(bool enable);
+
+		/// @brief Checks if update and draw are pipelined.
+		/// @return True if pipelining is enabled, otherwise false.
+		bool is_pipelined() const;
 		
 	private:
 		/// @brief Handles SDL events and processes them accordingly.
 		/// @param p_event: The SDL event to be processed.
 		void init_events(const SDL_Event& p_event);
 
+		/// @brief Prepares the input and interpolation state for the next fixed update step.
+		void begin_step();
+
+		/// @brief Runs frames with update and draw on the main thread until the game stops.
+		void run_serial_frames();
+
+		/// @brief Runs frames with update on a worker thread until the game stops.
+		void run_pipelined_frames();
+
 		std::unique_ptr<PenguinGame> game_instance; /// Stores the instance of the created game.
-		bool running; /// Tracks whether the game is currently running.
-		bool window_open; /// Tracks whether the window is open.
+		std::atomic<bool> running; /// Tracks whether the game is currently running. Atomic as update() may stop the game from a worker thread.
+		std::atomic<bool> window_open; /// Tracks whether the window is open.
+		bool pipelined; /// Whether update and draw are pipelined.
 	};
 }
 
@@ -8,8 +8,9 @@
 /// add_event_listener() function, which is done in PenguinGameWindow.          ///
 ///                                                                             ///
 /// The file also defines an enum, PenguinKey, representing all supported keys. ///
-/// A key map is used to translate SDL keys to PenguinKeys, allowing key state  ///
-/// tracking through key_pressed_states.                                        ///
+/// A constexpr table translates SDL keycodes to PenguinKeys, and key states    ///
+/// are tracked in bitsets, along with the keys pressed and released since the  ///
+/// previous update step.                                                       ///
 ///                                                                             ///
 /// Future versions will expand support for mouse and joystick input.           ///
 ///////////////////////////////////////////////////////////////////////////////////
@@ -24,7 +25,8 @@
 #include <SDL3/SDL_events.h>
 
 // C++ library files
-#include <unordered_map>
+#include <bitset>
+#include <cstddef>
 
 namespace Penguin2D {
 
@@ -173,9 +175,15 @@ namespace Penguin2D {
     ///
     /// The `PenguinInput` class is responsible for processing keyboard events 
     /// and tracking the state of key presses. It provides methods to check 
-    /// whether specific keys or any keys are currently pressed.
+    /// whether specific keys or any keys are currently pressed, or were pressed
+    /// or released since the previous update step.
+    ///
+    /// Key states are bitsets indexed by PenguinKey, so every query is a bit test
+    /// and nothing is allocated after construction.
     class PenguinInput {
     public:
+        static constexpr size_t KEY_COUNT = (size_t)PenguinKey::RGUI + 1; /// The number of PenguinKey values.
+
         PenguinInput() = default;
         ~PenguinInput() = default;
 
@@ -183,160 +191,45 @@ namespace Penguin2D {
         /// @param p_event: The SDL event to process.
         void handle_input_event(const SDL_Event& p_event);
 
+        /// @brief Makes the key presses and releases handled since the last step visible to the next update step.
+        ///
+        /// Called by PenguinGameWindow before each fixed update, so is_key_just_pressed() and
+        /// is_key_just_released() report each change in exactly one update step.
+        void begin_step();
+
         /// @brief Checks if a specific key is currently pressed.
         /// @param key: The key to check.
         /// @return True if the key is pressed, false otherwise.
-        bool is_key_pressed(PenguinKey key);
+        inline bool is_key_pressed(PenguinKey key) const { return key_states.test((size_t)key); }
 
         /// @brief Checks if any key is currently pressed.
         /// @return True if at least one key is pressed, false otherwise.
-        bool is_any_key_pressed();
+        inline bool is_any_key_pressed() const { return key_states.any(); }
 
-    private:
-        /// Maps SDL keycodes to PenguinKey values.
-        std::unordered_map<SDL_Keycode, PenguinKey> key_map = {
-            { SDLK_UNKNOWN, PenguinKey::UNKNOWN },
-            { SDLK_RETURN, PenguinKey::ENTER },
-            { SDLK_ESCAPE, PenguinKey::ESC },
-            { SDLK_BACKSPACE, PenguinKey::BACKSPACE },
-            { SDLK_TAB, PenguinKey::TAB },
-            { SDLK_SPACE, PenguinKey::SPACE },
-            { SDLK_EXCLAIM, PenguinKey::EXCLAIM },
-            { SDLK_AT, PenguinKey::AT },
-            { SDLK_HASH, PenguinKey::HASH },
-            { SDLK_DOLLAR, PenguinKey::DOLLAR },
-            { SDLK_PERCENT, PenguinKey::PERCENT },
-            { SDLK_CARET, PenguinKey::CARET },
-            { SDLK_AMPERSAND, PenguinKey::AMPERSAND },
-            { SDLK_ASTERISK, PenguinKey::ASTERISK },
-            { SDLK_LEFTPAREN, PenguinKey::LBRACKET },
-            { SDLK_RIGHTPAREN, PenguinKey::RBRACKET },
-            { SDLK_MINUS, PenguinKey::MINUS },
-            { SDLK_PLUS, PenguinKey::PLUS },
-            { SDLK_0, PenguinKey::KEY_0 },
-            { SDLK_1, PenguinKey::KEY_1 },
-            { SDLK_2, PenguinKey::KEY_2 },
-            { SDLK_3, PenguinKey::KEY_3 },
-            { SDLK_4, PenguinKey::KEY_4 },
-            { SDLK_5, PenguinKey::KEY_5 },
-            { SDLK_6, PenguinKey::KEY_6 },
-            { SDLK_7, PenguinKey::KEY_7 },
-            { SDLK_8, PenguinKey::KEY_8 },
-            { SDLK_9, PenguinKey::KEY_9 },
-            { SDLK_UNDERSCORE, PenguinKey::UNDERSCORE },
-            { SDLK_EQUALS, PenguinKey::EQUAL_SIGN },
-            { SDLK_GREATER, PenguinKey::GREATER },
-            { SDLK_LESS, PenguinKey::LESS },
-            { SDLK_LEFTBRACE, PenguinKey::LBRACE },
-            { SDLK_RIGHTBRACE, PenguinKey::RBRACE },
-            { SDLK_LEFTBRACKET, PenguinKey::LSQUARE_BRACKET },
-            { SDLK_RIGHTBRACKET, PenguinKey::RSQUARE_BRACKET },
-            { SDLK_QUESTION, PenguinKey::QUESTION },
-            { SDLK_SLASH, PenguinKey::SLASH },
-            { SDLK_BACKSLASH, PenguinKey::BACKSLASH },
-            { SDLK_PIPE, PenguinKey::PIPE },
-            { SDLK_COMMA, PenguinKey::COMMA },
-            { SDLK_PERIOD, PenguinKey::PERIOD },
-            { SDLK_COLON, PenguinKey::COLON },
-            { SDLK_SEMICOLON, PenguinKey::SEMICOLON },
-            { SDLK_APOSTROPHE, PenguinKey::DQUOTE },
-            { SDLK_DBLAPOSTROPHE, PenguinKey::SQUOTE},
-            { SDLK_GRAVE, PenguinKey::GRAVE },
-            { SDLK_TILDE, PenguinKey::TIDLE },
-            { SDLK_A, PenguinKey::KEY_A },
-            { SDLK_B, PenguinKey::KEY_B },
-            { SDLK_C, PenguinKey::KEY_C },
-            { SDLK_D, PenguinKey::KEY_D },
-            { SDLK_E, PenguinKey::KEY_E },
-            { SDLK_F, PenguinKey::KEY_F },
-            { SDLK_G, PenguinKey::KEY_G },
-            { SDLK_H, PenguinKey::KEY_H },
-            { SDLK_I, PenguinKey::KEY_I },
-            { SDLK_J, PenguinKey::KEY_J },
-            { SDLK_K, PenguinKey::KEY_K },
-            { SDLK_L, PenguinKey::KEY_L },
-            { SDLK_M, PenguinKey::KEY_M },
-            { SDLK_N, PenguinKey::KEY_N },
-            { SDLK_O, PenguinKey::KEY_O },
-            { SDLK_P, PenguinKey::KEY_P },
-            { SDLK_Q, PenguinKey::KEY_Q },
-            { SDLK_R, PenguinKey::KEY_R },
-            { SDLK_S, PenguinKey::KEY_S },
-            { SDLK_T, PenguinKey::KEY_T },
-            { SDLK_U, PenguinKey::KEY_U },
-            { SDLK_V, PenguinKey::KEY_V },
-            { SDLK_W, PenguinKey::KEY_W },
-            { SDLK_X, PenguinKey::KEY_X },
-            { SDLK_Y, PenguinKey::KEY_Y },
-            { SDLK_Z, PenguinKey::KEY_Z },
-            { SDLK_DELETE, PenguinKey::DELETE },
-            { SDLK_PLUSMINUS, PenguinKey::PLUSMINUS },
-            { SDLK_CAPSLOCK, PenguinKey::CAPSLOCK },
-            { SDLK_F1, PenguinKey::KEY_F1 },
-            { SDLK_F2, PenguinKey::KEY_F2 },
-            { SDLK_F3, PenguinKey::KEY_F3 },
-            { SDLK_F4, PenguinKey::KEY_F4 },
-            { SDLK_F5, PenguinKey::KEY_F5 },
-            { SDLK_F6, PenguinKey::KEY_F6 },
-            { SDLK_F7, PenguinKey::KEY_F7 },
-            { SDLK_F8, PenguinKey::KEY_F8 },
-            { SDLK_F9, PenguinKey::KEY_F9 },
-            { SDLK_F10, PenguinKey::KEY_F10 },
-            { SDLK_F11, PenguinKey::KEY_F11 },
-            { SDLK_F12, PenguinKey::KEY_F12 },
-            { SDLK_PRINTSCREEN, PenguinKey::PRINT_SCREEN },
-            { SDLK_SCROLLLOCK, PenguinKey::SCROLL_LOCK },
-            { SDLK_PAUSE, PenguinKey::PAUSE },
-            { SDLK_INSERT, PenguinKey::INSERT },
-            { SDLK_HOME, PenguinKey::HOME },
-            { SDLK_PAGEUP, PenguinKey::PAGE_UP },
-            { SDLK_PAGEDOWN, PenguinKey::PAGE_DOWN },
-            { SDLK_END, PenguinKey::END },
-            { SDLK_RIGHT, PenguinKey::RIGHT },
-            { SDLK_LEFT, PenguinKey::LEFT },
-            { SDLK_DOWN, PenguinKey::DOWN },
-            { SDLK_UP, PenguinKey::UP },
-            { SDLK_KP_DIVIDE, PenguinKey::KEYPAD_DIVIDE },
-            { SDLK_KP_MULTIPLY, PenguinKey::KEYPAD_MULTIPLY },
-            { SDLK_KP_MINUS, PenguinKey::KEYPAD_MINUS },
-            { SDLK_KP_PLUS, PenguinKey::KEYPAD_PLUS },
-            { SDLK_KP_ENTER, PenguinKey::KEYPAD_ENTER },
-            { SDLK_KP_0, PenguinKey::KEYPAD_0 },
-            { SDLK_KP_1, PenguinKey::KEYPAD_1 },
-            { SDLK_KP_2, PenguinKey::KEYPAD_2 },
-            { SDLK_KP_3, PenguinKey::KEYPAD_3 },
-            { SDLK_KP_4, PenguinKey::KEYPAD_4 },
-            { SDLK_KP_5, PenguinKey::KEYPAD_5 },
-            { SDLK_KP_6, PenguinKey::KEYPAD_6 },
-            { SDLK_KP_7, PenguinKey::KEYPAD_7 },
-            { SDLK_KP_8, PenguinKey::KEYPAD_8 },
-            { SDLK_KP_9, PenguinKey::KEYPAD_9 },
-            { SDLK_KP_PERIOD, PenguinKey::KEYPAD_PERIOD },
-            { SDLK_KP_EQUALS, PenguinKey::KEYPAD_EQUAL_SIGN },
-            { SDLK_APPLICATION, PenguinKey::APPLICATION },
-            { SDLK_UNDO, PenguinKey::UNDO },
-            { SDLK_CUT, PenguinKey::CUT },
-            { SDLK_COPY, PenguinKey::COPY },
-            { SDLK_PASTE, PenguinKey::PASTE },
-            { SDLK_FIND, PenguinKey::FIND },
-            { SDLK_MUTE, PenguinKey::MUTE },
-            { SDLK_VOLUMEUP, PenguinKey::VOLUME_UP },
-            { SDLK_VOLUMEDOWN, PenguinKey::VOLUME_DOWN },
-            { SDLK_ALTERASE, PenguinKey::ALT_ERASE },
-            { SDLK_CANCEL, PenguinKey::CANCEL },
-            { SDLK_CLEAR, PenguinKey::CLEAR },
-            { SDLK_LCTRL, PenguinKey::LCTRL },
-            { SDLK_LSHIFT, PenguinKey::LSHIFT },
-            { SDLK_LALT, PenguinKey::LALT },
-            { SDLK_LGUI, PenguinKey::LGUI },
-            { SDLK_RCTRL, PenguinKey::RCTRL },
-            { SDLK_RSHIFT, PenguinKey::RSHIFT },
-            { SDLK_RALT, PenguinKey::RALT },
-            { SDLK_RGUI, PenguinKey::RGUI },
-        };
+        /// @brief Checks if a key was pressed since the previous update step.
+        /// @param key: The key to check.
+        /// @return True if the key went down, even if it has already been released, false otherwise.
+        inline bool is_key_just_pressed(PenguinKey key) const { return step_pressed_keys.test((size_t)key); }
 
-        /// Stores the pressed state of each key.
-        std::unordered_map<PenguinKey, bool> key_pressed_states;
+        /// @brief Checks if a key was released since the previous update step.
+        /// @param key: The key to check.
+        /// @return True if the key went up, false otherwise.
+        inline bool is_key_just_released(PenguinKey key) const { return step_released_keys.test((size_t)key); }
+
+        /// @brief Checks if any key was pressed since the previous update step.
+        /// @return True if at least one key went down, false otherwise.
+        inline bool is_any_key_just_pressed() const { return step_pressed_keys.any(); }
+
+        /// @brief Gets the number of keys currently pressed.
+        /// @return The number of pressed keys.
+        inline size_t get_pressed_key_count() const { return key_states.count(); }
+
+    private:
+        std::bitset<KEY_COUNT> key_states; /// The pressed state of each key.
+        std::bitset<KEY_COUNT> pressed_keys; /// The keys pressed since the last begin_step().
+        std::bitset<KEY_COUNT> released_keys; /// The keys released since the last begin_step().
+        std::bitset<KEY_COUNT> step_pressed_keys; /// The keys pressed before the current update step.
+        std::bitset<KEY_COUNT> step_released_keys; /// The keys released before the current update step.
     };
 }
 
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_interpolation_store.hpp                                  ///
+///                                                                             ///
+/// Defines the PenguinInterpolationStore class, which smooths the motion of    ///
+/// objects updated at a fixed timestep when the display runs at another rate.  ///
+///                                                                             ///
+/// The game sets the position of each object during update(). Before each      ///
+/// fixed update, the game window keeps the positions as the previous ones, and ///
+/// before each draw it interpolates between the previous and current positions ///
+/// by the timer's alpha, in one batch pass. draw() then reads the render       ///
+/// positions, so a simulation running at 30 Hz moves smoothly at 144 Hz, at    ///
+/// the cost of drawing up to one update behind.                                ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_INTERPOLATION_STORE_HPP
+#define PENGUIN_INTERPOLATION_STORE_HPP
+
+// Penguin2D related include files
+#include "vector2.hpp"
+#include "vector2_array.hpp"
+
+// C++ library files
+#include <cstdint>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief Identifies an object in a PenguinInterpolationStore. Chosen by the caller (e.g., an entity index).
+	using PenguinInterpolationId = uint32_t;
+
+	/// @brief Interpolates the positions of objects between fixed updates for drawing.
+	///
+	/// Objects are added, removed and moved from update(), and their render positions are read
+	/// from draw(). The render positions are a separate copy made by interpolate(), which the
+	/// game window calls while no update is running, so draw() may read them while a pipelined
+	/// update changes the objects.
+	class PenguinInterpolationStore {
+	public:
+		PenguinInterpolationStore() = default;
+		~PenguinInterpolationStore() = default;
+
+		/// @brief Adds an object. It is drawn at this position until it moves.
+		/// @param id: The id of the object. It must not already be in the store.
+		/// @param position: The position of the object.
+		void add(PenguinInterpolationId id, Vector2<float> position);
+
+		/// @brief Removes an object.
+		/// @param id: The id of the object.
+		void remove(PenguinInterpolationId id);
+
+		/// @brief Checks if an object is in the store.
+		/// @param id: The id of the object.
+		/// @return True if the object is in the store, otherwise false.
+		bool contains(PenguinInterpolationId id) const;
+
+		/// @brief Removes every object.
+		void clear();
+
+		/// @brief Sets the current position of an object. It is drawn moving there from its previous position.
+		/// @param id: The id of the object.
+		/// @param position: The new position of the object.
+		void set_position(PenguinInterpolationId id, Vector2<float> position);
+
+		/// @brief Moves an object without drawing it in between (e.g., when it respawns or wraps around).
+		/// @param id: The id of the object.
+		/// @param position: The new position of the object.
+		void teleport(PenguinInterpolationId id, Vector2<float> position);
+
+		/// @brief Gets the current position of an object, as last set.
+		/// @param id: The id of the object.
+		/// @return The current position.
+		Vector2<float> get_position(PenguinInterpolationId id) const;
+
+		/// @brief Gets the number of objects.
+		/// @return The number of objects.
+		inline size_t get_count() const { return ids.size(); }
+
+		/// @brief Keeps the current positions as the previous ones. Called by the game window before each fixed update.
+		void begin_step();
+
+		/// @brief Computes the render positions. Called by the game window before each draw.
+		/// @param alpha: How far the frame is between the previous and current positions, clamped to 0 to 1.
+		void interpolate(double alpha);
+
+		/// @brief Gets the render position of an object, as of the last interpolate().
+		/// @param id: The id of the object.
+		/// @return The interpolated position.
+		Vector2<float> get_render_position(PenguinInterpolationId id) const;
+
+		/// @brief Gets the render position of every object, as of the last interpolate(), to draw them in bulk.
+		/// @return The render positions, in the same order as get_render_ids().
+		inline const Vector2Array& get_render_positions() const { return render_positions; }
+
+		/// @brief Gets the id of every object, as of the last interpolate().
+		/// @return The ids, in the same order as get_render_positions().
+		inline const std::vector<PenguinInterpolationId>& get_render_ids() const { return render_ids; }
+
+	private:
+		static constexpr uint32_t NO_SLOT = UINT32_MAX; /// Marks an id that is not in the store.
+
+		std::vector<PenguinInterpolationId> ids; /// The id of each object, densely packed.
+		std::vector<uint32_t> slots; /// The index in ids of each id, or NO_SLOT.
+		Vector2Array previous_positions; /// The position of each object before the last fixed update.
+		Vector2Array current_positions; /// The position of each object after the last fixed update.
+
+		std::vector<PenguinInterpolationId> render_ids; /// The ids as of the last interpolate().
+		std::vector<uint32_t> render_slots; /// The slots as of the last interpolate().
+		Vector2Array render_positions; /// The interpolated position of each object.
+
+		uint32_t get_slot(PenguinInterpolationId id) const;
+	};
+}
+
+#endif // PENGUIN_INTERPOLATION_STORE_HPP
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_job_system.hpp                                           ///
+///                                                                             ///
+/// Defines the PenguinJobSystem class, a work-stealing thread pool that games  ///
+/// use to spread work such as physics or AI across CPU cores.                  ///
+///                                                                             ///
+/// Jobs are plain callables. Each can be tracked by a PenguinJobCounter, which ///
+/// can be waited on or used as a dependency of later jobs, and parallel_for    ///
+/// splits an index range into jobs. A thread that waits runs queued jobs       ///
+/// itself instead of blocking, so jobs may wait on other jobs.                 ///
+///                                                                             ///
+/// PenguinGameWindow owns a job system sized from the hardware concurrency,    ///
+/// and joins every job after the frame's updates, before anything is drawn.    ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_JOB_SYSTEM_HPP
+#define PENGUIN_JOB_SYSTEM_HPP
+
+// C++ library files
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief A unit of work run by a PenguinJobSystem.
+	using PenguinJob = std::function<void()>;
+
+	/// @brief How much work a thread has done for a PenguinJobSystem since its statistics were reset.
+	struct PenguinWorkerStats {
+		size_t jobs_run = 0; /// The number of jobs the thread ran.
+		size_t jobs_stolen = 0; /// The number of those jobs taken from another thread's queue.
+		double busy_ms = 0.0; /// The time spent running jobs in milliseconds.
+		double utilisation = 0.0; /// The fraction of the elapsed time spent running jobs (0 to 1).
+	};
+
+	/// @brief Counts the unfinished jobs of a group, so the group can be waited on or depended on.
+	///
+	/// A counter may be reused once its jobs have finished. It must not be destroyed while it
+	/// still has unfinished jobs, or while jobs that depend on it have yet to be released, so
+	/// always wait on a counter before it goes out of scope.
+	class PenguinJobCounter {
+	public:
+		PenguinJobCounter() = default;
+		~PenguinJobCounter() = default;
+
+		PenguinJobCounter(const PenguinJobCounter&) = delete;
+		PenguinJobCounter& operator=(const PenguinJobCounter&) = delete;
+
+		/// @brief Checks if every job tracked by the counter has finished.
+		/// @return True if no tracked job is pending, otherwise false.
+		inline bool is_done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class PenguinJobSystem;
+
+		/// @brief A job waiting for the counter to reach zero.
+		struct Continuation {
+			PenguinJob job; /// The job to run.
+			PenguinJobCounter* counter; /// The counter tracking the job, or nullptr.
+		};
+
+		std::atomic<int> pending{ 0 }; /// The number of unfinished jobs. Only decremented while mutex is held.
+		std::mutex mutex; /// Guards continuations and error.
+		std::vector<Continuation> continuations; /// Jobs released when pending reaches zero.
+		std::exception_ptr error; /// The first exception thrown by a tracked job.
+	};
+
+	/// @brief A work-stealing thread pool.
+	///
+	/// Every worker has its own queue. A worker runs the newest job of its own queue first
+	/// and, when that is empty, steals the oldest job of another queue. Jobs submitted from
+	/// threads outside the pool go to a shared queue that every worker takes from.
+	class PenguinJobSystem {
+	public:
+		/// @brief Constructs a PenguinJobSystem and starts its workers.
+		/// @param worker_count: The number of worker threads (optional, defaults to one less than the hardware concurrency, and at least one).
+		explicit PenguinJobSystem(size_t worker_count = 0);
+
+		/// @brief Runs every queued job and joins the workers.
+		~PenguinJobSystem();
+
+		PenguinJobSystem(const PenguinJobSystem&) = delete;
+		PenguinJobSystem& operator=(const PenguinJobSystem&) = delete;
+
+		/// @brief Queues a job that is only tracked by wait_all().
+		/// @param job: The job to run.
+		void run(PenguinJob job);
+
+		/// @brief Queues a job tracked by a counter.
+		/// @param job: The job to run.
+		/// @param counter: The counter tracking the job. It must outlive the job.
+		void run(PenguinJob job, PenguinJobCounter& counter);
+
+		/// @brief Queues a job once every job tracked by another counter has finished.
+		/// @param dependency: The counter to wait for.
+		/// @param job: The job to run.
+		/// @param counter: The counter tracking the job. It must outlive the job.
+		void run_after(PenguinJobCounter& dependency, PenguinJob job, PenguinJobCounter& counter);
+
+		/// @brief Runs queued jobs until every job tracked by a counter has finished.
+		/// @param counter: The counter to wait for.
+		/// @throws The first exception thrown by a job tracked by the counter, if any.
+		void wait(PenguinJobCounter& counter);
+
+		/// @brief Runs queued jobs until every job submitted to the system has finished.
+		/// @throws The first exception thrown by an untracked job, if any.
+		void wait_all();
+
+		/// @brief Runs a body over an index range split into chunks, and waits for every chunk.
+		///
+		/// The body is called as body(chunk_begin, chunk_end) for consecutive, non-overlapping
+		/// chunks that cover [begin, end). The calling thread runs the last chunk itself.
+		///
+		/// @param begin: The first index of the range.
+		/// @param end: One past the last index of the range.
+		/// @param grain_size: The number of indices per chunk (0 picks a size that gives each thread a few chunks).
+		/// @param body: The callable run for each chunk.
+		/// @throws The first exception thrown by the body, if any.
+		template <typename Body>
+		void parallel_for(size_t begin, size_t end, size_t grain_size, Body&& body);
+
+		/// @brief Gets the number of worker threads.
+		/// @return The number of worker threads.
+		size_t get_worker_count() const;
+
+		/// @brief Gets how much work each thread has done since the statistics were reset.
+		/// @return One entry per worker, followed by one entry for threads outside the pool that ran jobs while waiting.
+		std::vector<PenguinWorkerStats> get_worker_stats() const;
+
+		/// @brief Resets the statistics of every thread.
+		void reset_stats();
+
+	private:
+		/// @brief A queued job.
+		struct Task {
+			PenguinJob job; /// The job to run.
+			PenguinJobCounter* counter = nullptr; /// The counter tracking the job, or nullptr.
+		};
+
+		/// @brief A queue of tasks and the statistics of the thread that owns it.
+		struct alignas(64) WorkerQueue {
+			std::mutex mutex; /// Guards tasks.
+			std::deque<Task> tasks; /// The owner takes from the back, thieves from the front.
+			std::atomic<uint64_t> jobs_run{ 0 };
+			std::atomic<uint64_t> jobs_stolen{ 0 };
+			std::atomic<uint64_t> busy_ns{ 0 };
+		};
+
+		std::unique_ptr<WorkerQueue[]> queues; /// One queue per worker, then the shared queue for outside threads.
+		size_t worker_count; /// The number of worker threads.
+		std::atomic<int64_t> queued_tasks{ 0 }; /// The number of tasks in the queues.
+		std::atomic<int64_t> unfinished_tasks{ 0 }; /// The number of submitted tasks, including deferred ones, that have not finished.
+		std::mutex sleep_mutex; /// Guards sleeping workers and stopping.
+		std::condition_variable work_available; /// Signalled when a task is queued or the system stops.
+		bool stopping = false; /// Whether the workers should exit once the queues are empty.
+		std::mutex error_mutex; /// Guards error.
+		std::exception_ptr error; /// The first exception thrown by an untracked job.
+		std::chrono::steady_clock::time_point stats_start; /// When the statistics were last reset.
+		std::vector<std::thread> workers; /// The worker threads.
+
+		void submit(Task task);
+		bool find_task(size_t queue_index, Task& task, bool& stolen);
+		void execute(size_t queue_index, Task& task, bool stolen);
+		void finish(PenguinJobCounter* counter, std::exception_ptr job_error);
+		bool run_one_job();
+		void worker_loop(size_t index);
+		size_t get_current_queue() const;
+	};
+
+	/// @brief Runs a body over an index range split into chunks, and waits for every chunk.
+	/// @param begin: The first index of the range.
+	/// @param end: One past the last index of the range.
+	/// @param grain_size: The number of indices per chunk (0 picks a size automatically).
+	/// @param body: The callable run for each chunk.
+	template <typename Body>
+	void PenguinJobSystem::parallel_for(size_t begin, size_t end, size_t grain_size, Body&& body) {
+		if (begin >= end) {
+			return;
+		}
+
+		size_t count = end - begin;
+		if (grain_size == 0) {
+			grain_size = std::max<size_t>(1, count / ((worker_count + 1) * 4));
+		}
+
+		PenguinJobCounter counter;
+		size_t chunk_begin = begin;
+		while (end - chunk_begin > grain_size) {
+			size_t chunk_end = chunk_begin + grain_size;
+			run([&body, chunk_begin, chunk_end] { body(chunk_begin, chunk_end); }, counter);
+			chunk_begin = chunk_end;
+		}
+
+		// The queued chunks refer to body and counter, so they must finish before an exception leaves this frame.
+		try {
+			body(chunk_begin, end);
+		}
+		catch (...) {
+			try {
+				wait(counter);
+			}
+			catch (...) {
+			}
+			throw;
+		}
+		wait(counter);
+	}
+}
+
+#endif // PENGUIN_JOB_SYSTEM_HPP
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_profiler.hpp                                             ///
+///                                                                             ///
+/// Defines the PenguinProfiler class, which records scoped CPU timing zones    ///
+/// into a lock-free ring buffer.                                               ///
+///                                                                             ///
+/// Zones are opened with the PENGUIN_PROFILE_SCOPE macro and closed at the end ///
+/// of the enclosing scope. The profiler reports p50/p99/max durations per zone ///
+/// over the recorded window and can dump the window as a Chrome trace file     ///
+/// (open it in chrome://tracing or https://ui.perfetto.dev).                   ///
+///                                                                             ///
+/// Define PENGUIN_DISABLE_PROFILER to compile every zone out.                  ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_PROFILER_HPP
+#define PENGUIN_PROFILER_HPP
+
+// Penguin2D related include files
+#include "exception.hpp"
+
+// C++ library files
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief The durations of a zone over the profiler's recorded window.
+	struct PenguinZoneStats {
+		std::string name; /// The name of the zone.
+		size_t count = 0; /// The number of times the zone was recorded.
+		double mean_ms = 0.0; /// The mean duration in milliseconds.
+		double p50_ms = 0.0; /// The median duration in milliseconds.
+		double p99_ms = 0.0; /// The 99th percentile duration in milliseconds.
+		double max_ms = 0.0; /// The longest duration in milliseconds.
+	};
+
+	/// @brief A completed zone read back from the profiler.
+	struct PenguinZoneRecord {
+		const char* name; /// The name of the zone.
+		uint64_t start_ns; /// When the zone opened, in nanoseconds since the profiler was created.
+		uint64_t duration_ns; /// How long the zone was open, in nanoseconds.
+		uint32_t thread; /// A small id of the thread the zone ran on.
+	};
+
+	/// @brief Records timing zones from any thread into a fixed-size ring buffer.
+	///
+	/// Recording a zone never blocks or allocates: each zone claims a slot with a single
+	/// atomic increment, and the oldest zones are overwritten once the buffer is full.
+	/// Queries read the buffer while it may still be written to, and skip slots that
+	/// are mid-write.
+	class PenguinProfiler {
+	public:
+		/// @brief Constructs a PenguinProfiler.
+		/// @param capacity: The number of zones kept, rounded up to a power of two (optional, defaults to 65536).
+		explicit PenguinProfiler(size_t capacity = 65536);
+		~PenguinProfiler() = default;
+
+		/// @brief Enables or disables recording. Zones opened while disabled are not recorded.
+		/// @param enable: True to record zones, otherwise false.
+		void set_enabled(bool enable);
+
+		/// @brief Checks if the profiler is recording zones.
+		/// @return True if recording, otherwise false.
+		inline bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+		/// @brief Gets the current time on the profiler's clock.
+		/// @return The nanoseconds since the profiler was created.
+		inline uint64_t now() const {
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+		}
+
+		/// @brief Records a completed zone.
+		/// @param name: The name of the zone. It must outlive the profiler (e.g., a string literal).
+		/// @param start_ns: When the zone opened, from now().
+		/// @param end_ns: When the zone closed, from now().
+		void record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+		/// @brief Reads every completed zone in the recorded window, oldest first.
+		/// @return The recorded zones.
+		std::vector<PenguinZoneRecord> get_records() const;
+
+		/// @brief Gets the durations of a zone over the recorded window.
+		/// @param name: The name of the zone.
+		/// @return The zone's statistics (a count of 0 if the zone was not recorded).
+		PenguinZoneStats get_zone_stats(const std::string& name) const;
+
+		/// @brief Gets the durations of every zone over the recorded window.
+		/// @return The statistics of each zone, sorted by name.
+		std::vector<PenguinZoneStats> get_all_zone_stats() const;
+
+		/// @brief Writes the recorded window as a Chrome trace event file.
+		/// @param path: The file path to write to.
+		void write_chrome_trace(const std::string& path) const;
+
+		/// @brief Discards every recorded zone.
+		void clear();
+
+	private:
+		/// @brief A slot of the ring buffer. Fields are atomic so that reads during writes are well defined.
+		struct Slot {
+			std::atomic<uint64_t> sequence{ 0 }; /// The write index + 1 once written, or 0 while being written.
+			std::atomic<const char*> name{ nullptr };
+			std::atomic<uint64_t> start_ns{ 0 };
+			std::atomic<uint64_t> duration_ns{ 0 };
+			std::atomic<uint32_t> thread{ 0 };
+		};
+
+		std::chrono::steady_clock::time_point epoch; /// The time the profiler was created.
+		std::unique_ptr<Slot[]> slots; /// The ring buffer of zones.
+		size_t mask; /// The capacity of the ring buffer minus one.
+		std::atomic<uint64_t> write_index{ 0 }; /// The number of zones ever recorded.
+		std::atomic<uint64_t> cleared_index{ 0 }; /// The write index when the profiler was last cleared.
+		std::atomic<bool> enabled{ true }; /// Whether zones are recorded.
+
+		static uint32_t get_thread_id();
+		static PenguinZoneStats compute_stats(const std::string& name, std::vector<uint64_t>& durations);
+	};
+
+	/// @brief Times the scope it lives in and records it in a PenguinProfiler. Use PENGUIN_PROFILE_SCOPE.
+	class PenguinProfileZone {
+	public:
+		inline PenguinProfileZone(PenguinProfiler& profiler, const char* name)
+			: profiler(profiler), name(name), start_ns(profiler.is_enabled() ? profiler.now() : 0), active(profiler.is_enabled()) {
+		}
+
+		inline ~PenguinProfileZone() {
+			if (active) {
+				profiler.record(name, start_ns, profiler.now());
+			}
+		}
+
+		PenguinProfileZone(const PenguinProfileZone&) = delete;
+		PenguinProfileZone& operator=(const PenguinProfileZone&) = delete;
+
+	private:
+		PenguinProfiler& profiler; /// The profiler the zone is recorded in.
+		const char* name; /// The name of the zone.
+		uint64_t start_ns; /// When the zone opened.
+		bool active; /// Whether the profiler was enabled when the zone opened.
+	};
+}
+
+#define PENGUIN_PROFILE_CONCAT_INNER(a, b) a##b
+#define PENGUIN_PROFILE_CONCAT(a, b) PENGUIN_PROFILE_CONCAT_INNER(a, b)
+
+#ifndef PENGUIN_DISABLE_PROFILER
+/// @brief Records the rest of the enclosing scope as a zone called name in the given PenguinProfiler.
+#define PENGUIN_PROFILE_SCOPE(profiler, name) ::Penguin2D::PenguinProfileZone PENGUIN_PROFILE_CONCAT(penguin_profile_zone_, __LINE__)((profiler), (name))
+#else
+#define PENGUIN_PROFILE_SCOPE(profiler, name) ((void)0)
+#endif
+
+#endif // PENGUIN_PROFILER_HPP
@@ -8,6 +8,9 @@
 ///                                                                             ///
 /// It provides functions for clearing and presenting frames, drawing shapes	///
 /// (lines, rectangles, circles, ellipses), and modifying drawing colors.		///
+///                                                                             ///
+/// Primitives can either be submitted immediately or recorded into a command   ///
+/// buffer and flushed as a handful of batched SDL calls when presenting.       ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #ifndef PENGUIN_RENDERER_HPP
@@ -18,16 +21,99 @@
 #include "colour.hpp"
 #include "rect2.hpp"
 #include "exception.hpp"
+#include "scratch_buffer.hpp"
+#include "penguin_texture_cache.hpp"
 
 // SDL related include files
 #include <SDL3/SDL_render.h>
 
 // C++ library files
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
 #include <memory>
+#include <numbers>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Penguin2D {
+
+    /// @brief Represents how the renderer submits primitives to SDL.
+    enum class PenguinRenderMode {
+        IMMEDIATE,  /// Every primitive is submitted to SDL as soon as it is drawn (default).
+        BATCHED,    /// Primitives are recorded and neighbouring primitives of the same type and colour are merged.
+        SORTED      /// Primitives are recorded, sorted by type and colour, then merged. Overlap order between colours is not kept.
+    };
+
+    /// @brief Represents the type of primitive stored in a PenguinDrawCommand.
+    enum class PenguinPrimitive {
+        POINTS,         /// A range of points in the point buffer.
+        RECT,           /// A rectangle outline.
+        FILLED_RECT,    /// A filled rectangle.
+        GEOMETRY        /// A range of indices in the index buffer, coloured per vertex (lines, filled shapes).
+    };
+
+    /// @brief A primitive recorded by the renderer while in a deferred render mode.
+    struct PenguinDrawCommand {
+        PenguinPrimitive primitive; /// The type of primitive to draw.
+        Colour colour; /// The draw colour (unused for GEOMETRY, which stores colours in its vertices).
+        SDL_FRect rect; /// The rectangle for RECT and FILLED_RECT primitives.
+        size_t first; /// The first point (POINTS) or index (GEOMETRY) of the primitive.
+        size_t count; /// The number of points (POINTS) or indices (GEOMETRY) of the primitive.
+    };
+
+    /// @brief Statistics gathered by the renderer, used to tune and benchmark rendering.
+    struct PenguinRenderStats {
+        size_t scratch_allocations = 0; /// The number of times the renderer's scratch arenas have grown since it was created.
+        size_t scratch_bytes = 0; /// The number of bytes reserved by the renderer's scratch arenas.
+        size_t shape_cache_hits = 0; /// The number of circle and ellipse draws that reused a cached mesh.
+        size_t shape_cache_misses = 0; /// The number of circle and ellipse draws that had to build their mesh.
+        size_t shape_cache_size = 0; /// The number of meshes currently held in the shape cache.
+        size_t state_changes_issued = 0; /// The number of draw colour and blend mode changes sent to SDL this frame.
+        size_t state_changes_skipped = 0; /// The number of draw colour and blend mode changes skipped this frame because they were already bound.
+    };
+
+    /// @brief A cached unit circle used to build filled circles and ellipses as triangle fans.
+    struct PenguinUnitCircle {
+        std::vector<SDL_FPoint> points; /// Points on the unit circle, in order around the rim.
+        std::vector<int> fan_indices; /// Triangle indices of a fan whose vertex 0 is the centre and whose rim starts at vertex 1.
+    };
+
+    /// @brief Represents the kind of shape stored in the shape cache.
+    enum class PenguinShapeKind {
+        CIRCLE,
+        ELLIPSE
+    };
+
+    /// @brief Identifies a cached circle or ellipse mesh.
+    struct PenguinShapeKey {
+        PenguinShapeKind kind; /// The kind of shape.
+        int radius_x; /// The horizontal radius of the shape.
+        int radius_y; /// The vertical radius of the shape.
+        bool filled; /// Whether the shape is filled or an outline.
+
+        inline bool operator==(const PenguinShapeKey& other_key) const {
+            return kind == other_key.kind && radius_x == other_key.radius_x && radius_y == other_key.radius_y && filled == other_key.filled;
+        }
+    };
+
+    /// @brief Hashes a PenguinShapeKey for use in the shape cache.
+    struct PenguinShapeKeyHash {
+        inline size_t operator()(const PenguinShapeKey& key) const {
+            uint64_t packed = ((uint64_t)(uint32_t)key.radius_x << 32) | ((uint64_t)(uint32_t)key.radius_y << 2) | ((uint64_t)key.kind << 1) | (uint64_t)key.filled;
+            return std::hash<uint64_t>{}(packed);
+        }
+    };
+
+    /// @brief The origin-relative geometry of a circle or ellipse, translated to its centre when drawn.
+    struct PenguinShapeMesh {
+        std::vector<SDL_FPoint> points; /// Outline points, or the vertex positions of a filled shape.
+        std::vector<int> indices; /// Triangle indices of a filled shape (empty for outlines).
+    };
+
     /// @brief Manages rendering operations for a given window.
     ///
     /// This class handles the creation and management of a rendering
@@ -94,6 +180,25 @@ namespace Penguin2D {
         /// @brief Presents the rendered content to the window.
         void present();
 
+        /// @brief Submits all recorded primitives to SDL.
+        void flush();
+
+        /// @brief Sets how primitives are submitted to SDL, flushing any recorded primitives.
+        /// @param mode: The render mode to use.
+        void set_render_mode(PenguinRenderMode mode);
+
+        /// @brief Gets how primitives are submitted to SDL.
+        /// @return The current render mode.
+        PenguinRenderMode get_render_mode() const;
+
+        /// @brief Gets the renderer's statistics.
+        /// @return The current statistics of the renderer.
+        PenguinRenderStats get_stats() const;
+
+        /// @brief Sets the number of circle and ellipse meshes kept in the shape cache.
+        /// @param capacity: The maximum number of cached meshes (0 disables the cache).
+        void set_shape_cache_capacity(size_t capacity);
+
         /// @brief Sets the current drawing color.
         /// @param: colour The color to set.
         void set_colour(Colour colour);
@@ -101,14 +206,63 @@ namespace Penguin2D {
         /// @brief Resets the drawing color to its default value.
         void reset_colour();
 
+        /// @brief Sets the blend mode used when drawing primitives.
+        /// @param blend_mode: The SDL blend mode to set.
+        void set_blend_mode(SDL_BlendMode blend_mode);
+
+        /// @brief Forgets the tracked draw colour and blend mode, so the next change is always sent to SDL.
+        ///
+        /// Call this after changing the draw state directly through get_renderer().
+        void invalidate_state();
+
         /// @brief Retrieves the SDL_Renderer instance.
         /// @return A pointer to the SDL_Renderer.
         SDL_Renderer* get_renderer();
 
+        /// @brief Retrieves the cache that shares textures loaded by this renderer.
+        /// @return A reference to the PenguinTextureCache.
+        PenguinTextureCache& get_texture_cache();
 
 	private:
 		std::unique_ptr<SDL_Renderer, void(*)(SDL_Renderer*)> renderer;
-		void draw_horizontal_line(float x1, float x2, float y, Colour colour);
+		PenguinTextureCache texture_cache; /// Textures loaded from files, shared by path. Declared after the renderer so it is destroyed first.
+		PenguinRenderMode render_mode = PenguinRenderMode::IMMEDIATE; /// How primitives are submitted to SDL.
+		std::vector<PenguinDrawCommand> draw_commands; /// Primitives recorded since the last flush.
+		ScratchBuffer<SDL_FPoint> point_arena; /// Points written by shape generators, referenced by POINTS commands. Reset each frame.
+		ScratchBuffer<SDL_Vertex> vertex_arena; /// Vertices written by shape generators, referenced by GEOMETRY commands. Reset each frame.
+		ScratchBuffer<int> index_arena; /// Indices referenced by GEOMETRY commands. Reset each frame.
+		ScratchBuffer<SDL_FPoint> merged_points; /// Reused when merging POINTS commands during a flush.
+		ScratchBuffer<SDL_FRect> merged_rects; /// Reused when merging RECT and FILLED_RECT commands during a flush.
+		ScratchBuffer<int> merged_indices; /// Reused when merging GEOMETRY commands during a flush.
+
+		static constexpr int MIN_CIRCLE_SEGMENTS = 16; /// The fewest segments used for a filled circle or ellipse.
+		static constexpr int MAX_CIRCLE_SEGMENTS = 1024; /// The most segments used for a filled circle or ellipse.
+		std::unordered_map<int, PenguinUnitCircle> unit_circles; /// Unit circles keyed by their number of segments.
+
+		using PenguinShapeCacheEntry = std::pair<PenguinShapeKey, PenguinShapeMesh>;
+		size_t shape_cache_capacity = 64; /// The maximum number of meshes kept in the shape cache.
+		std::list<PenguinShapeCacheEntry> shape_cache; /// Cached meshes, from most to least recently used.
+		std::unordered_map<PenguinShapeKey, std::list<PenguinShapeCacheEntry>::iterator, PenguinShapeKeyHash> shape_cache_lookup; /// Finds cached meshes by key.
+		PenguinShapeMesh uncached_mesh; /// Reused to build meshes while the shape cache is disabled.
+		size_t shape_cache_hits = 0; /// The number of lookups that found a cached mesh.
+		size_t shape_cache_misses = 0; /// The number of lookups that had to build a mesh.
+
+		std::optional<Colour> bound_colour; /// The draw colour currently set in SDL, if known.
+		std::optional<SDL_BlendMode> bound_blend_mode; /// The blend mode currently set in SDL, if known.
+		size_t state_changes_issued = 0; /// The number of state changes sent to SDL since the last clear.
+		size_t state_changes_skipped = 0; /// The number of state changes skipped since the last clear.
+
+		const PenguinUnitCircle& get_unit_circle(float radius_x, float radius_y);
+		const PenguinShapeMesh& get_shape_mesh(const PenguinShapeKey& key);
+		void build_circle_outline(int radius, std::vector<SDL_FPoint>& points);
+		void build_ellipse_outline(int radius_x, int radius_y, std::vector<SDL_FPoint>& points);
+		void build_filled_fan(float radius_x, float radius_y, PenguinShapeMesh& mesh);
+		void submit_outline(const PenguinShapeMesh& mesh, Vector2<float> center, Colour outline);
+		void submit_mesh(const PenguinShapeMesh& mesh, Vector2<float> center, Colour fill);
+		void submit_geometry(size_t first_vertex, size_t vertex_count, const int* indices, size_t index_count, Colour colour);
+		void submit_points(size_t first_point, size_t count, Colour colour);
+		void record_line(Vector2<float> vect_a, Vector2<float> vect_b, Colour colour);
+		void submit_run(size_t first_command, size_t last_command);
 	};
 }
 
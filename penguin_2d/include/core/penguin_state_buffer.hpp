@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_state_buffer.hpp                                         ///
+///                                                                             ///
+/// Defines the PenguinStateBuffer class, a double buffer for handing game      ///
+/// state from update() to draw().                                              ///
+///                                                                             ///
+/// update() writes to the update state and draw() reads the draw state. The    ///
+/// two only meet in publish(), which a game calls from its publish_state()     ///
+/// override. In pipelined mode this lets draw() render one frame while         ///
+/// update() simulates the next on another thread.                              ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_STATE_BUFFER_HPP
+#define PENGUIN_STATE_BUFFER_HPP
+
+namespace Penguin2D {
+
+	/// @brief Holds a copy of a game state for update() and a copy for draw().
+	///
+	/// publish() copies the update state over the draw state rather than swapping them, so
+	/// the update state always continues from the latest simulation step.
+	///
+	/// @tparam T: The type of the state. It must be copy assignable.
+	template <typename T>
+	class PenguinStateBuffer {
+	public:
+		/// @brief Constructs a PenguinStateBuffer with default constructed states.
+		PenguinStateBuffer() = default;
+
+		/// @brief Constructs a PenguinStateBuffer with both states set to an initial value.
+		/// @param initial_state: The initial value of both states.
+		explicit PenguinStateBuffer(const T& initial_state) : update_state(initial_state), draw_state(initial_state) {}
+
+		~PenguinStateBuffer() = default;
+
+		/// @brief Gets the state written by update().
+		/// @return The update state.
+		inline T& get_update_state() { return update_state; }
+
+		/// @brief Gets the state read by draw().
+		/// @return The state as of the last publish().
+		inline const T& get_draw_state() const { return draw_state; }
+
+		/// @brief Copies the update state over the draw state.
+		///
+		/// Call this from PenguinGame::publish_state(), where neither update() nor draw() is running.
+		inline void publish() { draw_state = update_state; }
+
+		/// @brief Sets both states, e.g., when a game is (re)initialized.
+		/// @param state: The new value of both states.
+		inline void reset(const T& state) {
+			update_state = state;
+			draw_state = state;
+		}
+
+	private:
+		T update_state{}; /// The state written by update().
+		T draw_state{}; /// The state read by draw().
+	};
+}
+
+#endif // PENGUIN_STATE_BUFFER_HPP
@@ -14,31 +14,42 @@
 // Penguin2D related include files
 #include "penguin_renderer.hpp"
 #include "exception.hpp"
-
-// SDL related include files
-#include <SDL3_ttf/SDL_textengine.h>
+#include "penguin_font_registry.hpp"
+#include "penguin_glyph_atlas.hpp"
 
 // C++ library files
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace Penguin2D {
 
     /// @brief A class responsible for handling text rendering operations.
     ///
-    /// This class provides functionality for rendering text to the screen using a text engine (e.g., SDL_ttf).
-    /// It manages the underlying text renderer and allows you to interact with it for creating and displaying text.
+    /// This class provides functionality for rendering text to the screen with SDL_ttf fonts.
+    /// It owns the fonts and glyph atlases that texts created with it share.
     class PenguinTextRenderer {
     public:
         /// @brief Constructs a PenguinTextRenderer with the given renderer.
         /// @param renderer: The PenguinRenderer that this text renderer will be associated with.
         PenguinTextRenderer(PenguinRenderer& renderer);
 
-        /// @brief Retrieves the underlying text renderer engine.
-        /// @return A pointer to the TTF_TextEngine used for rendering text.
-        TTF_TextEngine* get_text_renderer();
+        /// @brief Retrieves the renderer this text renderer draws onto.
+        /// @return The associated PenguinRenderer.
+        PenguinRenderer& get_renderer();
+
+        /// @brief Retrieves the registry that shares fonts between texts.
+        /// @return The PenguinFontRegistry of this text renderer.
+        PenguinFontRegistry& get_font_registry();
+
+        /// @brief Retrieves the glyph atlas of a font, creating it the first time it is requested.
+        /// @param font: The font to retrieve the glyph atlas of. It must be owned by the font registry.
+        /// @return The PenguinGlyphAtlas of the font.
+        PenguinGlyphAtlas& get_glyph_atlas(const PenguinFont& font);
     private:
-        std::unique_ptr<TTF_TextEngine, void(*)(TTF_TextEngine*)> text_renderer; 
+        PenguinRenderer& renderer; /// The renderer this text renderer draws onto.
+        PenguinFontRegistry font_registry; /// The fonts shared by texts drawn with this text renderer.
+        std::unordered_map<const PenguinFont*, std::unique_ptr<PenguinGlyphAtlas>> glyph_atlases; /// The glyph atlas of each font. Declared after the registry so atlases are destroyed before their fonts.
     };
 }
 
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_texture_cache.hpp                                        ///
+///                                                                             ///
+/// Defines the PenguinTextureCache class, which shares loaded textures between ///
+/// everything that loads the same image file.                                  ///
+///                                                                             ///
+/// Textures are keyed by their canonical file path and handed out as shared    ///
+/// handles, so an image is decoded and uploaded once no matter how many        ///
+/// sprites use it. The cache tracks the bytes its textures occupy and can      ///
+/// evict textures that are no longer used to stay under a memory budget.       ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_TEXTURE_CACHE_HPP
+#define PENGUIN_TEXTURE_CACHE_HPP
+
+// SDL related include files
+#include <SDL3/SDL_render.h>
+
+// C++ library files
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Penguin2D {
+
+	/// @brief Statistics gathered by a PenguinTextureCache.
+	struct PenguinTextureCacheStats {
+		size_t hits = 0; /// The number of loads that reused a cached texture.
+		size_t misses = 0; /// The number of loads that had to load the texture from disk.
+		size_t evictions = 0; /// The number of textures removed from the cache.
+		size_t bytes_resident = 0; /// The estimated size of the cached textures in bytes.
+		size_t texture_count = 0; /// The number of cached textures.
+	};
+
+	/// @brief Loads textures once and shares them between their users.
+	///
+	/// A texture stays cached while any handle to it is alive. Once only the cache holds it,
+	/// it is considered unused and may be evicted, either explicitly with evict_unused() or
+	/// automatically when the memory budget is exceeded. Handles must be released before the
+	/// renderer that created them is destroyed.
+	class PenguinTextureCache {
+	public:
+		/// @brief Constructs an empty PenguinTextureCache.
+		/// @param renderer: The SDL_Renderer used to create the textures.
+		explicit PenguinTextureCache(SDL_Renderer* renderer);
+		~PenguinTextureCache() = default;
+
+		/// @brief Retrieves the texture for an image file, loading it if it is not cached.
+		/// @param path: The file path to the image.
+		/// @return A shared handle to the texture, or an empty handle if the image could not be loaded.
+		std::shared_ptr<SDL_Texture> load(const std::string& path);
+
+		/// @brief Checks if the texture for an image file is cached.
+		/// @param path: The file path to the image.
+		/// @return True if the texture is cached, otherwise false.
+		bool contains(const std::string& path) const;
+
+		/// @brief Removes every texture that is only held by the cache.
+		/// @return The number of textures removed.
+		size_t evict_unused();
+
+		/// @brief Sets the memory budget, evicting unused textures if it is exceeded.
+		/// @param bytes: The budget in bytes (0 means unlimited).
+		void set_memory_budget(size_t bytes);
+
+		/// @brief Gets the memory budget.
+		/// @return The budget in bytes (0 means unlimited).
+		size_t get_memory_budget() const;
+
+		/// @brief Gets the estimated size of the cached textures.
+		/// @return The size in bytes.
+		size_t get_bytes_resident() const;
+
+		/// @brief Gets the statistics of the cache.
+		/// @return The current statistics of the cache.
+		PenguinTextureCacheStats get_stats() const;
+
+	private:
+		/// @brief A texture held by the cache.
+		struct CachedTexture {
+			std::shared_ptr<SDL_Texture> texture; /// The cached texture.
+			size_t bytes; /// The estimated size of the texture in bytes.
+			uint64_t last_used; /// The value of use_clock when the texture was last loaded.
+		};
+
+		SDL_Renderer* renderer; /// The SDL_Renderer used to create the textures.
+		std::unordered_map<std::string, CachedTexture> textures; /// The cached textures, keyed by canonical path.
+		size_t memory_budget = 0; /// The memory budget in bytes (0 means unlimited).
+		size_t bytes_resident = 0; /// The estimated size of the cached textures in bytes.
+		uint64_t use_clock = 0; /// Incremented on every load, used to find the least recently used textures.
+		size_t hits = 0; /// The number of loads that reused a cached texture.
+		size_t misses = 0; /// The number of loads that had to load the texture from disk.
+		size_t evictions = 0; /// The number of textures removed from the cache.
+
+		void trim_to_budget();
+	};
+}
+
+#endif // PENGUIN_TEXTURE_CACHE_HPP
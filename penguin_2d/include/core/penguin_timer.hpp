@@ -15,15 +15,46 @@
 #ifndef PENGUIN_TIMER_HPP
 #define PENGUIN_TIMER_HPP
 
+// Penguin2D related include files
+#include "penguin_frame_pacer.hpp"
+
 // SDL related include files
 #include <SDL3/SDL_timer.h>
 
 // C++ library files
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <thread>
 
 namespace Penguin2D {
 
+    /// @brief How the timer copes when a frame's updates cannot catch up with real time.
+    enum class PenguinOverloadMode {
+        DROP_TIME, /// Discard the simulation time that did not fit in the frame.
+        VARIABLE_STEP, /// Run one extra, longer step that covers the time that did not fit.
+        TIME_DILATION /// Discard the time, and slow the game clock until the updates fit again.
+    };
+
+    /// @brief Counters of how the fixed timestep coped with overload.
+    struct PenguinTimestepStats {
+        uint64_t overloaded_frames = 0; /// The number of frames whose updates hit the substep limit or the budget.
+        uint64_t catch_up_steps = 0; /// The number of longer steps run in VARIABLE_STEP mode.
+        double dropped_time = 0.0; /// The simulation time discarded, in seconds.
+        double dilated_time = 0.0; /// The real time not simulated because the game clock was slowed, in seconds.
+        double time_scale = 1.0; /// The current speed of the game clock relative to real time.
+        double update_cost_ms = 0.0; /// The measured average cost of one update in milliseconds.
+    };
+
+    /// @brief Statistics of the intervals between recent frame starts.
+    struct PenguinFrameStats {
+        size_t count = 0; /// The number of intervals measured.
+        double mean_ms = 0.0; /// The mean interval in milliseconds.
+        double stddev_ms = 0.0; /// The standard deviation of the intervals (the frame jitter) in milliseconds.
+        double min_ms = 0.0; /// The shortest interval in milliseconds.
+        double max_ms = 0.0; /// The longest interval in milliseconds.
+    };
+
     /// @brief Manages game timing, frame rate control, and updates.
     ///
     /// This class is responsible for handling delta time calculations,
@@ -46,16 +77,61 @@ namespace Penguin2D {
         /// @brief Updates the FPS counter.
         void update_fps();
 
-        /// @brief Consumes accumulated time to synchronize game updates with the frame rate.
+        /// @brief Consumes the time of the step that was just run.
         void consume_time();
 
+        /// @brief Applies the overload mode to any whole steps left after the frame's updates.
+        void end_updates();
+
+        /// @brief Records how long an update took, for the update budget.
+        /// @param seconds: The duration of one update in seconds.
+        void record_update_cost(double seconds);
+
+        /// @brief Limits the number of updates run in a frame.
+        /// @param max: The maximum number of updates per frame (0 for no limit).
+        void set_max_substeps(int max);
+
+        /// @brief Limits the time spent on updates in a frame, based on their measured cost.
+        /// @param seconds: The update budget per frame in seconds (0 for no budget).
+        void set_update_budget(double seconds);
+
+        /// @brief Sets how the timer copes when the updates cannot catch up with real time.
+        /// @param mode: The overload mode.
+        void set_overload_mode(PenguinOverloadMode mode);
+
+        /// @brief Sets how far TIME_DILATION may slow the game clock.
+        /// @param scale: The slowest game clock speed relative to real time (between 0 and 1).
+        void set_min_time_scale(double scale);
+
+        /// @brief Gets the counters of how the fixed timestep coped with overload.
+        /// @return The timestep statistics.
+        PenguinTimestepStats get_timestep_stats() const;
+
         /// @brief Enables or disables FPS capping and sets the target FPS.
         /// @param enable: True to enable FPS capping, false to disable.
         /// @param fps: Target FPS value (default is 60.0).
         void set_fps_cap(bool enable, double fps = 60.0);
 
-        /// @brief Caps the frame rate by enforcing a delay if the frame time is too short.
-        void cap_frame_rate() const;
+        /// @brief Calibrates the frame pacer if the frame rate is capped and it has not been calibrated.
+        ///
+        /// Called by set_fps_cap() and by the game window before its loop starts, so the calibration
+        /// sleeps never land inside a frame.
+        void calibrate_frame_pacer();
+
+        /// @brief Caps the frame rate by waiting for the next frame start, and records the frame interval.
+        void cap_frame_rate();
+
+        /// @brief Sets how the frame rate cap waits for the next frame.
+        /// @param mode: The pacing mode.
+        void set_pacing_mode(PenguinPacingMode mode);
+
+        /// @brief Gets the frame pacer used by the frame rate cap.
+        /// @return The frame pacer.
+        PenguinFramePacer& get_frame_pacer();
+
+        /// @brief Gets statistics of the intervals between recent frame starts.
+        /// @return The frame interval statistics.
+        PenguinFrameStats get_frame_stats() const;
 
         /// @brief Checks whether the game should update based on the accumulated time.
         /// @return True if an update should occur, otherwise false.
@@ -69,6 +145,14 @@ namespace Penguin2D {
         /// @return The delta time value.
         double get_delta_time() const;
 
+        /// @brief Retrieves the delta time of the next update.
+        /// @return The fixed delta time, or a longer catch-up step in VARIABLE_STEP mode.
+        double get_step_time() const;
+
+        /// @brief Checks if the next update is a catch-up step.
+        /// @return True if the next update is a longer VARIABLE_STEP catch-up step, otherwise false.
+        bool is_catch_up_step() const;
+
         /// @brief Retrieves the current frames per second (FPS).
         /// @return The FPS value.
         double get_fps() const;
@@ -89,6 +173,22 @@ namespace Penguin2D {
 		double fps = 0.0;
 		penguin_clock::time_point prev_time = penguin_clock::now();
 		penguin_clock::time_point fps_start_time = prev_time;
+		int max_substeps = 0; /// The maximum number of updates per frame, or 0 for no limit.
+		double update_budget = 0.0; /// The time updates may take per frame in seconds, or 0 for no budget.
+		PenguinOverloadMode overload_mode = PenguinOverloadMode::DROP_TIME; /// How overload is handled.
+		double min_time_scale = 0.25; /// The slowest TIME_DILATION game clock speed.
+		int substeps = 0; /// The number of updates run in the current frame.
+		double time_scale = 1.0; /// The speed of the game clock relative to real time.
+		double update_cost = 0.0; /// The moving average cost of one update in seconds.
+		PenguinTimestepStats timestep_stats; /// The overload counters.
+		PenguinFramePacer pacer; /// Waits for the next frame start when the frame rate is capped.
+		penguin_clock::time_point next_frame_start = prev_time; /// When the next capped frame should start.
+		penguin_clock::time_point last_frame_start = prev_time; /// When the current frame started.
+		static constexpr size_t FRAME_HISTORY = 240; /// The number of frame intervals kept for statistics.
+		std::array<double, FRAME_HISTORY> frame_intervals{}; /// The most recent frame intervals in seconds.
+		size_t frame_interval_count = 0; /// The number of frame intervals ever recorded.
+
+		bool has_room_for_steps(int steps) const;
 	};
 }
 
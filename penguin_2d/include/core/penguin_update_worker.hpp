@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_update_worker.hpp                                        ///
+///                                                                             ///
+/// Defines the PenguinUpdateWorker class, which runs a game's fixed updates on ///
+/// a dedicated thread.                                                         ///
+///                                                                             ///
+/// The class is used internally in PenguinGameWindow when pipelining is        ///
+/// enabled: the main thread hands the worker a batch of update steps, draws    ///
+/// the previous frame while they run, and then waits for the batch to finish.  ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_UPDATE_WORKER_HPP
+#define PENGUIN_UPDATE_WORKER_HPP
+
+// Penguin2D related include files
+#include "penguin_game.hpp"
+#include "penguin_profiler.hpp"
+
+// C++ library files
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Penguin2D {
+
+	/// @brief Runs batches of PenguinGame::update() calls on a dedicated thread.
+	///
+	/// At most one batch is in flight at a time. An exception thrown by update() stops the
+	/// batch and is rethrown on the thread that calls wait().
+	class PenguinUpdateWorker {
+	public:
+		/// @brief Constructs a PenguinUpdateWorker and starts its thread.
+		/// @param game: The game to update. It must outlive the worker.
+		/// @param profiler: The profiler each update step is recorded in.
+		/// @param begin_step: Called on the worker thread before each update step.
+		PenguinUpdateWorker(PenguinGame& game, PenguinProfiler& profiler, std::function<void()> begin_step);
+
+		/// @brief Finishes the batch in flight, if any, and joins the thread.
+		~PenguinUpdateWorker();
+
+		PenguinUpdateWorker(const PenguinUpdateWorker&) = delete;
+		PenguinUpdateWorker& operator=(const PenguinUpdateWorker&) = delete;
+
+		/// @brief Starts a batch of update steps. The previous batch must have been waited for.
+		/// @param steps: The number of fixed steps.
+		/// @param delta_time: The delta time passed to each fixed step.
+		/// @param catch_up_time: The delta time of a final catch-up step, or 0 for none (optional, defaults to 0).
+		void start_updates(int steps, double delta_time, double catch_up_time = 0.0);
+
+		/// @brief Blocks until the batch in flight has finished.
+		/// @return The average duration of one update in the batch in seconds, or 0 if no batch ran since the last wait.
+		/// @throws The exception thrown by update(), if any.
+		double wait();
+
+	private:
+		void worker_loop();
+
+		PenguinGame& game; /// The game being updated.
+		PenguinProfiler& profiler; /// The profiler update steps are recorded in.
+		std::function<void()> begin_step; /// Called before each update step.
+		std::mutex mutex; /// Guards the batch state below.
+		std::condition_variable batch_started; /// Signalled when a batch is started or the worker stops.
+		std::condition_variable batch_finished; /// Signalled when a batch has finished.
+		int pending_steps = 0; /// The number of steps in the batch in flight.
+		double step_delta_time = 0.0; /// The delta time of the batch in flight.
+		double step_catch_up_time = 0.0; /// The catch-up step of the batch in flight, or 0 for none.
+		double step_cost = 0.0; /// The average duration of one update in the last batch in seconds.
+		bool busy = false; /// Whether a batch is in flight.
+		bool stopping = false; /// Whether the worker should exit once idle.
+		std::exception_ptr error; /// The exception thrown by the last batch, if any.
+		std::thread thread; /// The worker thread. Declared last so it starts after the state above.
+	};
+}
+
+#endif // PENGUIN_UPDATE_WORKER_HPP
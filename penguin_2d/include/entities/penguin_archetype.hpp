@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_archetype.hpp                                            ///
+///                                                                             ///
+/// Defines the PenguinArchetype class, which stores every entity that has the  ///
+/// same set of component types.                                                ///
+///                                                                             ///
+/// Entities are packed into fixed-size chunks. Within a chunk each component   ///
+/// type has its own contiguous array (structure of arrays), so a query walks   ///
+/// plain arrays chunk by chunk. Entities stay densely packed: removing one     ///
+/// moves the archetype's last entity into its place.                           ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_ARCHETYPE_HPP
+#define PENGUIN_ARCHETYPE_HPP
+
+// Penguin2D related include files
+#include "penguin_component.hpp"
+
+// C++ library files
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief Stores the entities and components of one set of component types.
+	class PenguinArchetype {
+	public:
+		static constexpr size_t CHUNK_BYTES = 16 * 1024; /// The target size of a chunk in bytes.
+
+		/// @brief Constructs an empty PenguinArchetype and lays out its chunks.
+		/// @param mask: The component types of the archetype.
+		explicit PenguinArchetype(PenguinComponentMask mask);
+
+		/// @brief Destroys every component of the archetype.
+		~PenguinArchetype();
+
+		PenguinArchetype(const PenguinArchetype&) = delete;
+		PenguinArchetype& operator=(const PenguinArchetype&) = delete;
+
+		/// @brief Gets the component types of the archetype.
+		/// @return The component mask.
+		inline PenguinComponentMask get_mask() const { return mask; }
+
+		/// @brief Gets the component types of the archetype, ordered by column.
+		/// @return The component ids.
+		inline const std::vector<PenguinComponentId>& get_components() const { return components; }
+
+		/// @brief Gets the column of a component type.
+		/// @param id: The id of the component type.
+		/// @return The column, or -1 if the archetype does not have the component type.
+		inline int get_column(PenguinComponentId id) const { return id < PENGUIN_MAX_COMPONENTS ? columns_by_id[id] : -1; }
+
+		/// @brief Gets the number of entities a chunk holds.
+		/// @return The chunk capacity.
+		inline size_t get_chunk_capacity() const { return chunk_capacity; }
+
+		/// @brief Gets the number of chunks.
+		/// @return The number of chunks.
+		inline size_t get_chunk_count() const { return chunks.size(); }
+
+		/// @brief Gets the number of entities in a chunk.
+		/// @param chunk: The index of the chunk.
+		/// @return The number of entities in the chunk. Every chunk but the last is full.
+		inline size_t get_chunk_size(size_t chunk) const {
+			return chunk + 1 < chunks.size() ? chunk_capacity : entity_count - chunk * chunk_capacity;
+		}
+
+		/// @brief Gets the number of entities.
+		/// @return The number of entities in the archetype.
+		inline size_t get_entity_count() const { return entity_count; }
+
+		/// @brief Gets the entity ids of a chunk.
+		/// @param chunk: The index of the chunk.
+		/// @return The chunk's array of entity ids.
+		inline PenguinEntityId* get_entities(size_t chunk) { return reinterpret_cast<PenguinEntityId*>(chunks[chunk].get()); }
+
+		/// @brief Gets the array of a column in a chunk.
+		/// @param chunk: The index of the chunk.
+		/// @param column: The column.
+		/// @return The first component of the column in the chunk.
+		inline void* get_column_data(size_t chunk, int column) { return chunks[chunk].get() + column_offsets[column]; }
+
+		/// @brief Gets the component of an entity.
+		/// @param row: The row of the entity in the archetype.
+		/// @param column: The column of the component.
+		/// @return The component.
+		inline void* get_component(size_t row, int column) {
+			return chunks[row / chunk_capacity].get() + column_offsets[column] + (row % chunk_capacity) * column_sizes[column];
+		}
+
+		/// @brief Gets the entity in a row.
+		/// @param row: The row of the entity in the archetype.
+		/// @return The entity id.
+		inline PenguinEntityId get_entity(size_t row) { return get_entities(row / chunk_capacity)[row % chunk_capacity]; }
+
+		/// @brief Appends a row for an entity. Its components are left uninitialized and must all be constructed.
+		/// @param entity: The entity the row belongs to.
+		/// @return The row of the entity.
+		size_t push_entity(PenguinEntityId entity);
+
+		/// @brief Removes a row by moving the last entity into it.
+		/// @param row: The row to remove.
+		/// @param destroy_components: True to destroy the row's components, false if they were already moved out.
+		/// @return The entity moved into the row, or a null id if the removed row was the last one.
+		PenguinEntityId erase_row(size_t row, bool destroy_components);
+
+	private:
+		/// @brief Frees a chunk allocated with the chunk alignment.
+		struct ChunkDeleter {
+			size_t alignment;
+			void operator()(std::byte* chunk) const { ::operator delete[](chunk, std::align_val_t(alignment)); }
+		};
+
+		PenguinComponentMask mask; /// The component types of the archetype.
+		std::vector<PenguinComponentId> components; /// The component type of each column.
+		std::array<int, PENGUIN_MAX_COMPONENTS> columns_by_id; /// The column of each component type, or -1.
+		std::vector<size_t> column_offsets; /// The byte offset of each column's array in a chunk.
+		std::vector<size_t> column_sizes; /// The size of each column's components.
+		size_t chunk_capacity = 0; /// The number of entities a chunk holds.
+		size_t chunk_bytes = 0; /// The allocated size of a chunk.
+		size_t chunk_alignment = 64; /// The alignment of a chunk (at least a cache line).
+		std::vector<std::unique_ptr<std::byte[], ChunkDeleter>> chunks; /// The chunks, all full but the last.
+		size_t entity_count = 0; /// The number of entities.
+	};
+}
+
+#endif // PENGUIN_ARCHETYPE_HPP
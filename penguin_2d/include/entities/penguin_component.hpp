@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_component.hpp                                            ///
+///                                                                             ///
+/// Defines the identifiers shared by the entity component system: entity ids,  ///
+/// component type ids and component masks.                                     ///
+///                                                                             ///
+/// Every component type is registered the first time it is used, and given a   ///
+/// small id and the functions needed to move and destroy it without knowing    ///
+/// its type. A set of component types is a 64-bit mask of their ids.           ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_COMPONENT_HPP
+#define PENGUIN_COMPONENT_HPP
+
+// C++ library files
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace Penguin2D {
+
+	/// @brief Identifies an entity in a PenguinWorld.
+	///
+	/// The generation is bumped whenever an index is reused, so an id held after its entity
+	/// was destroyed never refers to a newer entity.
+	struct PenguinEntityId {
+		uint32_t index = UINT32_MAX; /// The index of the entity's record in the world.
+		uint32_t generation = 0; /// The generation of the record when the entity was created.
+
+		/// @brief Checks if the id refers to no entity.
+		/// @return True if the id is null, otherwise false.
+		inline constexpr bool is_null() const { return index == UINT32_MAX; }
+
+		inline constexpr bool operator==(const PenguinEntityId& other) const = default;
+	};
+
+	using PenguinComponentId = uint32_t; /// The id of a component type.
+	using PenguinComponentMask = uint64_t; /// A set of component types, one bit per component id.
+	constexpr PenguinComponentId PENGUIN_MAX_COMPONENTS = 64; /// The number of component types a program may use.
+
+	/// @brief Describes a component type to code that does not know the type.
+	struct PenguinComponentInfo {
+		const char* name; /// The implementation-defined name of the type.
+		size_t size; /// The size of the type in bytes.
+		size_t alignment; /// The alignment of the type in bytes.
+		void (*relocate)(void* destination, void* source); /// Move-constructs a component into uninitialized storage and destroys the source.
+		void (*destroy)(void* component); /// Destroys a component.
+	};
+
+	/// @brief Assigns ids to component types.
+	class PenguinComponentRegistry {
+	public:
+		/// @brief Gets the id of a component type, registering the type on first use.
+		/// @tparam T: The component type. Const qualification is ignored.
+		/// @return The id of the component type.
+		template <typename T>
+		static PenguinComponentId get_id();
+
+		/// @brief Gets the mask of a set of component types.
+		/// @tparam Ts: The component types.
+		/// @return The mask with the bit of each component type set.
+		template <typename... Ts>
+		static PenguinComponentMask get_mask();
+
+		/// @brief Gets the description of a registered component type.
+		/// @param id: The id of the component type.
+		/// @return The description of the component type.
+		static const PenguinComponentInfo& get_info(PenguinComponentId id);
+
+		/// @brief Gets the number of registered component types.
+		/// @return The number of registered component types.
+		static PenguinComponentId get_count();
+
+	private:
+		static PenguinComponentId register_component(const PenguinComponentInfo& info);
+
+		template <typename T>
+		static void relocate(void* destination, void* source) {
+			T* source_component = static_cast<T*>(source);
+			new (destination) T(std::move(*source_component));
+			source_component->~T();
+		}
+
+		template <typename T>
+		static void destroy(void* component) {
+			static_cast<T*>(component)->~T();
+		}
+	};
+
+	/// @brief Gets the id of a component type, registering the type on first use.
+	/// @return The id of the component type.
+	template <typename T>
+	PenguinComponentId PenguinComponentRegistry::get_id() {
+		using Component = std::remove_cv_t<T>;
+		if constexpr (!std::is_same_v<T, Component>) {
+			return get_id<Component>();
+		}
+		else {
+			static_assert(std::is_nothrow_move_constructible_v<Component>, "Components must be nothrow move constructible, as they are moved between archetypes.");
+			static_assert(std::is_nothrow_destructible_v<Component>, "Components must be nothrow destructible.");
+
+			static const PenguinComponentId id = register_component(PenguinComponentInfo{
+				typeid(Component).name(), sizeof(Component), alignof(Component), &relocate<Component>, &destroy<Component> });
+			return id;
+		}
+	}
+
+	/// @brief Gets the mask of a set of component types.
+	/// @return The mask with the bit of each component type set.
+	template <typename... Ts>
+	PenguinComponentMask PenguinComponentRegistry::get_mask() {
+		return (PenguinComponentMask(0) | ... | (PenguinComponentMask(1) << get_id<Ts>()));
+	}
+}
+
+#endif // PENGUIN_COMPONENT_HPP
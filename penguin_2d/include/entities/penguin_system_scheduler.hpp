@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_system_scheduler.hpp                                     ///
+///                                                                             ///
+/// Defines the PenguinSystemScheduler class, which runs the systems of a       ///
+/// PenguinWorld concurrently on a PenguinJobSystem.                            ///
+///                                                                             ///
+/// Every system declares the component types it reads and writes. A system    ///
+/// runs after each earlier-added system it conflicts with (one writes what the ///
+/// other reads or writes), and alongside every other system. Structural        ///
+/// changes go through the world's command buffer, which is flushed once every  ///
+/// system has finished.                                                        ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_SYSTEM_SCHEDULER_HPP
+#define PENGUIN_SYSTEM_SCHEDULER_HPP
+
+// Penguin2D related include files
+#include "penguin_world.hpp"
+#include "penguin_job_system.hpp"
+#include "penguin_profiler.hpp"
+
+// C++ library files
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief The component types a system reads and writes.
+	struct PenguinSystemAccess {
+		PenguinComponentMask reads = 0; /// The component types the system only reads.
+		PenguinComponentMask writes = 0; /// The component types the system writes.
+		bool exclusive = false; /// Whether the system must run alone (e.g., it reads the whole world).
+
+		/// @brief Adds component types the system reads.
+		/// @return The access, for chaining.
+		template <typename... Ts>
+		PenguinSystemAccess& read() {
+			reads |= PenguinComponentRegistry::get_mask<Ts...>();
+			return *this;
+		}
+
+		/// @brief Adds component types the system writes.
+		/// @return The access, for chaining.
+		template <typename... Ts>
+		PenguinSystemAccess& write() {
+			writes |= PenguinComponentRegistry::get_mask<Ts...>();
+			return *this;
+		}
+
+		/// @brief Gets the access of a query: const component types are read, the others written.
+		/// @return The access.
+		template <typename... Ts>
+		static PenguinSystemAccess of() {
+			PenguinSystemAccess access;
+			((std::is_const_v<Ts> ? access.read<Ts>() : access.write<Ts>()), ...);
+			return access;
+		}
+
+		/// @brief Checks if two systems may not run at the same time.
+		/// @param other: The access of the other system.
+		/// @return True if either system is exclusive or writes a component type the other uses, otherwise false.
+		inline bool conflicts_with(const PenguinSystemAccess& other) const {
+			return exclusive || other.exclusive || (writes & (other.reads | other.writes)) || (other.writes & reads);
+		}
+	};
+
+	/// @brief A system: a function run once per tick with the world and the delta time.
+	using PenguinSystem = std::function<void(PenguinWorld& world, double delta_time)>;
+
+	/// @brief The timings and schedule of a system.
+	struct PenguinSystemStats {
+		std::string name; /// The name of the system.
+		size_t stage = 0; /// The length of the longest chain of systems that must run before it.
+		size_t runs = 0; /// The number of ticks the system ran in since the statistics were reset.
+		double last_ms = 0.0; /// The duration of the last run in milliseconds.
+		double mean_ms = 0.0; /// The mean duration of a run in milliseconds.
+		double max_ms = 0.0; /// The longest run in milliseconds.
+	};
+
+	/// @brief Runs the systems of a world, concurrently wherever their component access allows.
+	class PenguinSystemScheduler {
+	public:
+		/// @brief Constructs a PenguinSystemScheduler with no systems.
+		/// @param world: The world the systems run on.
+		/// @param job_system: The job system that runs the systems.
+		PenguinSystemScheduler(PenguinWorld& world, PenguinJobSystem& job_system);
+		~PenguinSystemScheduler() = default;
+
+		PenguinSystemScheduler(const PenguinSystemScheduler&) = delete;
+		PenguinSystemScheduler& operator=(const PenguinSystemScheduler&) = delete;
+
+		/// @brief Adds a system. It runs after every earlier-added system it conflicts with.
+		/// @param name: The name of the system, shown in the schedule and the profiler.
+		/// @param access: The component types the system reads and writes.
+		/// @param system: The function run each tick.
+		/// @return The index of the system.
+		size_t add_system(const std::string& name, const PenguinSystemAccess& access, PenguinSystem system);
+
+		/// @brief Adds a system that calls a function for every entity that has a set of components.
+		///
+		/// The function is called as func(delta_time, components...). Const component types
+		/// are declared as read, the others as written (e.g., add_each_system<Position, const
+		/// Velocity>()).
+		///
+		/// @param name: The name of the system.
+		/// @param func: The function to call.
+		/// @return The index of the system.
+		template <typename... Ts, typename Func>
+		size_t add_each_system(const std::string& name, Func func);
+
+		/// @brief Runs every system once, waits for them, and flushes the world's command buffer.
+		/// @param delta_time: The delta time passed to each system.
+		/// @throws The first exception thrown by a system. Systems that had not started by then are skipped.
+		void run(double delta_time);
+
+		/// @brief Records each system run as a zone named after the system.
+		/// @param profiler: The profiler to record in, or nullptr to stop recording.
+		void set_profiler(PenguinProfiler* profiler);
+
+		/// @brief Gets the number of systems.
+		/// @return The number of systems.
+		size_t get_system_count() const;
+
+		/// @brief Gets the timings and schedule of every system.
+		/// @return One entry per system, in the order they were added.
+		std::vector<PenguinSystemStats> get_system_stats() const;
+
+		/// @brief Resets the timings of every system.
+		void reset_stats();
+
+		/// @brief Writes the schedule: each stage's systems, their access and dependencies, and their timings.
+		/// @param out: The stream to write to.
+		void write_schedule(std::ostream& out) const;
+
+	private:
+		/// @brief A system and its place in the schedule.
+		struct SystemNode {
+			std::string name; /// The name of the system.
+			const char* zone_name; /// The name of the system's profiler zone, which lives as long as the program.
+			PenguinSystemAccess access; /// The component types the system reads and writes.
+			PenguinSystem system; /// The function run each tick.
+			std::vector<size_t> dependencies; /// The earlier systems it conflicts with.
+			std::vector<size_t> dependents; /// The later systems that conflict with it.
+			size_t stage = 0; /// The length of the longest chain of dependencies.
+			std::atomic<size_t> remaining_dependencies{ 0 }; /// The dependencies yet to finish this tick.
+			PenguinSystemStats stats; /// The timings of the system.
+		};
+
+		PenguinWorld& world; /// The world the systems run on.
+		PenguinJobSystem& job_system; /// The job system that runs the systems.
+		PenguinProfiler* profiler = nullptr; /// The profiler system runs are recorded in, or nullptr.
+		std::vector<std::unique_ptr<SystemNode>> systems; /// The systems, in the order they were added.
+		double last_tick_ms = 0.0; /// The duration of the last tick in milliseconds.
+		std::atomic<bool> failed{ false }; /// Whether a system threw this tick.
+		std::mutex error_mutex; /// Guards error.
+		std::exception_ptr error; /// The first exception thrown by a system this tick.
+
+		void run_system(size_t index, double delta_time, PenguinJobCounter& counter);
+		static std::string describe_mask(PenguinComponentMask mask);
+	};
+
+	/// @brief Adds a system that calls a function for every entity that has a set of components.
+	/// @param name: The name of the system.
+	/// @param func: The function to call.
+	/// @return The index of the system.
+	template <typename... Ts, typename Func>
+	size_t PenguinSystemScheduler::add_each_system(const std::string& name, Func func) {
+		return add_system(name, PenguinSystemAccess::of<Ts...>(), [func = std::move(func)](PenguinWorld& world, double delta_time) mutable {
+			world.each<Ts...>([&func, delta_time](Ts&... components) { func(delta_time, components...); });
+		});
+	}
+}
+
+#endif // PENGUIN_SYSTEM_SCHEDULER_HPP
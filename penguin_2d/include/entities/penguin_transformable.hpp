@@ -2,12 +2,12 @@
 #define PENGUIN_TRANSFORMABLE_HPP
 
 #include "penguin_entity.hpp"
-#include "vect2.hpp"
+#include "vector2.hpp"
 
 namespace Penguin2D {
 	class PenguinTransformable : public PenguinEntity {
 	public:
-		virtual PenguinTransformable(float x = 0.0f, float y = 0.0f, float rot = 0.0f) 
+		PenguinTransformable(float x = 0.0f, float y = 0.0f, float rot = 0.0f) 
         : position(Vector2<float>(x, y)), rotation(rot) {}
 
         virtual void init() override {}
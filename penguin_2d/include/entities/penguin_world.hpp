@@ -0,0 +1,405 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_world.hpp                                                ///
+///                                                                             ///
+/// Defines the PenguinWorld class, an archetype-based entity component system. ///
+///                                                                             ///
+/// Entities are generational ids, and components are plain data types. Every   ///
+/// entity with the same set of component types lives in the same archetype,    ///
+/// which stores each component type as contiguous arrays in chunks. Queries    ///
+/// such as each<Position, const Velocity>() walk those arrays linearly.        ///
+///                                                                             ///
+/// Adding or removing components and entities moves data between archetypes,   ///
+/// so it is not allowed while a query runs. Record such changes in the         ///
+/// world's PenguinCommandBuffer instead, and apply them with flush_commands(). ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_WORLD_HPP
+#define PENGUIN_WORLD_HPP
+
+// Penguin2D related include files
+#include "penguin_component.hpp"
+#include "penguin_archetype.hpp"
+#include "exception.hpp"
+
+// C++ library files
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Penguin2D {
+
+	class PenguinWorld;
+
+	/// @brief A recorded structural change, a callable taking a PenguinWorld&.
+	///
+	/// Unlike std::function, it only requires the callable to be movable, so commands can
+	/// hold move-only components until they are applied.
+	class PenguinCommand {
+	public:
+		/// @brief Constructs a command from a callable.
+		/// @param function: The callable, called with the world the command is applied to.
+		template<typename Function,
+			typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, PenguinCommand>>>
+		PenguinCommand(Function function)
+			: callable(new Function(std::move(function)), [](void* p_callable) { delete static_cast<Function*>(p_callable); }),
+			invoke([](void* p_callable, PenguinWorld& p_world) { (*static_cast<Function*>(p_callable))(p_world); }) {
+
+			static_assert(std::is_invocable_v<Function&, PenguinWorld&>, "A command must be callable with a PenguinWorld&.");
+		}
+
+		/// @brief Applies the command.
+		/// @param world: The world to change.
+		inline void operator()(PenguinWorld& world) { invoke(callable.get(), world); }
+
+	private:
+		std::unique_ptr<void, void(*)(void*)> callable; /// The callable.
+		void (*invoke)(void*, PenguinWorld&); /// Calls the callable.
+	};
+
+	/// @brief Records structural changes to a PenguinWorld so they can be applied later.
+	///
+	/// Commands may be recorded from several threads at once, and are applied in the order
+	/// they were recorded. Commands for an entity that no longer exists when they are
+	/// applied are skipped.
+	class PenguinCommandBuffer {
+	public:
+		PenguinCommandBuffer() = default;
+		~PenguinCommandBuffer() = default;
+
+		PenguinCommandBuffer(const PenguinCommandBuffer&) = delete;
+		PenguinCommandBuffer& operator=(const PenguinCommandBuffer&) = delete;
+
+		/// @brief Records the creation of an entity with a set of components.
+		/// @param components: The components of the entity.
+		template <typename... Ts>
+		void create(Ts&&... components);
+
+		/// @brief Records the destruction of an entity.
+		/// @param entity: The entity to destroy.
+		void destroy(PenguinEntityId entity);
+
+		/// @brief Records adding (or replacing) a component of an entity.
+		/// @param entity: The entity.
+		/// @param component: The component.
+		template <typename T>
+		void add(PenguinEntityId entity, T&& component);
+
+		/// @brief Records removing a component from an entity.
+		/// @tparam T: The component type.
+		/// @param entity: The entity.
+		template <typename T>
+		void remove(PenguinEntityId entity);
+
+		/// @brief Gets the number of recorded commands.
+		/// @return The number of commands waiting to be applied.
+		size_t get_command_count() const;
+
+		/// @brief Applies every recorded command to a world, in order, and clears the buffer.
+		///
+		/// If a command throws, the buffer is still cleared: the commands after it are dropped and
+		/// the exception is rethrown.
+		///
+		/// @param world: The world to change.
+		void apply(PenguinWorld& world);
+
+	private:
+		void push(PenguinCommand command);
+
+		mutable std::mutex mutex; /// Guards commands.
+		std::vector<PenguinCommand> commands; /// The recorded commands.
+	};
+
+	/// @brief Owns entities and their components, stored by archetype.
+	class PenguinWorld {
+	public:
+		PenguinWorld() = default;
+		~PenguinWorld() = default;
+
+		PenguinWorld(const PenguinWorld&) = delete;
+		PenguinWorld& operator=(const PenguinWorld&) = delete;
+
+		/// @brief Creates an entity with no components.
+		/// @return The id of the entity.
+		PenguinEntityId create();
+
+		/// @brief Creates an entity with a set of components, placed straight into its archetype.
+		/// @param components: The components of the entity. Each component type may appear once.
+		/// @return The id of the entity.
+		template <typename... Ts>
+		PenguinEntityId create(Ts&&... components);
+
+		/// @brief Destroys an entity and its components.
+		/// @param entity: The entity to destroy.
+		void destroy(PenguinEntityId entity);
+
+		/// @brief Checks if an entity exists.
+		/// @param entity: The entity.
+		/// @return True if the entity exists, otherwise false.
+		bool is_alive(PenguinEntityId entity) const;
+
+		/// @brief Adds a component to an entity, or replaces it if the entity already has one.
+		/// @param entity: The entity.
+		/// @param component: The component.
+		template <typename T>
+		void add(PenguinEntityId entity, T&& component);
+
+		/// @brief Removes a component from an entity, if it has one.
+		/// @tparam T: The component type.
+		/// @param entity: The entity.
+		template <typename T>
+		void remove(PenguinEntityId entity);
+
+		/// @brief Gets a component of an entity.
+		/// @tparam T: The component type.
+		/// @param entity: The entity.
+		/// @return The component, or nullptr if the entity does not have one. Invalidated by structural changes.
+		template <typename T>
+		T* get(PenguinEntityId entity);
+
+		/// @brief Checks if an entity has a component.
+		/// @tparam T: The component type.
+		/// @param entity: The entity.
+		/// @return True if the entity has the component, otherwise false.
+		template <typename T>
+		bool has(PenguinEntityId entity) const;
+
+		/// @brief Calls a function for every entity that has a set of components.
+		///
+		/// The function is called as func(components...) or func(entity, components...), with a
+		/// reference to each component. Declare read-only components as const (e.g.,
+		/// each<Position, const Velocity>()).
+		///
+		/// @param func: The function to call.
+		template <typename... Ts, typename Func>
+		void each(Func&& func);
+
+		/// @brief Calls a function for every chunk of entities that have a set of components.
+		///
+		/// The function is called as func(count, entities, arrays...), with a pointer to the
+		/// first of count elements of each component array, for loops over plain arrays.
+		///
+		/// @param func: The function to call.
+		template <typename... Ts, typename Func>
+		void each_chunk(Func&& func);
+
+		/// @brief Gets the buffer that records structural changes to apply later.
+		/// @return The world's command buffer.
+		PenguinCommandBuffer& get_commands();
+
+		/// @brief Applies the commands recorded in the world's command buffer.
+		void flush_commands();
+
+		/// @brief Gets the number of entities.
+		/// @return The number of entities in the world.
+		size_t get_entity_count() const;
+
+		/// @brief Gets the number of archetypes.
+		/// @return The number of distinct sets of component types in use, or used before.
+		size_t get_archetype_count() const;
+
+		/// @brief Gets every archetype that has a set of component types.
+		/// @param mask: The component types.
+		/// @return The matching archetypes, in creation order.
+		const std::vector<PenguinArchetype*>& get_matching_archetypes(PenguinComponentMask mask);
+
+	private:
+		/// @brief Where an entity is stored.
+		struct EntityRecord {
+			PenguinArchetype* archetype = nullptr; /// The archetype of the entity, or nullptr if the record is free.
+			size_t row = 0; /// The row of the entity in its archetype.
+			uint32_t generation = 0; /// The generation of the record.
+		};
+
+		/// @brief The archetypes that match a query, extended as archetypes are created.
+		struct QueryCache {
+			std::vector<PenguinArchetype*> archetypes; /// The matching archetypes.
+			size_t archetypes_checked = 0; /// The number of the world's archetypes already checked.
+		};
+
+		/// @brief Marks the world as being iterated for as long as it lives.
+		struct IterationScope {
+			std::atomic<int>& depth;
+			explicit IterationScope(std::atomic<int>& depth) : depth(depth) { depth.fetch_add(1, std::memory_order_relaxed); }
+			~IterationScope() { depth.fetch_sub(1, std::memory_order_relaxed); }
+		};
+
+		std::vector<EntityRecord> records; /// The record of each entity index.
+		std::vector<uint32_t> free_indices; /// Entity indices free for reuse.
+		size_t entity_count = 0; /// The number of entities.
+		std::vector<std::unique_ptr<PenguinArchetype>> archetypes; /// Every archetype, in creation order.
+		std::unordered_map<PenguinComponentMask, PenguinArchetype*> archetypes_by_mask; /// Every archetype, by component types.
+		std::unordered_map<PenguinComponentMask, QueryCache> queries; /// The matching archetypes of each query.
+		std::mutex query_mutex; /// Guards queries, so that queries may run on several threads.
+		std::atomic<int> iteration_depth{ 0 }; /// The number of queries running.
+		PenguinCommandBuffer commands; /// Structural changes recorded for later.
+
+		PenguinEntityId allocate_entity(PenguinArchetype* archetype);
+		PenguinArchetype* get_archetype(PenguinComponentMask mask);
+		void move_entity(EntityRecord& record, PenguinArchetype* target);
+		EntityRecord& get_record(PenguinEntityId entity);
+		const EntityRecord& get_record(PenguinEntityId entity) const;
+		void check_structural_change() const;
+
+		template <typename... Ts, typename Func, size_t... Is>
+		static void call_chunk(Func& func, PenguinArchetype& archetype, size_t chunk, const std::array<int, sizeof...(Ts)>& columns, std::index_sequence<Is...>);
+	};
+
+	/// @brief Creates an entity with a set of components, placed straight into its archetype.
+	/// @param components: The components of the entity.
+	/// @return The id of the entity.
+	template <typename... Ts>
+	PenguinEntityId PenguinWorld::create(Ts&&... components) {
+		check_structural_change();
+		PenguinComponentMask mask = PenguinComponentRegistry::get_mask<std::decay_t<Ts>...>();
+		Exception::throw_if(std::popcount(mask) != (int)sizeof...(Ts), "An entity cannot be created with the same component type twice.", RUNTIME_ERROR);
+
+		// Build the components before the entity exists, so a throwing copy leaves the world unchanged.
+		std::tuple<std::decay_t<Ts>...> values(std::forward<Ts>(components)...);
+
+		PenguinArchetype* archetype = get_archetype(mask);
+		PenguinEntityId entity = allocate_entity(archetype);
+		size_t row = records[entity.index].row;
+		std::apply([&](auto&... value) {
+			((new (archetype->get_component(row, archetype->get_column(PenguinComponentRegistry::get_id<std::decay_t<decltype(value)>>())))
+				std::decay_t<decltype(value)>(std::move(value))), ...);
+		}, values);
+		return entity;
+	}
+
+	/// @brief Adds a component to an entity, or replaces it if the entity already has one.
+	/// @param entity: The entity.
+	/// @param component: The component.
+	template <typename T>
+	void PenguinWorld::add(PenguinEntityId entity, T&& component) {
+		using Component = std::decay_t<T>;
+		PenguinComponentId id = PenguinComponentRegistry::get_id<Component>();
+		Component value(std::forward<T>(component));
+
+		EntityRecord& record = get_record(entity);
+		int column = record.archetype->get_column(id);
+		if (column >= 0) {
+			*static_cast<Component*>(record.archetype->get_component(record.row, column)) = std::move(value);
+			return;
+		}
+
+		check_structural_change();
+		PenguinArchetype* target = get_archetype(record.archetype->get_mask() | (PenguinComponentMask(1) << id));
+		move_entity(record, target);
+		new (target->get_component(record.row, target->get_column(id))) Component(std::move(value));
+	}
+
+	/// @brief Removes a component from an entity, if it has one.
+	/// @param entity: The entity.
+	template <typename T>
+	void PenguinWorld::remove(PenguinEntityId entity) {
+		PenguinComponentId id = PenguinComponentRegistry::get_id<T>();
+		EntityRecord& record = get_record(entity);
+		if (record.archetype->get_column(id) < 0) {
+			return;
+		}
+
+		check_structural_change();
+		move_entity(record, get_archetype(record.archetype->get_mask() & ~(PenguinComponentMask(1) << id)));
+	}
+
+	/// @brief Gets a component of an entity.
+	/// @param entity: The entity.
+	/// @return The component, or nullptr if the entity does not have one.
+	template <typename T>
+	T* PenguinWorld::get(PenguinEntityId entity) {
+		const EntityRecord& record = get_record(entity);
+		int column = record.archetype->get_column(PenguinComponentRegistry::get_id<T>());
+		return column >= 0 ? static_cast<T*>(record.archetype->get_component(record.row, column)) : nullptr;
+	}
+
+	/// @brief Checks if an entity has a component.
+	/// @param entity: The entity.
+	/// @return True if the entity has the component, otherwise false.
+	template <typename T>
+	bool PenguinWorld::has(PenguinEntityId entity) const {
+		return is_alive(entity) && get_record(entity).archetype->get_column(PenguinComponentRegistry::get_id<T>()) >= 0;
+	}
+
+	/// @brief Calls a function for every entity that has a set of components.
+	/// @param func: The function to call.
+	template <typename... Ts, typename Func>
+	void PenguinWorld::each(Func&& func) {
+		each_chunk<Ts...>([&func](size_t count, const PenguinEntityId* entities, Ts*... arrays) {
+			for (size_t i = 0; i < count; i++) {
+				if constexpr (std::is_invocable_v<Func&, PenguinEntityId, Ts&...>) {
+					func(entities[i], arrays[i]...);
+				}
+				else {
+					func(arrays[i]...);
+				}
+			}
+		});
+	}
+
+	/// @brief Calls a function for every chunk of entities that have a set of components.
+	/// @param func: The function to call.
+	template <typename... Ts, typename Func>
+	void PenguinWorld::each_chunk(Func&& func) {
+		IterationScope scope(iteration_depth);
+		for (PenguinArchetype* archetype : get_matching_archetypes(PenguinComponentRegistry::get_mask<Ts...>())) {
+			std::array<int, sizeof...(Ts)> columns = { archetype->get_column(PenguinComponentRegistry::get_id<Ts>())... };
+			for (size_t chunk = 0; chunk < archetype->get_chunk_count(); chunk++) {
+				call_chunk<Ts...>(func, *archetype, chunk, columns, std::index_sequence_for<Ts...>{});
+			}
+		}
+	}
+
+	/// @brief Calls a chunk function with the chunk's arrays of a set of components.
+	template <typename... Ts, typename Func, size_t... Is>
+	void PenguinWorld::call_chunk(Func& func, PenguinArchetype& archetype, size_t chunk, const std::array<int, sizeof...(Ts)>& columns, std::index_sequence<Is...>) {
+		func(archetype.get_chunk_size(chunk), const_cast<const PenguinEntityId*>(archetype.get_entities(chunk)),
+			static_cast<Ts*>(archetype.get_column_data(chunk, columns[Is]))...);
+	}
+
+	/// @brief Records the creation of an entity with a set of components.
+	///
+	/// The components are moved (or copied) into the command, so move-only components can be recorded.
+	///
+	/// @param components: The components of the entity.
+	template <typename... Ts>
+	void PenguinCommandBuffer::create(Ts&&... components) {
+		push([values = std::tuple<std::decay_t<Ts>...>(std::forward<Ts>(components)...)](PenguinWorld& world) mutable {
+			std::apply([&world](auto&... value) { world.create(std::move(value)...); }, values);
+		});
+	}
+
+	/// @brief Records adding (or replacing) a component of an entity.
+	///
+	/// The component is moved (or copied) into the command, so move-only components can be recorded.
+	///
+	/// @param entity: The entity.
+	/// @param component: The component.
+	template <typename T>
+	void PenguinCommandBuffer::add(PenguinEntityId entity, T&& component) {
+		push([entity, value = std::decay_t<T>(std::forward<T>(component))](PenguinWorld& world) mutable {
+			if (world.is_alive(entity)) {
+				world.add(entity, std::move(value));
+			}
+		});
+	}
+
+	/// @brief Records removing a component from an entity.
+	/// @param entity: The entity.
+	template <typename T>
+	void PenguinCommandBuffer::remove(PenguinEntityId entity) {
+		push([entity](PenguinWorld& world) {
+			if (world.is_alive(entity)) {
+				world.template remove<T>(entity);
+			}
+		});
+	}
+}
+
+#endif // PENGUIN_WORLD_HPP
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_aabb_tree.hpp                                            ///
+///                                                                             ///
+/// Defines the PenguinAABBTree class, a dynamic bounding volume hierarchy      ///
+/// over Rect2<float> bounds that copes with colliders of very different sizes. ///
+///                                                                             ///
+/// Each collider is a leaf with fattened bounds: its bounds grown by a margin  ///
+/// and by its predicted displacement. Moving a collider within its fattened    ///
+/// bounds costs nothing; leaving them reinserts the leaf and rebalances the    ///
+/// tree with rotations. Static colliders are not fattened, and a level can be  ///
+/// loaded in bulk with build(), which splits the colliders by the surface area ///
+/// heuristic (SAH) for a tree that is cheaper to query than one built by       ///
+/// inserting colliders one at a time.                                          ///
+///                                                                             ///
+/// Bounds overlap when they share any point, including an edge, as in          ///
+/// Rect2::has_intersection(). Bounds with a negative size overlap nothing.     ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_AABB_TREE_HPP
+#define PENGUIN_AABB_TREE_HPP
+
+// Penguin2D related include files
+#include "rect2.hpp"
+#include "penguin_spatial_hash.hpp"
+
+// C++ library files
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief The first collider hit by a ray cast or a swept box.
+	struct PenguinRayHit {
+		PenguinColliderId id = 0; /// The collider that was hit.
+		float fraction = 1.0f; /// How far along the ray or sweep the hit happened (0 to 1).
+		Vector2<float> point; /// The point hit by a ray, or the position of a swept box when it hits.
+		Vector2<float> normal; /// The normal of the face that was hit, or (0, 0) if the ray or box started inside the collider.
+	};
+
+	/// @brief A dynamic AABB tree broadphase over Rect2<float> bounds.
+	class PenguinAABBTree {
+	public:
+		/// @brief Constructs an empty PenguinAABBTree.
+		/// @param margin: How far the bounds of a dynamic collider are fattened on each side (optional, defaults to 4).
+		explicit PenguinAABBTree(float margin = 4.0f);
+		~PenguinAABBTree() = default;
+
+		/// @brief Adds a collider.
+		/// @param id: The id of the collider. It must not already be in the tree.
+		/// @param bounds: The bounds of the collider.
+		/// @param is_static: True if the collider never moves, so its bounds are not fattened (optional, defaults to false).
+		void insert(PenguinColliderId id, const Rect2<float>& bounds, bool is_static = false);
+
+		/// @brief Updates the bounds of a collider.
+		/// @param id: The id of the collider.
+		/// @param bounds: The new bounds of the collider.
+		/// @param displacement: The expected movement before the next update, used to fatten the bounds ahead of it (optional).
+		/// @return True if the collider left its fattened bounds and was reinserted, otherwise false.
+		bool move(PenguinColliderId id, const Rect2<float>& bounds, Vector2<float> displacement = Vector2<float>());
+
+		/// @brief Removes a collider.
+		/// @param id: The id of the collider.
+		void remove(PenguinColliderId id);
+
+		/// @brief Checks if a collider is in the tree.
+		/// @param id: The id of the collider.
+		/// @return True if the collider is in the tree, otherwise false.
+		bool contains(PenguinColliderId id) const;
+
+		/// @brief Gets the bounds of a collider.
+		/// @param id: The id of the collider.
+		/// @return The bounds of the collider.
+		const Rect2<float>& get_bounds(PenguinColliderId id) const;
+
+		/// @brief Gets the fattened bounds of a collider, within which it can move without a reinsert.
+		/// @param id: The id of the collider.
+		/// @return The fattened bounds of the collider.
+		Rect2<float> get_fat_bounds(PenguinColliderId id) const;
+
+		/// @brief Removes every collider.
+		void clear();
+
+		/// @brief Replaces every collider and builds the tree with the surface area heuristic (e.g., on level load).
+		/// @param colliders: The id and bounds of each collider.
+		/// @param is_static: True if the colliders never move (optional, defaults to true).
+		void build(const std::vector<std::pair<PenguinColliderId, Rect2<float>>>& colliders, bool is_static = true);
+
+		/// @brief Rebuilds the tree over its current colliders with the surface area heuristic.
+		void rebuild();
+
+		/// @brief Gets the number of colliders.
+		/// @return The number of colliders.
+		inline size_t get_count() const { return leaf_count; }
+
+		/// @brief Gets the height of the tree.
+		/// @return The number of levels below the root, or -1 if the tree is empty.
+		int get_height() const;
+
+		/// @brief Gets the quality of the tree: the summed perimeter of every node over the root's perimeter.
+		/// @return The ratio, lower is better (0 if the tree is empty).
+		float get_perimeter_ratio() const;
+
+		/// @brief Finds every pair of colliders whose bounds overlap. Pairs of two static colliders are skipped.
+		/// @param pairs: Cleared, then filled with each overlapping pair once, in no particular order.
+		void query_pairs(std::vector<PenguinColliderPair>& pairs) const;
+
+		/// @brief Finds every collider whose bounds overlap an area.
+		/// @param area: The area to search.
+		/// @param results: Cleared, then filled with each overlapping collider once.
+		void query_rect(const Rect2<float>& area, std::vector<PenguinColliderId>& results) const;
+
+		/// @brief Finds every collider whose bounds contain a point, edges included.
+		/// @param point: The point to search.
+		/// @param results: Cleared, then filled with each collider containing the point.
+		void query_point(Vector2<float> point, std::vector<PenguinColliderId>& results) const;
+
+		/// @brief Finds the first collider hit by a line segment.
+		/// @param start: The start of the segment.
+		/// @param end: The end of the segment.
+		/// @param hit: Set to the first hit, if any.
+		/// @return True if a collider was hit, otherwise false.
+		bool ray_cast(Vector2<float> start, Vector2<float> end, PenguinRayHit& hit) const;
+
+		/// @brief Finds the first collider hit by a box moving in a straight line.
+		/// @param box: The box at the start of its movement.
+		/// @param displacement: The movement of the box.
+		/// @param hit: Set to the first hit, if any. The hit point is the box's position when it hits.
+		/// @return True if a collider was hit, otherwise false.
+		bool sweep(const Rect2<float>& box, Vector2<float> displacement, PenguinRayHit& hit) const;
+
+	private:
+		/// @brief An axis-aligned box stored by its corners.
+		struct Bounds {
+			float min_x = 0.0f;
+			float min_y = 0.0f;
+			float max_x = 0.0f;
+			float max_y = 0.0f;
+
+			inline float get_perimeter() const { return 2.0f * ((max_x - min_x) + (max_y - min_y)); }
+			inline bool contains(const Bounds& other) const {
+				return min_x <= other.min_x && min_y <= other.min_y && other.max_x <= max_x && other.max_y <= max_y;
+			}
+			inline bool overlaps(const Bounds& other) const {
+				return min_x <= other.max_x && other.min_x <= max_x && min_y <= other.max_y && other.min_y <= max_y;
+			}
+			static inline Bounds combine(const Bounds& a, const Bounds& b) {
+				return Bounds{ a.min_x < b.min_x ? a.min_x : b.min_x, a.min_y < b.min_y ? a.min_y : b.min_y,
+					a.max_x > b.max_x ? a.max_x : b.max_x, a.max_y > b.max_y ? a.max_y : b.max_y };
+			}
+		};
+
+		/// @brief A node of the tree: a leaf holding a collider, or a branch with two children.
+		struct Node {
+			Bounds fat_bounds; /// The fattened bounds of a leaf, or the union of a branch's children.
+			Rect2<float> bounds{ 0.0f, 0.0f }; /// The bounds of a leaf's collider.
+			int32_t parent = NULL_NODE; /// The parent node, or the next free node while the node is unused.
+			int32_t child1 = NULL_NODE; /// The first child of a branch.
+			int32_t child2 = NULL_NODE; /// The second child of a branch.
+			int32_t height = 0; /// 0 for a leaf, otherwise one more than the taller child, or -1 while unused.
+			PenguinColliderId id = 0; /// The collider of a leaf.
+			bool is_static = false; /// Whether a leaf's collider never moves.
+
+			inline bool is_leaf() const { return child1 == NULL_NODE; }
+		};
+
+		static constexpr int32_t NULL_NODE = -1; /// Marks the absence of a node.
+		static constexpr int32_t MAX_SAH_DEPTH = 64; /// Below this depth, build() splits at the median to bound recursion.
+
+		float margin; /// How far the bounds of a dynamic collider are fattened on each side.
+		std::vector<Node> nodes; /// Every node, used or free.
+		int32_t root = NULL_NODE; /// The root node, or NULL_NODE if the tree is empty.
+		int32_t free_list = NULL_NODE; /// The first free node, or NULL_NODE if none are free.
+		std::vector<int32_t> leaves; /// The leaf of each id, or NULL_NODE.
+		size_t leaf_count = 0; /// The number of colliders.
+
+		int32_t allocate_node();
+		void free_node(int32_t node);
+		void insert_leaf(int32_t leaf);
+		void remove_leaf(int32_t leaf);
+		int32_t balance(int32_t node);
+		int32_t build_range(int32_t* first, size_t count, int32_t depth);
+		int32_t get_leaf(PenguinColliderId id) const;
+		Bounds get_fat_bounds(const Rect2<float>& bounds, Vector2<float> displacement, bool is_static) const;
+		bool cast(Vector2<float> start, Vector2<float> delta, Vector2<float> extent, PenguinRayHit& hit) const;
+
+		static Bounds to_bounds(const Rect2<float>& rect);
+		static bool intersect_segment(const Bounds& bounds, Vector2<float> start, Vector2<float> delta, float max_fraction, float& fraction, Vector2<float>& normal);
+	};
+}
+
+#endif // PENGUIN_AABB_TREE_HPP
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_spatial_hash.hpp                                         ///
+///                                                                             ///
+/// Defines the PenguinSpatialHash class, a uniform grid broadphase that finds  ///
+/// which Rect2<float> bounds overlap without testing every pair.               ///
+///                                                                             ///
+/// Each collider is listed in every grid cell its bounds touch, and only the   ///
+/// colliders sharing a cell are tested against each other. Cells are stored    ///
+/// in a hash map, so the grid has no fixed extent. The cell size should be     ///
+/// close to the size of a typical collider: much smaller and colliders span    ///
+/// many cells, much larger and cells hold many colliders.                      ///
+///                                                                             ///
+/// Bounds overlap when they share any point, including an edge, as in          ///
+/// Rect2::has_intersection(). Bounds with a negative size overlap nothing.     ///
+///                                                                             ///
+/// A collider spanning more than MAX_COLLIDER_CELLS cells (e.g., a level-wide  ///
+/// trigger, or bounds gone infinite) is kept in an overflow list instead,      ///
+/// which every query tests, so one huge collider cannot fill the grid.         ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_SPATIAL_HASH_HPP
+#define PENGUIN_SPATIAL_HASH_HPP
+
+// Penguin2D related include files
+#include "rect2.hpp"
+
+// C++ library files
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief Identifies a collider in a broadphase. Chosen by the caller (e.g., an entity index).
+	using PenguinColliderId = uint32_t;
+
+	/// @brief A pair of colliders whose bounds overlap.
+	using PenguinColliderPair = std::pair<PenguinColliderId, PenguinColliderId>;
+
+	/// @brief How colliders are spread over the cells of a PenguinSpatialHash.
+	struct PenguinSpatialHashStats {
+		size_t colliders = 0; /// The number of colliders.
+		size_t cells = 0; /// The number of cells that hold at least one collider.
+		size_t entries = 0; /// The number of (cell, collider) entries.
+		size_t overflow_colliders = 0; /// The number of colliders too large to list in cells, tested by every query.
+		size_t max_cell_colliders = 0; /// The number of colliders in the fullest cell.
+		double mean_cell_colliders = 0.0; /// The mean number of colliders in a cell.
+	};
+
+	/// @brief A uniform grid broadphase over Rect2<float> bounds.
+	class PenguinSpatialHash {
+	public:
+		static constexpr int64_t MAX_COLLIDER_CELLS = 256; /// The most cells a collider is listed in. Larger colliders go to the overflow list.
+
+		/// @brief Constructs an empty PenguinSpatialHash.
+		/// @param cell_size: The width and height of a grid cell (optional, defaults to 64).
+		explicit PenguinSpatialHash(float cell_size = 64.0f);
+		~PenguinSpatialHash() = default;
+
+		/// @brief Adds a collider.
+		/// @param id: The id of the collider. It must not already be in the hash.
+		/// @param bounds: The bounds of the collider.
+		void insert(PenguinColliderId id, const Rect2<float>& bounds);
+
+		/// @brief Updates the bounds of a collider. Only the cells it enters or leaves are changed.
+		/// @param id: The id of the collider.
+		/// @param bounds: The new bounds of the collider.
+		void move(PenguinColliderId id, const Rect2<float>& bounds);
+
+		/// @brief Removes a collider.
+		/// @param id: The id of the collider.
+		void remove(PenguinColliderId id);
+
+		/// @brief Checks if a collider is in the hash.
+		/// @param id: The id of the collider.
+		/// @return True if the collider is in the hash, otherwise false.
+		bool contains(PenguinColliderId id) const;
+
+		/// @brief Gets the bounds of a collider.
+		/// @param id: The id of the collider.
+		/// @return The bounds of the collider.
+		const Rect2<float>& get_bounds(PenguinColliderId id) const;
+
+		/// @brief Removes every collider.
+		void clear();
+
+		/// @brief Changes the cell size and re-indexes every collider.
+		/// @param cell_size: The width and height of a grid cell.
+		void set_cell_size(float cell_size);
+
+		/// @brief Gets the cell size.
+		/// @return The width and height of a grid cell.
+		inline float get_cell_size() const { return cell_size; }
+
+		/// @brief Gets the number of colliders.
+		/// @return The number of colliders.
+		inline size_t get_count() const { return colliders.size(); }
+
+		/// @brief Finds every pair of colliders whose bounds overlap.
+		/// @param pairs: Cleared, then filled with each overlapping pair once, in no particular order.
+		void query_pairs(std::vector<PenguinColliderPair>& pairs) const;
+
+		/// @brief Finds every collider whose bounds overlap an area.
+		/// @param area: The area to search.
+		/// @param results: Cleared, then filled with each overlapping collider once.
+		void query_rect(const Rect2<float>& area, std::vector<PenguinColliderId>& results) const;
+
+		/// @brief Finds every collider whose bounds contain a point, edges included.
+		/// @param point: The point to search.
+		/// @param results: Cleared, then filled with each collider containing the point.
+		void query_point(Vector2<float> point, std::vector<PenguinColliderId>& results) const;
+
+		/// @brief Gets how colliders are spread over the cells, to help choose a cell size.
+		/// @return The statistics of the hash.
+		PenguinSpatialHashStats get_stats() const;
+
+	private:
+		/// @brief An inclusive range of cells. Empty when min_x > max_x.
+		struct CellRange {
+			int32_t min_x = 1;
+			int32_t min_y = 1;
+			int32_t max_x = 0;
+			int32_t max_y = 0;
+
+			inline bool contains(int32_t x, int32_t y) const { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; }
+			inline bool operator==(const CellRange& other) const = default;
+			inline bool is_too_large() const { return ((int64_t)max_x - min_x + 1) * ((int64_t)max_y - min_y + 1) > MAX_COLLIDER_CELLS; }
+		};
+
+		/// @brief A collider and the cells it is listed in.
+		struct Collider {
+			PenguinColliderId id; /// The id of the collider.
+			Rect2<float> bounds; /// The bounds of the collider.
+			CellRange cells; /// The cells the collider is listed in. Empty if it is in the overflow list.
+			bool overflow; /// Whether the collider spans too many cells, and is in the overflow list instead.
+		};
+
+		/// @brief Mixes the coordinates packed in a cell key, so neighbouring cells spread over buckets.
+		struct CellKeyHash {
+			inline size_t operator()(uint64_t key) const {
+				key ^= key >> 33;
+				key *= 0xff51afd7ed558ccdULL;
+				key ^= key >> 33;
+				return (size_t)key;
+			}
+		};
+
+		static constexpr uint32_t NO_SLOT = UINT32_MAX; /// Marks an id that is not in the hash.
+
+		float cell_size; /// The width and height of a grid cell.
+		float inverse_cell_size; /// One over the cell size.
+		std::vector<Collider> colliders; /// The colliders, densely packed.
+		std::vector<uint32_t> slots; /// The index in colliders of each id, or NO_SLOT.
+		std::unordered_map<uint64_t, std::vector<PenguinColliderId>, CellKeyHash> cells; /// The colliders listed in each non-empty cell.
+		std::vector<std::vector<PenguinColliderId>> spare_cells; /// Emptied cell lists, kept to reuse their memory.
+		std::vector<PenguinColliderId> overflow; /// The colliders spanning more than MAX_COLLIDER_CELLS cells.
+
+		CellRange get_cell_range(const Rect2<float>& bounds) const;
+		void remove_from_overflow(PenguinColliderId id);
+		void add_to_cell(int32_t x, int32_t y, PenguinColliderId id);
+		void remove_from_cell(int32_t x, int32_t y, PenguinColliderId id);
+		uint32_t get_slot(PenguinColliderId id) const;
+
+		static inline uint64_t get_cell_key(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+	};
+}
+
+#endif // PENGUIN_SPATIAL_HASH_HPP
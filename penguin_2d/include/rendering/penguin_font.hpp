@@ -35,6 +35,12 @@ namespace Penguin2D {
         STRIKETHROUGH   = TTF_STYLE_STRIKETHROUGH
     };
 
+    /// @brief The contents of a font file, loaded once and shared by every font opened from it.
+    struct PenguinFontData {
+        std::unique_ptr<void, void(*)(void*)> bytes; /// The file contents, freed with SDL_free.
+        size_t size; /// The size of the file in bytes.
+    };
+
     /// @brief Manages font properties and rendering settings.
     ///
     /// This class provides functions for handling font sizes, outlines, and styles.
@@ -46,9 +52,14 @@ namespace Penguin2D {
         /// @param font_size: The size of the font in pixels.
         PenguinFont(const std::string& font_path, float font_size);
 
+        /// @brief Constructs a PenguinFont from font file contents that are already loaded.
+        /// @param font_data: The contents of the font file, kept alive by the font.
+        /// @param font_size: The size of the font in pixels.
+        PenguinFont(std::shared_ptr<const PenguinFontData> font_data, float font_size);
+
         /// @brief Retrieves the underlying font object.
         /// @return A pointer to the TTF_Font used for rendering.
-        TTF_Font* get_font();
+        TTF_Font* get_font() const;
 
         /// @brief Sets the font size.
         /// @param font_size: The new font size in pixels.
@@ -56,7 +67,7 @@ namespace Penguin2D {
 
         /// @brief Gets the current font size.
         /// @return The font size in pixels.
-        float get_font_size();
+        float get_font_size() const;
 
         /// @brief Sets the font outline size.
         /// @param outline_size: The new outline size in pixels.
@@ -64,7 +75,7 @@ namespace Penguin2D {
 
         /// @brief Gets the current font outline size.
         /// @return The outline size in pixels.
-        int get_font_outline_size();
+        int get_font_outline_size() const;
 
         //////////////////////////////////////////////////////////////////////////////////
         /// UNSAFE FUNCTIONS                                                           ///
@@ -110,6 +121,7 @@ namespace Penguin2D {
         void remove_font_styles(std::initializer_list<PenguinFontStyle> styles);
 
     private:
+        std::shared_ptr<const PenguinFontData> font_data; /// The shared file contents the font reads from (null if opened from a path). Declared first so it outlives the font.
         std::unique_ptr<TTF_Font, void(*)(TTF_Font*)> font;
     };
 }
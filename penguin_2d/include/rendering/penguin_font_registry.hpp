@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_font_registry.hpp                                        ///
+///                                                                             ///
+/// Defines the PenguinFontRegistry class, which shares fonts between every     ///
+/// PenguinText that uses the same font file, size, style, and outline.         ///
+///                                                                             ///
+/// Each font file is read into memory once and shared by all sizes and styles  ///
+/// opened from it, and each combination of settings is opened once.            ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_FONT_REGISTRY_HPP
+#define PENGUIN_FONT_REGISTRY_HPP
+
+// Penguin2D related include files
+#include "penguin_font.hpp"
+#include "exception.hpp"
+
+// SDL related include files
+#include <SDL3_ttf/SDL_ttf.h>
+
+// C++ library files
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Penguin2D {
+
+    /// @brief Identifies a font opened by a PenguinFontRegistry.
+    struct PenguinFontKey {
+        std::string path; /// The canonical path to the font file.
+        float size; /// The size of the font in pixels.
+        TTF_FontStyleFlags style; /// The styles applied to the font.
+        int outline; /// The outline size of the font in pixels.
+
+        inline bool operator==(const PenguinFontKey& other_key) const {
+            return path == other_key.path && size == other_key.size && style == other_key.style && outline == other_key.outline;
+        }
+    };
+
+    /// @brief Hashes a PenguinFontKey for use in the font registry.
+    struct PenguinFontKeyHash {
+        inline size_t operator()(const PenguinFontKey& key) const {
+            size_t hash = std::hash<std::string>{}(key.path);
+            hash ^= std::hash<float>{}(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<uint64_t>{}(((uint64_t)key.style << 32) | (uint32_t)key.outline) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    /// @brief Opens each font once and shares it between its users.
+    ///
+    /// Fonts handed out by the registry are shared, so they are read-only: changing their size,
+    /// style, or outline would affect every user. Request a font with different settings instead.
+    /// Fonts stay open until the registry is destroyed.
+    class PenguinFontRegistry {
+    public:
+        PenguinFontRegistry() = default;
+        ~PenguinFontRegistry() = default;
+
+        /// @brief Retrieves a font, opening it if no font with the same settings is open.
+        /// @param path: The file path to the font.
+        /// @param size: The size of the font in pixels.
+        /// @param style: The styles applied to the font (optional, defaults to NORMAL).
+        /// @param outline: The outline size of the font in pixels (optional, defaults to 0).
+        /// @return A read-only reference to the shared font.
+        const PenguinFont& get_font(const std::string& path, float size, TTF_FontStyleFlags style = TTF_STYLE_NORMAL, int outline = 0);
+
+        /// @brief Gets the number of open fonts.
+        /// @return The number of fonts.
+        size_t get_font_count() const;
+
+        /// @brief Gets the number of font files loaded into memory.
+        /// @return The number of font files.
+        size_t get_file_count() const;
+
+    private:
+        std::unordered_map<std::string, std::shared_ptr<const PenguinFontData>> files; /// The loaded font files, keyed by canonical path.
+        std::unordered_map<PenguinFontKey, std::unique_ptr<PenguinFont>, PenguinFontKeyHash> fonts; /// The open fonts, keyed by their settings.
+
+        std::shared_ptr<const PenguinFontData> load_file(const std::string& path, const std::string& canonical);
+    };
+}
+
+#endif // PENGUIN_FONT_REGISTRY_HPP
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_glyph_atlas.hpp                                          ///
+///                                                                             ///
+/// Defines the PenguinGlyphAtlas class, which rasterizes the glyphs of a font  ///
+/// into textures on demand so text can be drawn as textured quads.             ///
+///                                                                             ///
+/// Each glyph is rendered once, the first time it is requested, and packed     ///
+/// into a page texture with a shelf packer. Text drawn with the atlas shares   ///
+/// its page textures, so a label is usually a single geometry call. Pages are  ///
+/// sized from the font's height, and a glyph too large for a page gets a page  ///
+/// of its own, so fonts of any size can be drawn.                              ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_GLYPH_ATLAS_HPP
+#define PENGUIN_GLYPH_ATLAS_HPP
+
+// Penguin2D related include files
+#include "penguin_renderer.hpp"
+#include "penguin_font.hpp"
+#include "exception.hpp"
+
+// SDL related include files
+#include <SDL3/SDL_render.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+// C++ library files
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief The location and metrics of a glyph in a PenguinGlyphAtlas.
+	struct PenguinGlyph {
+		int page = 0; /// The page the glyph is packed into.
+		SDL_FRect source = { 0.0f, 0.0f, 0.0f, 0.0f }; /// The region of the page covered by the glyph, in pixels (empty for blank glyphs).
+		float advance = 0.0f; /// The distance to move the pen after the glyph, in pixels.
+	};
+
+	/// @brief Rasterizes the glyphs of a single font into shared page textures.
+	///
+	/// The atlas belongs to one font at one size, style, and outline. The font must
+	/// outlive the atlas and must not be modified while the atlas is in use.
+	class PenguinGlyphAtlas {
+	public:
+		/// @brief Constructs an empty PenguinGlyphAtlas.
+		/// @param renderer: The PenguinRenderer used to create the page textures.
+		/// @param font: The font to rasterize glyphs from.
+		/// @param page_size: The width and height of each shared page in pixels (optional, defaults to 0, which sizes pages from the font's height).
+		PenguinGlyphAtlas(PenguinRenderer& renderer, const PenguinFont& font, int page_size = 0);
+		~PenguinGlyphAtlas() = default;
+
+		/// @brief Retrieves a glyph, rasterizing it if it has not been requested before.
+		/// @param codepoint: The Unicode codepoint of the glyph.
+		/// @return The location and metrics of the glyph.
+		const PenguinGlyph& get_glyph(uint32_t codepoint);
+
+		/// @brief Gets the kerning between two glyphs.
+		/// @param previous_codepoint: The codepoint of the glyph before.
+		/// @param codepoint: The codepoint of the glyph after.
+		/// @return The horizontal adjustment in pixels.
+		float get_kerning(uint32_t previous_codepoint, uint32_t codepoint);
+
+		/// @brief Gets the distance between the tops of two lines of text.
+		/// @return The line height in pixels.
+		float get_line_height() const;
+
+		/// @brief Gets the width and height of the pages shared by glyphs.
+		/// @return The page size in pixels.
+		int get_page_size() const;
+
+		/// @brief Gets the width and height of a page, which is larger than get_page_size() for a glyph too large to share a page.
+		/// @param page: The index of the page.
+		/// @return The page size in pixels.
+		int get_page_size(int page) const;
+
+		/// @brief Retrieves the texture of a page.
+		/// @param page: The index of the page.
+		/// @return A pointer to the SDL_Texture of the page.
+		SDL_Texture* get_page(int page) const;
+
+		/// @brief Gets the number of glyphs rasterized so far.
+		/// @return The number of glyphs.
+		size_t get_glyph_count() const;
+
+	private:
+		static constexpr int GLYPH_PADDING = 1; /// Empty space left around each glyph, so filtering does not bleed between glyphs.
+		static constexpr int MIN_PAGE_SIZE = 512; /// The smallest page size chosen from a font's height.
+		static constexpr int MAX_PAGE_SIZE = 4096; /// The largest page size chosen from a font's height.
+		static constexpr int LINES_PER_PAGE = 8; /// The number of font heights a page size chosen from the font fits.
+
+		PenguinRenderer& renderer; /// Reference to the PenguinRenderer used to create the page textures.
+		const PenguinFont& font; /// The font glyphs are rasterized from.
+		int page_size; /// The width and height of each page.
+		float line_height; /// The distance between the tops of two lines of text.
+		std::unordered_map<uint32_t, PenguinGlyph> glyphs; /// The rasterized glyphs, keyed by codepoint.
+		std::vector<std::unique_ptr<SDL_Texture, void(*)(SDL_Texture*)>> pages; /// The page textures.
+		std::vector<int> page_sizes; /// The width and height of each page.
+		int shelf_page = -1; /// The page glyphs are currently packed into (-1 before the first page).
+		int shelf_x = 0; /// The x position of the next glyph on the current shelf.
+		int shelf_y = 0; /// The y position of the current shelf.
+		int shelf_height = 0; /// The height of the tallest glyph on the current shelf.
+
+		PenguinGlyph rasterize(uint32_t codepoint);
+		int add_page(int size);
+		void add_shelf_page();
+		static int get_page_size_for(const PenguinFont& font);
+	};
+}
+
+#endif // PENGUIN_GLYPH_ATLAS_HPP
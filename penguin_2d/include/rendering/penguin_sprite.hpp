@@ -6,6 +6,10 @@
 /// This class loads an image as a texture and provides functions to render it	///
 /// onto the screen. It supports full sprite rendering as well as rendering a	///
 /// clipped region from the texture. It depends on PenguinRenderer for drawing.	///
+///                                                                             ///
+/// A sprite can also be created from an image packed into a					///
+/// PenguinTextureAtlas, in which case it draws a sub-rectangle of the shared	///
+/// atlas page instead of owning its own texture.								///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #ifndef PENGUIN_SPRITE_HPP
@@ -13,6 +17,7 @@
 
 // Penguin2D related include files
 #include "penguin_renderer.hpp"
+#include "penguin_texture_atlas.hpp"
 #include "exception.hpp"
 #include "rect2.hpp"
 
@@ -33,10 +38,16 @@ namespace Penguin2D {
 	/// It also supports drawing specific regions of a sprite.
 	class PenguinSprite {
 	public:
-		/// @brief Constructs a PenguinSprite object.
+		/// @brief Constructs a PenguinSprite object, sharing the texture with other sprites loaded from the same file.
 		/// @param renderer: The PenguinRenderer used for rendering the sprite.
 		/// @param path: The file path to the sprite image.
 		PenguinSprite(PenguinRenderer& renderer, const std::string& path);
+
+		/// @brief Constructs a PenguinSprite from an image packed into a texture atlas.
+		/// @param renderer: The PenguinRenderer used for rendering the sprite.
+		/// @param atlas: The built PenguinTextureAtlas containing the image. It must outlive the sprite.
+		/// @param name: The name of the image in the atlas.
+		PenguinSprite(PenguinRenderer& renderer, const PenguinTextureAtlas& atlas, const std::string& name);
 		~PenguinSprite() = default;
 
 		/// @brief Retrieves the width of the sprite.
@@ -51,18 +62,30 @@ namespace Penguin2D {
 		/// @return A pointer to the SDL_Texture.
 		SDL_Texture* get_sprite_ptr();
 
+		/// @brief Retrieves the region of the texture that the sprite covers.
+		/// @return The sprite's region in its texture, in pixels.
+		Rect2<float> get_source_region() const;
+
+		/// @brief Clips a region of the sprite to the sprite's region of its texture.
+		/// @param clip_region: The region of the sprite, relative to the sprite's top-left corner.
+		/// @param position: The position to draw the region at, trimmed along with the region.
+		/// @param source: Set to the clipped region of the texture, in pixels.
+		/// @return True if any of the region lies within the sprite, otherwise false.
+		bool clip_region(Rect2<float> clip_region, Rect2<float>& position, Rect2<float>& source) const;
+
 		/// @brief Draws the sprite at a specified position.
 		/// @param position: The position to render the sprite at.
 		void draw_sprite(Rect2<float> position);
 
-		/// @brief Draws a specific region of the sprite.
+		/// @brief Draws a specific region of the sprite. Parts of the region outside the sprite are not drawn.
 		/// @param clip_region: The region of the sprite to be drawn.
 		/// @param position: The position to render the clipped sprite region at.
 		void draw_sprite_region(Rect2<float> clip_region, Rect2<float> position);
 
 	private:
 		PenguinRenderer& renderer; /// Reference to the PenguinRenderer used for drawing the sprite.
-		std::unique_ptr < SDL_Texture, void(*)(SDL_Texture*)> sprite;
+		std::shared_ptr<SDL_Texture> sprite; /// The sprite's texture, shared through the renderer's texture cache or owned by an atlas.
+		SDL_FRect source_region; /// The region of the texture covered by the sprite (the whole texture unless from an atlas).
 
 	};
 }
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_sprite_batch.hpp                                         ///
+///                                                                             ///
+/// Defines the PenguinSpriteBatch class, which collects sprite draws and       ///
+/// submits them as a few large textured geometry calls.                        ///
+///                                                                             ///
+/// Sprites drawn between begin() and end() are stored as quads, sorted by      ///
+/// layer and texture, and each run of quads sharing a texture is drawn with a  ///
+/// single SDL_RenderGeometry call using an indexed quad buffer.                ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_SPRITE_BATCH_HPP
+#define PENGUIN_SPRITE_BATCH_HPP
+
+// Penguin2D related include files
+#include "penguin_renderer.hpp"
+#include "penguin_sprite.hpp"
+#include "scratch_buffer.hpp"
+#include "colour.hpp"
+#include "rect2.hpp"
+
+// SDL related include files
+#include <SDL3/SDL_render.h>
+
+// C++ library files
+#include <cstdint>
+
+namespace Penguin2D {
+
+	/// @brief A single sprite draw recorded by a PenguinSpriteBatch.
+	struct PenguinSpriteQuad {
+		SDL_Texture* texture; /// The texture to draw from.
+		SDL_FRect source; /// The region of the texture to draw, in pixels.
+		SDL_FRect destination; /// The position and size to draw the region at.
+		SDL_FColor colour; /// The normalized colour the texture is modulated by.
+		float rotation; /// The clockwise rotation around the centre of the destination, in degrees.
+		int layer; /// The layer of the quad, lower layers are drawn first.
+		uint32_t order; /// The order the quad was drawn in, used to keep draw order within a texture.
+	};
+
+	/// @brief Collects sprite draws and submits them as one geometry call per texture.
+	///
+	/// Quads are drawn in order of their layer. Within a layer, quads are grouped by texture,
+	/// so overlapping sprites from different textures in the same layer may be drawn in a
+	/// different order than they were submitted. Sprites from a PenguinTextureAtlas share a
+	/// texture, so a layer of atlas sprites is usually a single draw call.
+	class PenguinSpriteBatch {
+	public:
+		/// @brief Constructs a PenguinSpriteBatch.
+		/// @param renderer: The PenguinRenderer the batch draws onto.
+		explicit PenguinSpriteBatch(PenguinRenderer& renderer);
+		~PenguinSpriteBatch() = default;
+
+		/// @brief Starts a new batch, discarding any quads that were not submitted.
+		void begin();
+
+		/// @brief Adds a sprite to the batch.
+		/// @param sprite: The sprite to draw.
+		/// @param position: The position and size to draw the sprite at.
+		/// @param rotation: The clockwise rotation around the centre of the sprite, in degrees (optional, defaults to 0).
+		/// @param colour: The colour to modulate the sprite by (optional, defaults to WHITE).
+		/// @param layer: The layer of the sprite, lower layers are drawn first (optional, defaults to 0).
+		void draw(PenguinSprite& sprite, Rect2<float> position, float rotation = 0.0f, Colour colour = Colours::WHITE, int layer = 0);
+
+		/// @brief Adds a region of a sprite to the batch.
+		/// @param sprite: The sprite to draw.
+		/// @param clip_region: The region of the sprite to draw, relative to the sprite's top-left corner.
+		/// @param position: The position and size to draw the region at.
+		/// @param rotation: The clockwise rotation around the centre of the region, in degrees (optional, defaults to 0).
+		/// @param colour: The colour to modulate the region by (optional, defaults to WHITE).
+		/// @param layer: The layer of the region, lower layers are drawn first (optional, defaults to 0).
+		void draw_region(PenguinSprite& sprite, Rect2<float> clip_region, Rect2<float> position, float rotation = 0.0f, Colour colour = Colours::WHITE, int layer = 0);
+
+		/// @brief Sorts the batched quads and submits them to the renderer.
+		void end();
+
+		/// @brief Gets the number of quads submitted by the last call to end().
+		/// @return The number of quads.
+		size_t get_quad_count() const;
+
+		/// @brief Gets the number of draw calls made by the last call to end().
+		/// @return The number of SDL_RenderGeometry calls.
+		size_t get_draw_call_count() const;
+
+	private:
+		PenguinRenderer& renderer; /// Reference to the PenguinRenderer the batch draws onto.
+		ScratchBuffer<PenguinSpriteQuad> quads; /// The quads added since begin().
+		ScratchBuffer<SDL_Vertex> vertices; /// The vertices of the sorted quads, four per quad.
+		ScratchBuffer<int> quad_indices; /// Two triangles per quad, shared by every draw call.
+		size_t submitted_quads = 0; /// The number of quads submitted by the last end().
+		size_t draw_calls = 0; /// The number of draw calls made by the last end().
+
+		void write_vertices(const PenguinSpriteQuad& quad, SDL_Vertex* quad_vertices) const;
+	};
+}
+
+#endif // PENGUIN_SPRITE_BATCH_HPP
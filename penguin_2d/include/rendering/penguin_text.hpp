@@ -6,6 +6,9 @@
 /// This class allows manipulation of text properties such as string content,   ///
 /// color, font size, and position. It utilizes a font loaded via PenguinFont   ///
 /// and is rendered through PenguinTextRenderer.                                ///
+///                                                                             ///
+/// Text is drawn as quads from the font's PenguinGlyphAtlas. The quads are     ///
+/// kept in a PenguinTextLayout, so only glyphs that change are rebuilt.        ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #ifndef PENGUIN_TEXT_HPP
@@ -15,6 +18,7 @@
 #include "exception.hpp"
 #include "penguin_text_renderer.hpp"
 #include "penguin_font.hpp"
+#include "penguin_text_layout.hpp"
 #include "colour.hpp"
 #include "vector2.hpp"
 
@@ -32,6 +36,10 @@ namespace Penguin2D {
     ///
     /// This class allows for the creation and rendering of text using a specified font.
     /// It provides functions for updating text properties such as color, position, and content.
+    ///
+    /// Glyphs are placed one codepoint at a time with the font's pair kerning, so text is not
+    /// shaped (no ligatures, combining marks or right-to-left scripts) and is not wrapped.
+    /// Lines only break at '\n'.
     class PenguinText {
     public:
         /// @brief Constructs a PenguinText object.
@@ -41,7 +49,9 @@ namespace Penguin2D {
         /// @param font_size: The size of the font in pixels (optional, defaults to 12.0f).
         /// @param colour: The color of the text (optional, defaults to white).
         /// @param position: The position of the text in the window (optional, defaults to (0,0)).
-        PenguinText(PenguinTextRenderer& text_renderer, const std::string& font_path, const std::string& text_str = "", float font_size = 12.0f, Colour colour = Colours::WHITE, Vector2<int> position = Vector2<int>(0, 0));
+        /// @param font_style: The styles applied to the font (optional, defaults to NORMAL).
+        /// @param font_outline: The outline size of the font in pixels (optional, defaults to 0).
+        PenguinText(PenguinTextRenderer& text_renderer, const std::string& font_path, const std::string& text_str = "", float font_size = 12.0f, Colour colour = Colours::WHITE, Vector2<int> position = Vector2<int>(0, 0), TTF_FontStyleFlags font_style = TTF_STYLE_NORMAL, int font_outline = 0);
 
         /// @brief Draws the text at a specified position.
         /// @param position: The position to render the text at.
@@ -59,9 +69,34 @@ namespace Penguin2D {
         /// @param position: The new position of the text.
         void set_text_position(Vector2<int> position);
 
-        PenguinFont font; /// The font used for rendering text.
+        /// @brief Sets the font size of the text, switching to the shared font of that size, style, and outline.
+        /// @param font_size: The new font size in pixels.
+        void set_font_size(float font_size);
+
+        /// @brief Gets the font size of the text.
+        /// @return The font size in pixels.
+        float get_font_size() const;
+
+        /// @brief Retrieves the font used to render the text.
+        ///
+        /// The font is shared with other texts using the same font file, size, style, and outline, so
+        /// it is read-only. To change the size, use set_font_size(). The style and outline are set
+        /// when the text is constructed.
+        /// @return The font of the text.
+        const PenguinFont& get_font() const;
+
+        /// @brief Retrieves the layout of the text.
+        /// @return The PenguinTextLayout used to draw the text.
+        const PenguinTextLayout& get_layout() const;
     private:
-        std::unique_ptr<TTF_Text, void(*)(TTF_Text*)> text;
+        PenguinTextRenderer& text_renderer; /// The text renderer used to draw the text.
+        std::string font_path; /// The file path to the font, used to look up fonts of other sizes.
+        float font_size; /// The size of the font in pixels.
+        TTF_FontStyleFlags font_style; /// The styles applied to the font.
+        int font_outline; /// The outline size of the font in pixels.
+        const PenguinFont* font; /// The shared font used for rendering text, owned by the text renderer's font registry.
+        PenguinTextLayout layout; /// The glyph quads of the text.
+        Vector2<int> position; /// The offset added to the position the text is drawn at.
     };
 
 }
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_text_layout.hpp                                          ///
+///                                                                             ///
+/// Defines the PenguinTextLayout class, which keeps a string laid out as       ///
+/// textured quads from a PenguinGlyphAtlas.                                    ///
+///                                                                             ///
+/// The quads are built when the string changes and reused every draw, so a    ///
+/// static label costs a single geometry call. When the string changes, only    ///
+/// glyphs that differ or moved are rebuilt, which keeps labels such as scores  ///
+/// and frame counters cheap to update.                                         ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_TEXT_LAYOUT_HPP
+#define PENGUIN_TEXT_LAYOUT_HPP
+
+// Penguin2D related include files
+#include "penguin_renderer.hpp"
+#include "penguin_glyph_atlas.hpp"
+#include "colour.hpp"
+#include "vector2.hpp"
+
+// SDL related include files
+#include <SDL3/SDL_render.h>
+
+// C++ library files
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief A glyph placed by a PenguinTextLayout.
+	struct PenguinPlacedGlyph {
+		uint32_t codepoint; /// The Unicode codepoint of the glyph.
+		float x; /// The x position of the glyph, relative to the top-left of the text.
+		float y; /// The y position of the glyph, relative to the top-left of the text.
+	};
+
+	/// @brief Lays out a string as quads from a glyph atlas and draws them.
+	class PenguinTextLayout {
+	public:
+		/// @brief Constructs an empty PenguinTextLayout.
+		/// @param atlas: The glyph atlas to lay out glyphs from. It must outlive the layout.
+		explicit PenguinTextLayout(PenguinGlyphAtlas& atlas);
+		~PenguinTextLayout() = default;
+
+		/// @brief Sets the string to lay out, rebuilding only the glyphs that changed.
+		/// @param text: The UTF-8 string to lay out.
+		void set_text(const std::string& text);
+
+		/// @brief Switches to a different glyph atlas, rebuilding every glyph.
+		/// @param new_atlas: The glyph atlas to lay out glyphs from. It must outlive the layout.
+		void set_atlas(PenguinGlyphAtlas& new_atlas);
+
+		/// @brief Sets the colour of every glyph.
+		/// @param colour: The new colour of the text.
+		void set_colour(Colour colour);
+
+		/// @brief Draws the laid out text.
+		/// @param renderer: The PenguinRenderer to draw onto.
+		/// @param position: The position of the top-left of the text.
+		/// @return True if every draw call succeeded, otherwise false.
+		bool draw(PenguinRenderer& renderer, Vector2<float> position);
+
+		/// @brief Gets the number of glyphs in the layout.
+		/// @return The number of glyphs, including blank glyphs and line breaks.
+		size_t get_glyph_count() const;
+
+		/// @brief Gets the number of glyphs rebuilt by the last change to the layout.
+		/// @return The number of glyphs rebuilt.
+		size_t get_rebuilt_glyph_count() const;
+
+	private:
+		PenguinGlyphAtlas* atlas; /// The glyph atlas the layout draws from.
+		SDL_FColor colour = { 1.0f, 1.0f, 1.0f, 1.0f }; /// The normalized colour of the text.
+		std::string text; /// The string currently laid out.
+		std::vector<uint32_t> codepoints; /// Reused when decoding a new string.
+		std::vector<PenguinPlacedGlyph> glyphs; /// The placed glyphs of the string.
+		std::vector<int> pages; /// The atlas page of each glyph.
+		std::vector<SDL_Vertex> vertices; /// Four vertices per glyph, relative to the top-left of the text.
+		std::vector<SDL_Vertex> placed_vertices; /// The vertices translated to the last drawn position.
+		std::vector<int> quad_indices; /// Two triangles per glyph, shared by every draw call.
+		Vector2<float> placed_position; /// The position placed_vertices were translated to.
+		bool placed_valid = false; /// Whether placed_vertices match the vertices and placed_position.
+		size_t rebuilt_glyphs = 0; /// The number of glyphs rebuilt by the last change.
+
+		void write_glyph(size_t index, const PenguinGlyph& glyph);
+		static void decode_utf8(const std::string& text, std::vector<uint32_t>& codepoints);
+	};
+}
+
+#endif // PENGUIN_TEXT_LAYOUT_HPP
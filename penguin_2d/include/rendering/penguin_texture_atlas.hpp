@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_texture_atlas.hpp                                        ///
+///                                                                             ///
+/// Defines the PenguinTextureAtlas class, which packs many images into a few   ///
+/// large textures (pages) so that sprites can share a texture.                 ///
+///                                                                             ///
+/// Images are added by name, packed with a skyline packer when the atlas is    ///
+/// built, and uploaded as one texture per page. The packed layout can be saved ///
+/// to a file and loaded later, so the packing cost can be paid offline.        ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PENGUIN_TEXTURE_ATLAS_HPP
+#define PENGUIN_TEXTURE_ATLAS_HPP
+
+// Penguin2D related include files
+#include "penguin_renderer.hpp"
+#include "exception.hpp"
+#include "rect2.hpp"
+
+// SDL related include files
+#include <SDL3_image/SDL_image.h>
+
+// C++ library files
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Penguin2D {
+
+	/// @brief The location of a single image inside a PenguinTextureAtlas.
+	struct PenguinAtlasRegion {
+		std::string path; /// The file path the image was loaded from.
+		int page = -1; /// The page the image is packed into (-1 if not packed yet).
+		int x = 0; /// The x position of the image in its page.
+		int y = 0; /// The y position of the image in its page.
+		int width = 0; /// The width of the image.
+		int height = 0; /// The height of the image.
+	};
+
+	/// @brief Packs many images into a few large textures.
+	///
+	/// Images are added with add_image() and packed into square pages when build() is called.
+	/// Sprites created from the atlas (see PenguinSprite) reference a region of a page, so
+	/// sprites packed into the same page share a single texture. The atlas owns the page
+	/// textures and must outlive any sprite created from it.
+	class PenguinTextureAtlas {
+	public:
+		/// @brief Constructs an empty PenguinTextureAtlas.
+		/// @param renderer: The PenguinRenderer used to create the page textures.
+		/// @param page_size: The width and height of each page in pixels (optional, defaults to 2048).
+		/// @param padding: The empty space left between packed images in pixels (optional, defaults to 1).
+		PenguinTextureAtlas(PenguinRenderer& renderer, int page_size = 2048, int padding = 1);
+		~PenguinTextureAtlas() = default;
+
+		/// @brief Loads an image and queues it to be packed into the atlas. Images must be added before build().
+		/// @param name: The name used to look up the image.
+		/// @param path: The file path to the image.
+		void add_image(const std::string& name, const std::string& path);
+
+		/// @brief Packs the added images into pages and uploads the page textures. Does nothing once built.
+		void build();
+
+		/// @brief Saves the packed layout of the atlas to a file.
+		/// @param path: The file path to write the layout to.
+		void save_layout(const std::string& path) const;
+
+		/// @brief Loads a previously saved layout, so build() can skip packing. Layouts must be loaded before build().
+		/// @param path: The file path to read the layout from.
+		void load_layout(const std::string& path);
+
+		/// @brief Checks if the atlas contains an image.
+		/// @param name: The name of the image.
+		/// @return True if the image was added or loaded from a layout, otherwise false.
+		bool has_image(const std::string& name) const;
+
+		/// @brief Retrieves the location of an image in the atlas.
+		/// @param name: The name of the image.
+		/// @return The region of the image.
+		const PenguinAtlasRegion& get_region(const std::string& name) const;
+
+		/// @brief Retrieves the page texture that an image is packed into.
+		/// @param name: The name of the image.
+		/// @return A pointer to the SDL_Texture of the image's page.
+		SDL_Texture* get_texture(const std::string& name) const;
+
+		/// @brief Retrieves the number of pages in the atlas.
+		/// @return The number of pages.
+		int get_page_count() const;
+
+	private:
+		/// @brief A horizontal segment of a page's skyline.
+		struct SkylineNode {
+			int x; /// The x position where the segment starts.
+			int y; /// The height of the skyline along the segment.
+			int width; /// The width of the segment.
+		};
+
+		PenguinRenderer& renderer; /// Reference to the PenguinRenderer used to create the page textures.
+		int page_size; /// The width and height of each page.
+		int padding; /// The space left between packed images.
+		std::unordered_map<std::string, PenguinAtlasRegion> regions; /// The regions of the atlas, keyed by image name.
+		std::unordered_map<std::string, std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)>> pending_images; /// Images loaded but not yet uploaded.
+		std::vector<std::unique_ptr<SDL_Texture, void(*)(SDL_Texture*)>> pages; /// The uploaded page textures.
+		int page_count = 0; /// The number of pages in the layout.
+
+		void pack();
+		static bool skyline_insert(std::vector<SkylineNode>& skyline, int page_size, int width, int height, int& out_x, int& out_y);
+	};
+}
+
+#endif // PENGUIN_TEXTURE_ATLAS_HPP
@@ -0,0 +1,240 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: vector2_array.cpp                                                     ///
+///                                                                             ///
+/// Each batch operation of Vector2Array has a scalar, an SSE2 and an AVX       ///
+/// kernel. The SIMD kernels are compiled for their instruction set whatever    ///
+/// the compiler's target, and the fastest one the CPU supports is chosen the   ///
+/// first time a batch operation runs. The kernels do the same operations in    ///
+/// the same order, so they give the same results.                              ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "vector2_array.hpp"
+#include "exception.hpp"
+
+// SDL related include files
+#include <SDL3/SDL_cpuinfo.h>
+
+// C++ library files
+#include <algorithm>
+#include <string>
+
+#if !defined(PENGUIN_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define PENGUIN_VECTOR2_ARRAY_X86
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define PENGUIN_TARGET_SSE2 __attribute__((target("sse2")))
+#define PENGUIN_TARGET_AVX __attribute__((target("avx")))
+#else
+#define PENGUIN_TARGET_SSE2
+#define PENGUIN_TARGET_AVX
+#endif
+#endif
+
+using namespace Penguin2D;
+
+namespace {
+
+	/// @brief The batch kernels for one instruction set. Each processes count components.
+	struct Kernels {
+		void (*integrate)(float* values, const float* velocities, size_t count, float delta_time);
+		void (*lerp)(float* values, const float* from, const float* to, size_t count, float weight);
+		void (*distance_squared)(const float* xs, const float* ys, size_t count, float point_x, float point_y, float* results);
+	};
+
+	void integrate_scalar(float* values, const float* velocities, size_t count, float delta_time) {
+		for (size_t i = 0; i < count; i++) {
+			values[i] += velocities[i] * delta_time;
+		}
+	}
+
+	void lerp_scalar(float* values, const float* from, const float* to, size_t count, float weight) {
+		for (size_t i = 0; i < count; i++) {
+			values[i] = from[i] + (to[i] - from[i]) * weight;
+		}
+	}
+
+	void distance_squared_scalar(const float* xs, const float* ys, size_t count, float point_x, float point_y, float* results) {
+		for (size_t i = 0; i < count; i++) {
+			float dx = xs[i] - point_x;
+			float dy = ys[i] - point_y;
+			results[i] = dx * dx + dy * dy;
+		}
+	}
+
+#if defined(PENGUIN_VECTOR2_ARRAY_X86)
+	PENGUIN_TARGET_SSE2 void integrate_sse2(float* values, const float* velocities, size_t count, float delta_time) {
+		const __m128 step = _mm_set1_ps(delta_time);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(velocities + i), step)));
+		}
+		integrate_scalar(values + i, velocities + i, count - i, delta_time);
+	}
+
+	PENGUIN_TARGET_SSE2 void lerp_sse2(float* values, const float* from, const float* to, size_t count, float weight) {
+		const __m128 scale = _mm_set1_ps(weight);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 start = _mm_loadu_ps(from + i);
+			_mm_storeu_ps(values + i, _mm_add_ps(start, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(to + i), start), scale)));
+		}
+		lerp_scalar(values + i, from + i, to + i, count - i, weight);
+	}
+
+	PENGUIN_TARGET_SSE2 void distance_squared_sse2(const float* xs, const float* ys, size_t count, float point_x, float point_y, float* results) {
+		const __m128 px = _mm_set1_ps(point_x);
+		const __m128 py = _mm_set1_ps(point_y);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), px);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), py);
+			_mm_storeu_ps(results + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+		}
+		distance_squared_scalar(xs + i, ys + i, count - i, point_x, point_y, results + i);
+	}
+
+	PENGUIN_TARGET_AVX void integrate_avx(float* values, const float* velocities, size_t count, float delta_time) {
+		const __m256 step = _mm256_set1_ps(delta_time);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			_mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(_mm256_loadu_ps(velocities + i), step)));
+		}
+		integrate_scalar(values + i, velocities + i, count - i, delta_time);
+	}
+
+	PENGUIN_TARGET_AVX void lerp_avx(float* values, const float* from, const float* to, size_t count, float weight) {
+		const __m256 scale = _mm256_set1_ps(weight);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 start = _mm256_loadu_ps(from + i);
+			_mm256_storeu_ps(values + i, _mm256_add_ps(start, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(to + i), start), scale)));
+		}
+		lerp_scalar(values + i, from + i, to + i, count - i, weight);
+	}
+
+	PENGUIN_TARGET_AVX void distance_squared_avx(const float* xs, const float* ys, size_t count, float point_x, float point_y, float* results) {
+		const __m256 px = _mm256_set1_ps(point_x);
+		const __m256 py = _mm256_set1_ps(point_y);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), px);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), py);
+			_mm256_storeu_ps(results + i, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+		}
+		distance_squared_scalar(xs + i, ys + i, count - i, point_x, point_y, results + i);
+	}
+#endif
+
+	/// @brief Gets the kernels for the fastest instruction set the CPU supports, chosen on the first call.
+	/// @return The kernels.
+	const Kernels& get_kernels() {
+		static const Kernels kernels = []() {
+#if defined(PENGUIN_VECTOR2_ARRAY_X86)
+			if (SDL_HasAVX()) {
+				return Kernels{ integrate_avx, lerp_avx, distance_squared_avx };
+			}
+			if (SDL_HasSSE2()) {
+				return Kernels{ integrate_sse2, lerp_sse2, distance_squared_sse2 };
+			}
+#endif
+			return Kernels{ integrate_scalar, lerp_scalar, distance_squared_scalar };
+		}();
+		return kernels;
+	}
+
+	/// @brief Throws an exception if two arrays differ in size.
+	/// @param expected: The size of the array being updated.
+	/// @param actual: The size of the other array.
+	void check_size(size_t expected, size_t actual) {
+		Exception::throw_if(expected != actual, "A Vector2Array of " + std::to_string(actual) + " vectors was given where "
+			+ std::to_string(expected) + " were expected.", RUNTIME_ERROR);
+	}
+}
+
+/// @brief Constructs a Vector2Array of count copies of a vector.
+/// @param count: The number of vectors.
+/// @param value: The value of each vector.
+Vector2Array::Vector2Array(size_t count, Vector2<float> value)
+	: xs(count, value.x), ys(count, value.y) {
+}
+
+/// @brief Reserves memory for a number of vectors.
+/// @param count: The number of vectors.
+void Vector2Array::reserve(size_t count) {
+	xs.reserve(count);
+	ys.reserve(count);
+}
+
+/// @brief Resizes the array, filling new vectors with a value.
+/// @param count: The new number of vectors.
+/// @param value: The value of each new vector.
+void Vector2Array::resize(size_t count, Vector2<float> value) {
+	xs.resize(count, value.x);
+	ys.resize(count, value.y);
+}
+
+/// @brief Removes every vector, keeping the memory.
+void Vector2Array::clear() {
+	xs.clear();
+	ys.clear();
+}
+
+/// @brief Moves every vector by a velocity over a time step: value += velocity * delta_time.
+///
+/// If the arrays differ in size, an exception is thrown.
+///
+/// @param velocities: The velocity of each vector.
+/// @param delta_time: The time step in seconds.
+void Vector2Array::integrate(const Vector2Array& velocities, float delta_time) {
+	check_size(size(), velocities.size());
+	const Kernels& kernels = get_kernels();
+	kernels.integrate(xs.data(), velocities.xs.data(), xs.size(), delta_time);
+	kernels.integrate(ys.data(), velocities.ys.data(), ys.size(), delta_time);
+}
+
+/// @brief Sets every vector by interpolating between two arrays, as Vector2::lerp() would.
+///
+/// If the arrays differ in size, an exception is thrown. Either array may be this one.
+///
+/// @param from: The vectors at weight 0.
+/// @param to: The vectors at weight 1.
+/// @param weight: How far to interpolate.
+void Vector2Array::lerp(const Vector2Array& from, const Vector2Array& to, float weight) {
+	check_size(size(), from.size());
+	check_size(size(), to.size());
+	const Kernels& kernels = get_kernels();
+	kernels.lerp(xs.data(), from.xs.data(), to.xs.data(), xs.size(), weight);
+	kernels.lerp(ys.data(), from.ys.data(), to.ys.data(), ys.size(), weight);
+}
+
+/// @brief Gets the squared distance from every vector to a point.
+/// @param point: The point.
+/// @param results: Filled with size() squared distances.
+void Vector2Array::distance_squared_to(Vector2<float> point, float* results) const {
+	get_kernels().distance_squared(xs.data(), ys.data(), xs.size(), point.x, point.y, results);
+}
+
+/// @brief Finds every vector within a radius of a point, edges included.
+///
+/// Distances are computed a block at a time into a buffer on the stack, then compared.
+///
+/// @param point: The point.
+/// @param radius: The radius.
+/// @param indices: Cleared, then filled in increasing order with the index of each vector within the radius.
+void Vector2Array::find_within(Vector2<float> point, float radius, std::vector<uint32_t>& indices) const {
+	constexpr size_t BLOCK_SIZE = 256;
+	float distances[BLOCK_SIZE];
+	float radius_squared = radius * radius;
+	const Kernels& kernels = get_kernels();
+
+	indices.clear();
+	for (size_t first = 0; first < xs.size(); first += BLOCK_SIZE) {
+		size_t count = std::min(BLOCK_SIZE, xs.size() - first);
+		kernels.distance_squared(xs.data() + first, ys.data() + first, count, point.x, point.y, distances);
+		for (size_t i = 0; i < count; i++) {
+			if (distances[i] <= radius_squared) {
+				indices.push_back((uint32_t)(first + i));
+			}
+		}
+	}
+}
@@ -1,20 +1,33 @@
 ///////////////////////////////////////////////////////////////////////////////////
-/// File: penguin_event_handler.cpp												///
-///																				///
-/// This file implements the PenguinEventHandler class, which is responsible	///
-/// for handling SDL events. It processes event polling, manages callback		///
-/// functions, and detects quit requests.										///
+/// File: penguin_event_handler.cpp                                             ///
+///                                                                             ///
+/// This file implements the PenguinEventHandler class, which is responsible    ///
+/// for handling SDL events. It processes event polling, manages callback       ///
+/// functions, and detects quit requests.                                       ///
+///                                                                             ///
+/// Event types are grouped by their high byte (0x3xx are key events, 0x4xx     ///
+/// mouse events, and so on). Each group has a flat list of the listeners whose ///
+/// range overlaps it, rebuilt when listeners are added or removed, so an event ///
+/// is only checked against the listeners of its own group.                     ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "penguin_event_handler.hpp"
+#include "exception.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <string>
 
 using namespace Penguin2D;
 
-/// @brief Polls SDL events and executes all registered callback functions.
+/// @brief Polls SDL events and executes the callback functions registered for their types.
+///
+/// This function retrieves SDL events from the event queue and calls the event listeners
+/// registered for each event's type. If a quit event (SDL_EVENT_QUIT) is detected, the event
+/// handler marks the application for termination.
 ///
-/// This function retrieves SDL events from the event queue and calls any registered
-/// event listeners. If a quit event (SDL_EVENT_QUIT) is detected, the event handler
-/// marks the application for termination.
+/// Consecutive events of a coalesced type are merged and delivered once, before the next
+/// event of another type or at the end of the poll, so listeners still see events in order.
 void PenguinEventHandler::poll_events() {
 	SDL_Event sdl_event;
 	while (SDL_PollEvent(&sdl_event)) {
@@ -23,29 +36,198 @@ void PenguinEventHandler::poll_events() {
 			quit = true; // Mark application for closure
 		}
 
-		// Notify all registered listeners of the event
-		for (auto& callback_function : callback_functions) {
-			callback_function(sdl_event); 
+		if (try_merge_pending_event(sdl_event)) {
+			continue;
+		}
+		flush_pending_event();
+
+		if (is_coalesced(sdl_event.type)) {
+			pending_event = sdl_event;
+			has_pending_event = true;
+		}
+		else {
+			dispatch(sdl_event);
 		}
 	}
+	flush_pending_event();
 }
 
-/// @brief Registers a new event listener callback.
-/// 
-/// This function stores the provided callback function in a list of event listeners.
-/// The function will be called whenever an event is polled.
-/// 
+/// @brief Registers a new event listener callback for every event type.
+///
+/// This function stores the provided callback function, which will be called whenever
+/// an event is polled.
+///
 /// @param callback_function: Function to be executed when an event occurs.
-void PenguinEventHandler::add_event_listener(const std::function<void(const SDL_Event&)>& callback_function) {
-	callback_functions.push_back(callback_function);
+/// @return PenguinEventListenerId: The id of the listener.
+PenguinEventListenerId PenguinEventHandler::add_event_listener(const std::function<void(const SDL_Event&)>& callback_function) {
+	auto owned_function = std::make_unique<std::function<void(const SDL_Event&)>>(callback_function);
+	std::function<void(const SDL_Event&)>* function = owned_function.get();
+
+	PenguinEventListenerId id = add_event_listener(SDL_EVENT_FIRST, SDL_EVENT_LAST, [function](const SDL_Event& p_event) {
+		(*function)(p_event);
+	});
+	listeners[id].callback_function = std::move(owned_function);
+	return id;
+}
+
+/// @brief Registers a new event listener for one event type.
+/// @param type: The event type.
+/// @param listener: Called with each event of that type.
+/// @return PenguinEventListenerId: The id of the listener.
+PenguinEventListenerId PenguinEventHandler::add_event_listener(Uint32 type, PenguinEventListener listener) {
+	return add_event_listener(type, type, listener);
+}
+
+/// @brief Registers a new event listener for a range of event types.
+///
+/// If the range is invalid, or a listener is running, an exception is thrown.
+///
+/// @param first_type: The first event type.
+/// @param last_type: The last event type, included.
+/// @param listener: Called with each event in the range.
+/// @return PenguinEventListenerId: The id of the listener.
+PenguinEventListenerId PenguinEventHandler::add_event_listener(Uint32 first_type, Uint32 last_type, PenguinEventListener listener) {
+	Exception::throw_if(dispatching, "Event listeners cannot be added while events are dispatched.", RUNTIME_ERROR);
+	Exception::throw_if(first_type > last_type || last_type > SDL_EVENT_LAST, "The event type range " + std::to_string(first_type)
+		+ " to " + std::to_string(last_type) + " is invalid.", INPUT_ERROR);
+
+	PenguinEventListenerId id = (PenguinEventListenerId)listeners.size();
+	listeners.push_back(ListenerEntry{ first_type, last_type, listener, nullptr, true });
+	rebuild_groups();
+	return id;
+}
+
+/// @brief Removes an event listener.
+///
+/// If the id does not refer to a listener, or a listener is running, an exception is thrown.
+///
+/// @param id: The id returned when the listener was added.
+void PenguinEventHandler::remove_event_listener(PenguinEventListenerId id) {
+	Exception::throw_if(dispatching, "Event listeners cannot be removed while events are dispatched.", RUNTIME_ERROR);
+	Exception::throw_if(id >= listeners.size() || !listeners[id].active,
+		"The event listener " + std::to_string(id) + " does not exist.", RUNTIME_ERROR);
+
+	listeners[id].active = false;
+	listeners[id].callback_function.reset();
+	rebuild_groups();
+}
+
+/// @brief Sets whether consecutive events of a type are merged into one per poll.
+/// @param type: The event type.
+/// @param coalesce: True to merge the events, false to deliver each one.
+void PenguinEventHandler::set_coalesced(Uint32 type, bool coalesce) {
+	auto found = std::find(coalesced_types.begin(), coalesced_types.end(), type);
+	if (coalesce && found == coalesced_types.end()) {
+		coalesced_types.push_back(type);
+	}
+	else if (!coalesce && found != coalesced_types.end()) {
+		coalesced_types.erase(found);
+	}
+}
+
+/// @brief Checks if consecutive events of a type are merged into one per poll.
+/// @param type: The event type.
+/// @return bool: True if the events are merged, otherwise false.
+bool PenguinEventHandler::is_coalesced(Uint32 type) const {
+	return std::find(coalesced_types.begin(), coalesced_types.end(), type) != coalesced_types.end();
 }
 
 /// @brief Checks whether the application should terminate due to a quit event.
 ///
 /// This function allows external components to query if a quit event has been received,
 /// enabling a clean shutdown process.
-/// 
+///
 /// @return True if a quit event has been detected, otherwise false.
 bool PenguinEventHandler::should_quit() const {
 	return quit;
 }
+
+/// @brief Calls the listeners registered for an event's type, in the order they were added.
+/// @param p_event: The event.
+void PenguinEventHandler::dispatch(const SDL_Event& p_event) {
+	if (p_event.type > SDL_EVENT_LAST) {
+		return;
+	}
+
+	size_t group = (size_t)p_event.type >> TYPE_GROUP_BITS;
+	dispatching = true;
+	try {
+		for (uint32_t i = group_offsets[group]; i < group_offsets[group + 1]; i++) {
+			ListenerEntry& entry = listeners[group_listeners[i]];
+			if (p_event.type >= entry.first_type && p_event.type <= entry.last_type) {
+				entry.listener(p_event);
+			}
+		}
+	}
+	catch (...) {
+		dispatching = false;
+		throw;
+	}
+	dispatching = false;
+}
+
+/// @brief Delivers the merged event of a coalesced type, if any.
+void PenguinEventHandler::flush_pending_event() {
+	if (has_pending_event) {
+		has_pending_event = false;
+		dispatch(pending_event);
+	}
+}
+
+/// @brief Merges an event into the pending one if they are of the same coalesced type and source.
+///
+/// Mouse motion keeps the latest position and buttons and adds up the relative motion. Other
+/// types keep the latest event.
+///
+/// @param p_event: The polled event.
+/// @return bool: True if the event was merged, otherwise false.
+bool PenguinEventHandler::try_merge_pending_event(const SDL_Event& p_event) {
+	if (!has_pending_event || pending_event.type != p_event.type) {
+		return false;
+	}
+
+	if (p_event.type == SDL_EVENT_MOUSE_MOTION) {
+		if (pending_event.motion.windowID != p_event.motion.windowID || pending_event.motion.which != p_event.motion.which) {
+			return false;
+		}
+		float xrel = pending_event.motion.xrel + p_event.motion.xrel;
+		float yrel = pending_event.motion.yrel + p_event.motion.yrel;
+		pending_event = p_event;
+		pending_event.motion.xrel = xrel;
+		pending_event.motion.yrel = yrel;
+	}
+	else {
+		pending_event = p_event;
+	}
+	return true;
+}
+
+/// @brief Rebuilds the flat list of listeners of each type group.
+void PenguinEventHandler::rebuild_groups() {
+	std::array<uint32_t, TYPE_GROUP_COUNT> counts{};
+	for (const ListenerEntry& entry : listeners) {
+		if (entry.active) {
+			for (size_t group = entry.first_type >> TYPE_GROUP_BITS; group <= (entry.last_type >> TYPE_GROUP_BITS); group++) {
+				counts[group]++;
+			}
+		}
+	}
+
+	group_offsets[0] = 0;
+	for (size_t group = 0; group < TYPE_GROUP_COUNT; group++) {
+		group_offsets[group + 1] = group_offsets[group] + counts[group];
+	}
+
+	// Fill each group in id order, so listeners are called in the order they were added.
+	group_listeners.resize(group_offsets[TYPE_GROUP_COUNT]);
+	std::array<uint32_t, TYPE_GROUP_COUNT> next{};
+	std::copy(group_offsets.begin(), group_offsets.end() - 1, next.begin());
+	for (uint32_t id = 0; id < listeners.size(); id++) {
+		const ListenerEntry& entry = listeners[id];
+		if (entry.active) {
+			for (size_t group = entry.first_type >> TYPE_GROUP_BITS; group <= (entry.last_type >> TYPE_GROUP_BITS); group++) {
+				group_listeners[next[group]++] = id;
+			}
+		}
+	}
+}
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_frame_pacer.cpp                                               ///
+///                                                                             ///
+/// PenguinFramePacer waits until a deadline by sleeping for most of the wait   ///
+/// and yielding for the rest, learning how late the OS wakes sleeping threads. ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_frame_pacer.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace Penguin2D;
+
+namespace {
+	constexpr int CALIBRATION_SAMPLES = 8; /// The number of sleeps measured by calibrate().
+	constexpr double CALIBRATION_SLEEP = 0.001; /// The length of each calibration sleep in seconds.
+	constexpr double LEARNING_RATE = 0.1; /// How quickly the adaptive estimate follows new measurements.
+	constexpr double DEVIATION_MARGIN = 4.0; /// How many mean deviations of lateness the spin slice allows for.
+	constexpr double MIN_SPIN_THRESHOLD = 0.0002; /// The shortest spin slice in seconds.
+	constexpr double MAX_SPIN_THRESHOLD = 0.004; /// The longest spin slice in seconds.
+}
+
+/// @brief Blocks the calling thread until a deadline.
+///
+/// In SLEEP mode, this is a single sleep. Otherwise the thread sleeps until the spin
+/// threshold before the deadline and then yields in a loop, so a late wake-up from the
+/// sleep is absorbed by the yield slice instead of delaying the frame. An uncalibrated pacer
+/// uses a default slice, which ADAPTIVE mode then learns from.
+///
+/// @param deadline: The time to wake at.
+void PenguinFramePacer::wait_until(penguin_clock::time_point deadline) {
+	auto now = penguin_clock::now();
+	if (now >= deadline) {
+		return;
+	}
+
+	if (mode == PenguinPacingMode::SLEEP) {
+		std::this_thread::sleep_until(deadline);
+		return;
+	}
+
+	auto sleep_end = deadline - std::chrono::duration_cast<penguin_clock::duration>(std::chrono::duration<double>(spin_threshold));
+	if (sleep_end > now) {
+		std::this_thread::sleep_until(sleep_end);
+		if (mode == PenguinPacingMode::ADAPTIVE) {
+			learn_overshoot(std::chrono::duration<double>(penguin_clock::now() - sleep_end).count());
+		}
+	}
+
+	while (penguin_clock::now() < deadline) {
+		std::this_thread::yield();
+	}
+}
+
+/// @brief Measures how late short sleeps wake, and sizes the spin slice from it.
+void PenguinFramePacer::calibrate() {
+	double overshoots[CALIBRATION_SAMPLES];
+	for (double& overshoot : overshoots) {
+		auto start = penguin_clock::now();
+		std::this_thread::sleep_for(std::chrono::duration<double>(CALIBRATION_SLEEP));
+		overshoot = std::max(0.0, std::chrono::duration<double>(penguin_clock::now() - start).count() - CALIBRATION_SLEEP);
+	}
+
+	double total = 0.0;
+	for (double overshoot : overshoots) {
+		total += overshoot;
+	}
+	overshoot_mean = total / CALIBRATION_SAMPLES;
+
+	double total_deviation = 0.0;
+	for (double overshoot : overshoots) {
+		total_deviation += std::abs(overshoot - overshoot_mean);
+	}
+	overshoot_deviation = total_deviation / CALIBRATION_SAMPLES;
+
+	// Cover the worst sample as well, as a handful of sleeps understates the tail.
+	update_spin_threshold();
+	spin_threshold = std::clamp(std::max(spin_threshold, *std::max_element(overshoots, overshoots + CALIBRATION_SAMPLES)), MIN_SPIN_THRESHOLD, MAX_SPIN_THRESHOLD);
+	calibrated = true;
+}
+
+/// @brief Sets how the pacer waits.
+/// @param new_mode: The new pacing mode.
+void PenguinFramePacer::set_mode(PenguinPacingMode new_mode) {
+	mode = new_mode;
+}
+
+/// @brief Gets how the pacer waits.
+/// @return PenguinPacingMode: The pacing mode.
+PenguinPacingMode PenguinFramePacer::get_mode() const {
+	return mode;
+}
+
+/// @brief Gets the pacer's sleep error estimate.
+/// @return PenguinPacerStats: The pacer's statistics.
+PenguinPacerStats PenguinFramePacer::get_stats() const {
+	return PenguinPacerStats{ spin_threshold * 1000.0, overshoot_mean * 1000.0, overshoot_deviation * 1000.0, calibrated };
+}
+
+/// @brief Folds a measured sleep lateness into the running estimate.
+/// @param overshoot: How late the last sleep woke, in seconds.
+void PenguinFramePacer::learn_overshoot(double overshoot) {
+	overshoot = std::max(0.0, overshoot);
+	overshoot_mean += LEARNING_RATE * (overshoot - overshoot_mean);
+	overshoot_deviation += LEARNING_RATE * (std::abs(overshoot - overshoot_mean) - overshoot_deviation);
+	update_spin_threshold();
+}
+
+/// @brief Sizes the spin slice from the sleep lateness estimate.
+void PenguinFramePacer::update_spin_threshold() {
+	spin_threshold = std::clamp(overshoot_mean + DEVIATION_MARGIN * overshoot_deviation, MIN_SPIN_THRESHOLD, MAX_SPIN_THRESHOLD);
+}
@@ -11,6 +11,21 @@
 /// delta time and FPS to ensure consistent performance across different        ///
 /// hardware. Additionally, it handles proper cleanup when the game terminates. ///
 ///                                                                             ///
+/// Each phase of the loop is recorded as a zone in the window's profiler, so   ///
+/// frame spikes can be traced back to the phase that caused them.              ///
+///                                                                             ///
+/// Jobs that update() starts on the window's job system are joined before the  ///
+/// updated state is published and drawn.                                       ///
+///                                                                             ///
+/// The interpolation store keeps its positions before each fixed update, and   ///
+/// is interpolated by the timer's alpha after the state is published, while    ///
+/// no update is running, so draw() can read the render positions safely.       ///
+///                                                                             ///
+/// When pipelining is enabled, updates run on a PenguinUpdateWorker thread     ///
+/// while the main thread draws the state the game published for the previous   ///
+/// frame, so a heavy simulation step overlaps rendering instead of adding to   ///
+/// it.                                                                         ///
+///                                                                             ///
 /// The connect_game function is responsible for linking a PenguinGame instance ///
 /// to the window. Once a game is connected, its lifecycle methods (init,       ///
 /// update, draw, and quit) are executed within the run function. This ensures  ///
@@ -31,8 +46,8 @@ PenguinGameWindow::PenguinGameWindow(const std::string& game_title, Vector2<int>
     text_renderer(renderer),
     timer() {
 
-    // Add listener for the input to the event handler
-    event_handler.add_event_listener([this](const SDL_Event& p_event) {
+    // Add listener for the key events to the event handler
+    event_handler.add_event_listener(SDL_EVENT_KEY_DOWN, SDL_EVENT_KEY_UP, [this](const SDL_Event& p_event) {
         init_events(p_event);
         });
 
@@ -41,6 +56,7 @@ PenguinGameWindow::PenguinGameWindow(const std::string& game_title, Vector2<int>
 
     running = false;
     window_open = true;
+    pipelined = false;
 }
 
 /// @brief Default constructor. Initializes the window with a default size of 640x480.
@@ -50,8 +66,8 @@ PenguinGameWindow::PenguinGameWindow()
     text_renderer(renderer),
     timer() {
 
-    // Add listener for the input to the event handler
-    event_handler.add_event_listener([this](const SDL_Event& p_event) {
+    // Add listener for the key events to the event handler
+    event_handler.add_event_listener(SDL_EVENT_KEY_DOWN, SDL_EVENT_KEY_UP, [this](const SDL_Event& p_event) {
         init_events(p_event);
         });
 
@@ -60,6 +76,7 @@ PenguinGameWindow::PenguinGameWindow()
 
     running = false;
     window_open = true;
+    pipelined = false;
 }
 
 /// @brief Initializes event handling for the game window.
@@ -89,37 +106,187 @@ void PenguinGameWindow::run() {
         // Initalize the game with user defined values.
         game_instance->init();
 
+        // Calibrate the frame pacer now, in case init() changed the pacing mode, so the first capped frame does not stall.
+        timer.calibrate_frame_pacer();
+
         running = true;
 
         // Game loop.
-        while (running) {
+        if (pipelined) {
+            run_pipelined_frames();
+        }
+        else {
+            run_serial_frames();
+        }
+
+        // No job may outlive the game loop it was started in.
+        job_system.wait_all();
+
+        // Clean up game processes (e.g., saving game objects, closing other third-party libraries.
+        game_instance->quit();
+    }
+} // The destructor will clean up the SDL_related resources.
 
+/// @brief Prepares the input and interpolation state for the next fixed update step.
+///
+/// Key presses and releases handled since the previous step become visible to this one,
+/// and the interpolated positions are kept as the previous ones.
+void PenguinGameWindow::begin_step() {
+    input.begin_step();
+    interpolation.begin_step();
+}
+
+/// @brief Runs frames with update and draw on the main thread until the game stops.
+void PenguinGameWindow::run_serial_frames() {
+    while (running) {
+        PENGUIN_PROFILE_SCOPE(profiler, "frame");
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "poll_events");
             event_handler.poll_events();
+        }
 
-            timer.update_frame_time();
+        timer.update_frame_time();
 
-            while (timer.should_update()) {
-                auto delta_time = timer.get_delta_time();
-                game_instance->update(delta_time);
-                timer.consume_time();
-            }
+        while (timer.should_update()) {
+            PENGUIN_PROFILE_SCOPE(profiler, "update");
+            auto delta_time = timer.get_step_time();
+            auto update_start = std::chrono::steady_clock::now();
+            begin_step();
+            game_instance->update(delta_time);
+            timer.record_update_cost(std::chrono::duration<double>(std::chrono::steady_clock::now() - update_start).count());
+            timer.consume_time();
+        }
+        timer.end_updates(); // Drop (or catch up on) the time the substep limit and update budget left over
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "join_jobs");
+            job_system.wait_all();
+        }
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "publish_state");
+            game_instance->publish_state();
+        }
 
-            double alpha = timer.get_alpha();
+        double alpha = timer.get_alpha();
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "interpolate");
+            interpolation.interpolate(alpha);
+        }
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "draw");
             game_instance->draw(alpha);
+        }
 
-            // Close the window if the user specifies it.
-            if (event_handler.should_quit()) {
-                close_window();
-            }
+        // Close the window if the user specifies it.
+        if (event_handler.should_quit()) {
+            close_window();
+        }
 
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "update_fps");
             timer.update_fps(); // Track the actual FPS
+        }
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "cap_frame_rate");
             timer.cap_frame_rate(); // If enabled, caps frame rate to target FPS
         }
+    }
+}
 
-        // Clean up game processes (e.g., saving game objects, closing other third-party libraries.
-        game_instance->quit();
+/// @brief Runs frames with update on a worker thread until the game stops.
+///
+/// Each frame waits for the previous frame's updates and their jobs, polls events and
+/// publishes the updated state while no update is running, then starts the next batch of
+/// updates and draws the published state alongside it. Events are only polled while the worker is
+/// idle, so update() sees a stable input state.
+void PenguinGameWindow::run_pipelined_frames() {
+    PenguinUpdateWorker update_worker(*game_instance, profiler, [this]() { begin_step(); });
+
+    while (running) {
+        PENGUIN_PROFILE_SCOPE(profiler, "frame");
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "wait_update");
+            double step_cost = update_worker.wait();
+            if (step_cost > 0.0) {
+                timer.record_update_cost(step_cost);
+            }
+        }
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "join_jobs");
+            job_system.wait_all();
+        }
+
+        // update() may have stopped the game from the worker thread.
+        if (!running) {
+            break;
+        }
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "poll_events");
+            event_handler.poll_events();
+        }
+
+        // The published state is the batch started last frame, so its alpha is taken before
+        // this frame's steps are consumed. Taken after, it would fall back to about 0 on every
+        // frame that starts a step and draw the same positions a step backward. A frame more
+        // than a step behind draws the published positions as they are.
+        timer.update_frame_time();
+        double alpha = std::min(timer.get_alpha(), 1.0);
+
+        // Consume the steps here, so the timer is only ever used by the main thread.
+        int steps = 0;
+        double catch_up_time = 0.0;
+        while (timer.should_update()) {
+            if (timer.is_catch_up_step()) {
+                catch_up_time = timer.get_step_time();
+            }
+            else {
+                steps++;
+            }
+            timer.consume_time();
+        }
+        timer.end_updates();
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "publish_state");
+            game_instance->publish_state();
+        }
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "interpolate");
+            interpolation.interpolate(alpha);
+        }
+
+        update_worker.start_updates(steps, timer.get_delta_time(), catch_up_time);
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "draw");
+            game_instance->draw(alpha);
+        }
+
+        // Close the window if the user specifies it.
+        if (event_handler.should_quit()) {
+            close_window();
+        }
+
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "update_fps");
+            timer.update_fps(); // Track the actual FPS
+        }
+        {
+            PENGUIN_PROFILE_SCOPE(profiler, "cap_frame_rate");
+            timer.cap_frame_rate(); // If enabled, caps frame rate to target FPS
+        }
     }
-} // The destructor will clean up the SDL_related resources.
+
+    // Finish the last batch before quit() runs, and surface any exception it threw.
+    update_worker.wait();
+}
 
 /// @brief Stops the game loop.
 void PenguinGameWindow::stop_game() {
@@ -142,4 +309,16 @@ bool PenguinGameWindow::is_open() const {
 void PenguinGameWindow::close_window() {
     window_open = false;
     running = false;
+}
+
+/// @brief Enables or disables pipelined update and draw.
+/// @param enable: True to pipeline update and draw, otherwise false.
+void PenguinGameWindow::set_pipelined(bool enable) {
+    pipelined = enable;
+}
+
+/// @brief Checks if update and draw are pipelined.
+/// @return bool: True if pipelining is enabled, false otherwise.
+bool PenguinGameWindow::is_pipelined() const {
+    return pipelined;
 }
\ No newline at end of file
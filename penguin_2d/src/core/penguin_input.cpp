@@ -5,66 +5,240 @@
 ///                                                                             ///
 /// This class processes keyboard input events. It provides functions to        ///
 /// handle key presses and check for pressed keys.                              ///
+///                                                                             ///
+/// SDL keycodes are either characters (below 256) or a scancode with           ///
+/// SDLK_SCANCODE_MASK set, so a table with a slot for each character and each  ///
+/// scancode, built at compile time, translates them without hashing.          ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "penguin_input.hpp"
 
+// C++ library files
+#include <array>
+#include <cstdint>
+
 using namespace Penguin2D;
 
+namespace {
+
+    /// @brief An SDL keycode and the PenguinKey it maps to.
+    struct KeyMapping {
+        SDL_Keycode keycode;
+        PenguinKey key;
+    };
+
+    /// Maps SDL keycodes to PenguinKey values.
+    constexpr KeyMapping KEY_MAP[] = {
+        { SDLK_UNKNOWN, PenguinKey::UNKNOWN },
+        { SDLK_RETURN, PenguinKey::ENTER },
+        { SDLK_ESCAPE, PenguinKey::ESC },
+        { SDLK_BACKSPACE, PenguinKey::BACKSPACE },
+        { SDLK_TAB, PenguinKey::TAB },
+        { SDLK_SPACE, PenguinKey::SPACE },
+        { SDLK_EXCLAIM, PenguinKey::EXCLAIM },
+        { SDLK_AT, PenguinKey::AT },
+        { SDLK_HASH, PenguinKey::HASH },
+        { SDLK_DOLLAR, PenguinKey::DOLLAR },
+        { SDLK_PERCENT, PenguinKey::PERCENT },
+        { SDLK_CARET, PenguinKey::CARET },
+        { SDLK_AMPERSAND, PenguinKey::AMPERSAND },
+        { SDLK_ASTERISK, PenguinKey::ASTERISK },
+        { SDLK_LEFTPAREN, PenguinKey::LBRACKET },
+        { SDLK_RIGHTPAREN, PenguinKey::RBRACKET },
+        { SDLK_MINUS, PenguinKey::MINUS },
+        { SDLK_PLUS, PenguinKey::PLUS },
+        { SDLK_0, PenguinKey::KEY_0 },
+        { SDLK_1, PenguinKey::KEY_1 },
+        { SDLK_2, PenguinKey::KEY_2 },
+        { SDLK_3, PenguinKey::KEY_3 },
+        { SDLK_4, PenguinKey::KEY_4 },
+        { SDLK_5, PenguinKey::KEY_5 },
+        { SDLK_6, PenguinKey::KEY_6 },
+        { SDLK_7, PenguinKey::KEY_7 },
+        { SDLK_8, PenguinKey::KEY_8 },
+        { SDLK_9, PenguinKey::KEY_9 },
+        { SDLK_UNDERSCORE, PenguinKey::UNDERSCORE },
+        { SDLK_EQUALS, PenguinKey::EQUAL_SIGN },
+        { SDLK_GREATER, PenguinKey::GREATER },
+        { SDLK_LESS, PenguinKey::LESS },
+        { SDLK_LEFTBRACE, PenguinKey::LBRACE },
+        { SDLK_RIGHTBRACE, PenguinKey::RBRACE },
+        { SDLK_LEFTBRACKET, PenguinKey::LSQUARE_BRACKET },
+        { SDLK_RIGHTBRACKET, PenguinKey::RSQUARE_BRACKET },
+        { SDLK_QUESTION, PenguinKey::QUESTION },
+        { SDLK_SLASH, PenguinKey::SLASH },
+        { SDLK_BACKSLASH, PenguinKey::BACKSLASH },
+        { SDLK_PIPE, PenguinKey::PIPE },
+        { SDLK_COMMA, PenguinKey::COMMA },
+        { SDLK_PERIOD, PenguinKey::PERIOD },
+        { SDLK_COLON, PenguinKey::COLON },
+        { SDLK_SEMICOLON, PenguinKey::SEMICOLON },
+        { SDLK_APOSTROPHE, PenguinKey::DQUOTE },
+        { SDLK_DBLAPOSTROPHE, PenguinKey::SQUOTE },
+        { SDLK_GRAVE, PenguinKey::GRAVE },
+        { SDLK_TILDE, PenguinKey::TIDLE },
+        { SDLK_A, PenguinKey::KEY_A },
+        { SDLK_B, PenguinKey::KEY_B },
+        { SDLK_C, PenguinKey::KEY_C },
+        { SDLK_D, PenguinKey::KEY_D },
+        { SDLK_E, PenguinKey::KEY_E },
+        { SDLK_F, PenguinKey::KEY_F },
+        { SDLK_G, PenguinKey::KEY_G },
+        { SDLK_H, PenguinKey::KEY_H },
+        { SDLK_I, PenguinKey::KEY_I },
+        { SDLK_J, PenguinKey::KEY_J },
+        { SDLK_K, PenguinKey::KEY_K },
+        { SDLK_L, PenguinKey::KEY_L },
+        { SDLK_M, PenguinKey::KEY_M },
+        { SDLK_N, PenguinKey::KEY_N },
+        { SDLK_O, PenguinKey::KEY_O },
+        { SDLK_P, PenguinKey::KEY_P },
+        { SDLK_Q, PenguinKey::KEY_Q },
+        { SDLK_R, PenguinKey::KEY_R },
+        { SDLK_S, PenguinKey::KEY_S },
+        { SDLK_T, PenguinKey::KEY_T },
+        { SDLK_U, PenguinKey::KEY_U },
+        { SDLK_V, PenguinKey::KEY_V },
+        { SDLK_W, PenguinKey::KEY_W },
+        { SDLK_X, PenguinKey::KEY_X },
+        { SDLK_Y, PenguinKey::KEY_Y },
+        { SDLK_Z, PenguinKey::KEY_Z },
+        { SDLK_DELETE, PenguinKey::DELETE },
+        { SDLK_PLUSMINUS, PenguinKey::PLUSMINUS },
+        { SDLK_CAPSLOCK, PenguinKey::CAPSLOCK },
+        { SDLK_F1, PenguinKey::KEY_F1 },
+        { SDLK_F2, PenguinKey::KEY_F2 },
+        { SDLK_F3, PenguinKey::KEY_F3 },
+        { SDLK_F4, PenguinKey::KEY_F4 },
+        { SDLK_F5, PenguinKey::KEY_F5 },
+        { SDLK_F6, PenguinKey::KEY_F6 },
+        { SDLK_F7, PenguinKey::KEY_F7 },
+        { SDLK_F8, PenguinKey::KEY_F8 },
+        { SDLK_F9, PenguinKey::KEY_F9 },
+        { SDLK_F10, PenguinKey::KEY_F10 },
+        { SDLK_F11, PenguinKey::KEY_F11 },
+        { SDLK_F12, PenguinKey::KEY_F12 },
+        { SDLK_PRINTSCREEN, PenguinKey::PRINT_SCREEN },
+        { SDLK_SCROLLLOCK, PenguinKey::SCROLL_LOCK },
+        { SDLK_PAUSE, PenguinKey::PAUSE },
+        { SDLK_INSERT, PenguinKey::INSERT },
+        { SDLK_HOME, PenguinKey::HOME },
+        { SDLK_PAGEUP, PenguinKey::PAGE_UP },
+        { SDLK_PAGEDOWN, PenguinKey::PAGE_DOWN },
+        { SDLK_END, PenguinKey::END },
+        { SDLK_RIGHT, PenguinKey::RIGHT },
+        { SDLK_LEFT, PenguinKey::LEFT },
+        { SDLK_DOWN, PenguinKey::DOWN },
+        { SDLK_UP, PenguinKey::UP },
+        { SDLK_KP_DIVIDE, PenguinKey::KEYPAD_DIVIDE },
+        { SDLK_KP_MULTIPLY, PenguinKey::KEYPAD_MULTIPLY },
+        { SDLK_KP_MINUS, PenguinKey::KEYPAD_MINUS },
+        { SDLK_KP_PLUS, PenguinKey::KEYPAD_PLUS },
+        { SDLK_KP_ENTER, PenguinKey::KEYPAD_ENTER },
+        { SDLK_KP_0, PenguinKey::KEYPAD_0 },
+        { SDLK_KP_1, PenguinKey::KEYPAD_1 },
+        { SDLK_KP_2, PenguinKey::KEYPAD_2 },
+        { SDLK_KP_3, PenguinKey::KEYPAD_3 },
+        { SDLK_KP_4, PenguinKey::KEYPAD_4 },
+        { SDLK_KP_5, PenguinKey::KEYPAD_5 },
+        { SDLK_KP_6, PenguinKey::KEYPAD_6 },
+        { SDLK_KP_7, PenguinKey::KEYPAD_7 },
+        { SDLK_KP_8, PenguinKey::KEYPAD_8 },
+        { SDLK_KP_9, PenguinKey::KEYPAD_9 },
+        { SDLK_KP_PERIOD, PenguinKey::KEYPAD_PERIOD },
+        { SDLK_KP_EQUALS, PenguinKey::KEYPAD_EQUAL_SIGN },
+        { SDLK_APPLICATION, PenguinKey::APPLICATION },
+        { SDLK_UNDO, PenguinKey::UNDO },
+        { SDLK_CUT, PenguinKey::CUT },
+        { SDLK_COPY, PenguinKey::COPY },
+        { SDLK_PASTE, PenguinKey::PASTE },
+        { SDLK_FIND, PenguinKey::FIND },
+        { SDLK_MUTE, PenguinKey::MUTE },
+        { SDLK_VOLUMEUP, PenguinKey::VOLUME_UP },
+        { SDLK_VOLUMEDOWN, PenguinKey::VOLUME_DOWN },
+        { SDLK_ALTERASE, PenguinKey::ALT_ERASE },
+        { SDLK_CANCEL, PenguinKey::CANCEL },
+        { SDLK_CLEAR, PenguinKey::CLEAR },
+        { SDLK_LCTRL, PenguinKey::LCTRL },
+        { SDLK_LSHIFT, PenguinKey::LSHIFT },
+        { SDLK_LALT, PenguinKey::LALT },
+        { SDLK_LGUI, PenguinKey::LGUI },
+        { SDLK_RCTRL, PenguinKey::RCTRL },
+        { SDLK_RSHIFT, PenguinKey::RSHIFT },
+        { SDLK_RALT, PenguinKey::RALT },
+        { SDLK_RGUI, PenguinKey::RGUI },
+    };
+
+    constexpr size_t CHARACTER_KEYCODES = 256; /// Keycodes below this are characters.
+    constexpr size_t KEY_TABLE_SIZE = CHARACTER_KEYCODES + SDL_SCANCODE_COUNT; /// A slot for each character, then for each scancode.
+    constexpr uint8_t NO_KEY = UINT8_MAX; /// Marks a keycode with no PenguinKey.
+
+    static_assert(PenguinInput::KEY_COUNT < NO_KEY, "PenguinKey values must fit in the key table.");
+
+    /// @brief Gets the slot of a keycode in the key table.
+    /// @param keycode: The SDL keycode.
+    /// @return The slot, or KEY_TABLE_SIZE if the keycode has none.
+    constexpr size_t get_table_index(SDL_Keycode keycode) {
+        if (keycode < CHARACTER_KEYCODES) {
+            return keycode;
+        }
+        if ((keycode & SDLK_SCANCODE_MASK) != 0 && (keycode & ~SDLK_SCANCODE_MASK) < SDL_SCANCODE_COUNT) {
+            return CHARACTER_KEYCODES + (keycode & ~SDLK_SCANCODE_MASK);
+        }
+        return KEY_TABLE_SIZE;
+    }
+
+    /// The PenguinKey of each keycode slot, or NO_KEY. A keycode without a slot fails to compile.
+    constexpr std::array<uint8_t, KEY_TABLE_SIZE> KEY_TABLE = []() {
+        std::array<uint8_t, KEY_TABLE_SIZE> table{};
+        for (uint8_t& entry : table) {
+            entry = NO_KEY;
+        }
+        for (const KeyMapping& mapping : KEY_MAP) {
+            table[get_table_index(mapping.keycode)] = (uint8_t)mapping.key;
+        }
+        return table;
+    }();
+
+    static_assert(KEY_TABLE[get_table_index(SDLK_A)] == (uint8_t)PenguinKey::KEY_A, "The key table must map SDL keycodes to PenguinKeys.");
+}
+
 /// @brief Handles key press and release events.
 ///
 /// This function updates the key state based on whether a key was pressed or
-/// released. If the key is not mapped in key_map, an exception is thrown.
+/// released, and records the change for the next update step. Repeated key down
+/// events of a held key are not counted as presses. If the key has no PenguinKey,
+/// an exception is thrown.
 /// @param p_event: The SDL event containing the key that was pressed or released.
 void PenguinInput::handle_input_event(const SDL_Event& p_event) {
-    if (p_event.type == SDL_EVENT_KEY_DOWN) {
-        auto it = key_map.find(p_event.key.key); // Maps SDL key to PenguinKey
-        if (it != key_map.end()) {
-            key_pressed_states[it->second] = p_event.key.down; // The key was pressed
-        }
-
-        // Otherwise, we throw an exception to indicate that the key pressed has no mapping to a PenguinKey.
-        Exception::throw_if(
-            it == key_map.end(),
-            "The following key is not supported.",
-            INPUT_ERROR
-        );
+    if (p_event.type != SDL_EVENT_KEY_DOWN && p_event.type != SDL_EVENT_KEY_UP) {
+        return;
     }
-    else if (p_event.type == SDL_EVENT_KEY_UP) {
-        auto it = key_map.find(p_event.key.key); // Maps SDL key to PenguinKey
-        if (it != key_map.end()) {
-            key_pressed_states[it->second] = false; // The key was released
-        }
 
-        // Otherwise, we throw an exception to indicate that the key pressed has no mapping to a PenguinKey.
-        Exception::throw_if(
-            it == key_map.end(),
-            "The following key is not supported.",
-            INPUT_ERROR
-        );
+    size_t index = get_table_index(p_event.key.key); // Maps SDL key to PenguinKey
+    uint8_t key = index < KEY_TABLE_SIZE ? KEY_TABLE[index] : NO_KEY;
+
+    // Throw an exception to indicate that the key pressed has no mapping to a PenguinKey.
+    Exception::throw_if(
+        key == NO_KEY,
+        "The following key is not supported.",
+        INPUT_ERROR
+    );
+
+    bool down = p_event.type == SDL_EVENT_KEY_DOWN && p_event.key.down;
+    if (down && !key_states.test(key)) {
+        pressed_keys.set(key);
+    }
+    else if (!down && key_states.test(key)) {
+        released_keys.set(key);
     }
+    key_states.set(key, down);
 }
 
-/// @brief Checks if a specific key is currently pressed.
-/// 
-/// This function returns whether a specific key is currently in a pressed state.
-/// @param key: The key to check.
-/// @return True if the key is pressed, false otherwise.
-bool PenguinInput::is_key_pressed(PenguinKey key) {
-    auto it = key_pressed_states.find(key);
-    return it != key_pressed_states.end() && it->second; // true and false == false, true and true == true
+/// @brief Makes the key presses and releases handled since the last step visible to the next update step.
+void PenguinInput::begin_step() {
+    step_pressed_keys = pressed_keys;
+    step_released_keys = released_keys;
+    pressed_keys.reset();
+    released_keys.reset();
 }
-
-/// @brief Checks if any key is currently pressed.
-/// 
-/// This function iterates through the key states and returns true if any key 
-/// is currently in a pressed state.
-/// @return True if any key is pressed, false otherwise.
-bool PenguinInput::is_any_key_pressed() {
-    for (const auto& key_pair : key_pressed_states) {
-        if (key_pair.second) { // Check if any value (key state) is true
-            return true;
-        }
-    }
-    return false;
-}
\ No newline at end of file
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_interpolation_store.cpp                                       ///
+///                                                                             ///
+/// PenguinInterpolationStore keeps the previous and current positions in two   ///
+/// Vector2Arrays, so begin_step() is a copy and interpolate() a single batch   ///
+/// lerp. interpolate() also copies the ids and slots, so the render positions  ///
+/// can be looked up by id while update() adds and removes objects.             ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_interpolation_store.hpp"
+#include "exception.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <string>
+
+using namespace Penguin2D;
+
+/// @brief Adds an object. It is drawn at this position until it moves.
+///
+/// If the id is already in the store, an exception is thrown.
+///
+/// @param id: The id of the object.
+/// @param position: The position of the object.
+void PenguinInterpolationStore::add(PenguinInterpolationId id, Vector2<float> position) {
+	Exception::throw_if(id == NO_SLOT, "The interpolation id " + std::to_string(id) + " is reserved.", RUNTIME_ERROR);
+	if (id >= slots.size()) {
+		slots.resize((size_t)id + 1, NO_SLOT);
+	}
+	Exception::throw_if(slots[id] != NO_SLOT, "The object " + std::to_string(id) + " is already in the interpolation store.", RUNTIME_ERROR);
+
+	slots[id] = (uint32_t)ids.size();
+	ids.push_back(id);
+	previous_positions.push_back(position);
+	current_positions.push_back(position);
+}
+
+/// @brief Removes an object.
+///
+/// If the id is not in the store, an exception is thrown.
+///
+/// @param id: The id of the object.
+void PenguinInterpolationStore::remove(PenguinInterpolationId id) {
+	uint32_t slot = get_slot(id);
+	uint32_t last = (uint32_t)ids.size() - 1;
+
+	// Keep the objects packed by moving the last one into the gap.
+	if (slot != last) {
+		ids[slot] = ids[last];
+		previous_positions.set(slot, previous_positions.get(last));
+		current_positions.set(slot, current_positions.get(last));
+		slots[ids[slot]] = slot;
+	}
+	ids.pop_back();
+	previous_positions.resize(last);
+	current_positions.resize(last);
+	slots[id] = NO_SLOT;
+}
+
+/// @brief Checks if an object is in the store.
+/// @param id: The id of the object.
+/// @return bool: True if the object is in the store, otherwise false.
+bool PenguinInterpolationStore::contains(PenguinInterpolationId id) const {
+	return id < slots.size() && slots[id] != NO_SLOT;
+}
+
+/// @brief Removes every object, including their render positions.
+void PenguinInterpolationStore::clear() {
+	ids.clear();
+	slots.clear();
+	previous_positions.clear();
+	current_positions.clear();
+	render_ids.clear();
+	render_slots.clear();
+	render_positions.clear();
+}
+
+/// @brief Sets the current position of an object. It is drawn moving there from its previous position.
+///
+/// If the id is not in the store, an exception is thrown.
+///
+/// @param id: The id of the object.
+/// @param position: The new position of the object.
+void PenguinInterpolationStore::set_position(PenguinInterpolationId id, Vector2<float> position) {
+	current_positions.set(get_slot(id), position);
+}
+
+/// @brief Moves an object without drawing it in between, by setting its previous position too.
+///
+/// If the id is not in the store, an exception is thrown.
+///
+/// @param id: The id of the object.
+/// @param position: The new position of the object.
+void PenguinInterpolationStore::teleport(PenguinInterpolationId id, Vector2<float> position) {
+	uint32_t slot = get_slot(id);
+	previous_positions.set(slot, position);
+	current_positions.set(slot, position);
+}
+
+/// @brief Gets the current position of an object, as last set.
+///
+/// If the id is not in the store, an exception is thrown.
+///
+/// @param id: The id of the object.
+/// @return Vector2<float>: The current position.
+Vector2<float> PenguinInterpolationStore::get_position(PenguinInterpolationId id) const {
+	return current_positions.get(get_slot(id));
+}
+
+/// @brief Keeps the current positions as the previous ones.
+void PenguinInterpolationStore::begin_step() {
+	previous_positions = current_positions;
+}
+
+/// @brief Computes the render positions, and copies the ids so they can be looked up during draw().
+/// @param alpha: How far the frame is between the previous and current positions, clamped to 0 to 1.
+void PenguinInterpolationStore::interpolate(double alpha) {
+	render_ids = ids;
+	render_slots = slots;
+	render_positions.resize(ids.size());
+	render_positions.lerp(previous_positions, current_positions, (float)std::clamp(alpha, 0.0, 1.0));
+}
+
+/// @brief Gets the render position of an object, as of the last interpolate().
+///
+/// If the object was not in the store at the last interpolate(), an exception is thrown.
+///
+/// @param id: The id of the object.
+/// @return Vector2<float>: The interpolated position.
+Vector2<float> PenguinInterpolationStore::get_render_position(PenguinInterpolationId id) const {
+	Exception::throw_if(id >= render_slots.size() || render_slots[id] == NO_SLOT,
+		"The object " + std::to_string(id) + " has no render position in the interpolation store.", RUNTIME_ERROR);
+	return render_positions.get(render_slots[id]);
+}
+
+/// @brief Gets the index of an object in the packed objects.
+///
+/// If the id is not in the store, an exception is thrown.
+///
+/// @param id: The id of the object.
+/// @return uint32_t: The index of the object.
+uint32_t PenguinInterpolationStore::get_slot(PenguinInterpolationId id) const {
+	Exception::throw_if(!contains(id), "The object " + std::to_string(id) + " is not in the interpolation store.", RUNTIME_ERROR);
+	return slots[id];
+}
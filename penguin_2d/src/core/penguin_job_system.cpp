@@ -0,0 +1,339 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_job_system.cpp                                                ///
+///                                                                             ///
+/// PenguinJobSystem runs jobs on a pool of worker threads. Each worker owns a  ///
+/// queue and steals from the others when its own runs dry, and threads that    ///
+/// wait for jobs run queued jobs instead of blocking.                          ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_job_system.hpp"
+
+using namespace Penguin2D;
+
+namespace {
+
+	/// @brief The job system and queue of the calling thread, if it is a worker.
+	struct CurrentWorker {
+		const PenguinJobSystem* system = nullptr;
+		size_t queue_index = 0;
+	};
+
+	thread_local CurrentWorker current_worker;
+}
+
+/// @brief Constructs a PenguinJobSystem and starts its workers.
+/// @param worker_count: The number of worker threads, or 0 to size the pool from the hardware concurrency.
+PenguinJobSystem::PenguinJobSystem(size_t worker_count) {
+	if (worker_count == 0) {
+		// The thread that waits on jobs also runs them, so it takes the place of one worker.
+		unsigned int hardware_threads = std::thread::hardware_concurrency();
+		worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+	}
+
+	this->worker_count = worker_count;
+	queues = std::make_unique<WorkerQueue[]>(worker_count + 1);
+	stats_start = std::chrono::steady_clock::now();
+
+	workers.reserve(worker_count);
+	for (size_t index = 0; index < worker_count; index++) {
+		workers.emplace_back(&PenguinJobSystem::worker_loop, this, index);
+	}
+}
+
+/// @brief Runs every queued job and joins the workers.
+///
+/// Exceptions thrown by jobs that were never waited on are discarded.
+PenguinJobSystem::~PenguinJobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stopping = true;
+	}
+	work_available.notify_all();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+/// @brief Queues a job that is only tracked by wait_all().
+/// @param job: The job to run.
+void PenguinJobSystem::run(PenguinJob job) {
+	unfinished_tasks.fetch_add(1, std::memory_order_relaxed);
+	submit(Task{ std::move(job), nullptr });
+}
+
+/// @brief Queues a job tracked by a counter.
+/// @param job: The job to run.
+/// @param counter: The counter tracking the job.
+void PenguinJobSystem::run(PenguinJob job, PenguinJobCounter& counter) {
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+	unfinished_tasks.fetch_add(1, std::memory_order_relaxed);
+	submit(Task{ std::move(job), &counter });
+}
+
+/// @brief Queues a job once every job tracked by another counter has finished.
+///
+/// If the dependency has already finished, the job is queued straight away. Otherwise
+/// it is kept on the dependency and queued by whichever thread finishes its last job.
+///
+/// @param dependency: The counter to wait for.
+/// @param job: The job to run.
+/// @param counter: The counter tracking the job.
+void PenguinJobSystem::run_after(PenguinJobCounter& dependency, PenguinJob job, PenguinJobCounter& counter) {
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+	unfinished_tasks.fetch_add(1, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(dependency.mutex);
+		if (dependency.pending.load(std::memory_order_acquire) > 0) {
+			dependency.continuations.push_back(PenguinJobCounter::Continuation{ std::move(job), &counter });
+			return;
+		}
+	}
+	submit(Task{ std::move(job), &counter });
+}
+
+/// @brief Runs queued jobs until every job tracked by a counter has finished.
+/// @param counter: The counter to wait for.
+/// @throws The first exception thrown by a job tracked by the counter, if any.
+void PenguinJobSystem::wait(PenguinJobCounter& counter) {
+	while (counter.pending.load(std::memory_order_acquire) > 0) {
+		if (!run_one_job()) {
+			std::this_thread::yield();
+		}
+	}
+
+	// The last job decrements the counter while holding its mutex, so taking the mutex here
+	// also guarantees that job is done with the counter before the caller can destroy it.
+	std::exception_ptr counter_error;
+	{
+		std::lock_guard<std::mutex> lock(counter.mutex);
+		counter_error = counter.error;
+		counter.error = nullptr;
+	}
+	if (counter_error) {
+		std::rethrow_exception(counter_error);
+	}
+}
+
+/// @brief Runs queued jobs until every job submitted to the system has finished.
+///
+/// This must not be called from a job, as the calling job would wait for itself.
+///
+/// @throws The first exception thrown by an untracked job, if any.
+void PenguinJobSystem::wait_all() {
+	while (unfinished_tasks.load(std::memory_order_acquire) > 0) {
+		if (!run_one_job()) {
+			std::this_thread::yield();
+		}
+	}
+
+	std::exception_ptr untracked_error;
+	{
+		std::lock_guard<std::mutex> lock(error_mutex);
+		untracked_error = error;
+		error = nullptr;
+	}
+	if (untracked_error) {
+		std::rethrow_exception(untracked_error);
+	}
+}
+
+/// @brief Gets the number of worker threads.
+/// @return size_t: The number of worker threads.
+size_t PenguinJobSystem::get_worker_count() const {
+	return worker_count;
+}
+
+/// @brief Gets how much work each thread has done since the statistics were reset.
+/// @return std::vector<PenguinWorkerStats>: One entry per worker, then one for threads outside the pool.
+std::vector<PenguinWorkerStats> PenguinJobSystem::get_worker_stats() const {
+	double elapsed_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - stats_start).count();
+
+	std::vector<PenguinWorkerStats> all_stats(worker_count + 1);
+	for (size_t index = 0; index <= worker_count; index++) {
+		const WorkerQueue& queue = queues[index];
+		uint64_t busy_ns = queue.busy_ns.load(std::memory_order_relaxed);
+
+		PenguinWorkerStats& stats = all_stats[index];
+		stats.jobs_run = (size_t)queue.jobs_run.load(std::memory_order_relaxed);
+		stats.jobs_stolen = (size_t)queue.jobs_stolen.load(std::memory_order_relaxed);
+		stats.busy_ms = busy_ns / 1.0e6;
+		stats.utilisation = elapsed_ns > 0.0 ? std::min(1.0, busy_ns / elapsed_ns) : 0.0;
+	}
+	return all_stats;
+}
+
+/// @brief Resets the statistics of every thread.
+void PenguinJobSystem::reset_stats() {
+	for (size_t index = 0; index <= worker_count; index++) {
+		queues[index].jobs_run.store(0, std::memory_order_relaxed);
+		queues[index].jobs_stolen.store(0, std::memory_order_relaxed);
+		queues[index].busy_ns.store(0, std::memory_order_relaxed);
+	}
+	stats_start = std::chrono::steady_clock::now();
+}
+
+/// @brief Pushes a task onto the calling thread's queue and wakes a sleeping worker.
+/// @param task: The task to queue. It must already be counted as unfinished.
+void PenguinJobSystem::submit(Task task) {
+	WorkerQueue& queue = queues[get_current_queue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+	}
+	queued_tasks.fetch_add(1, std::memory_order_release);
+
+	// Taking the sleep mutex orders this push before any worker's check of queued_tasks, so no wake-up is lost.
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+	}
+	work_available.notify_one();
+}
+
+/// @brief Takes the next task for a queue's owner.
+///
+/// The owner's own queue is used newest first, as its newest tasks are the most likely
+/// to still be in cache. The shared queue and other workers' queues are used oldest first.
+///
+/// @param queue_index: The queue of the calling thread.
+/// @param task: Receives the task.
+/// @param stolen: Set to true if the task was taken from another worker's queue.
+/// @return bool: True if a task was found, otherwise false.
+bool PenguinJobSystem::find_task(size_t queue_index, Task& task, bool& stolen) {
+	if (queue_index < worker_count) {
+		WorkerQueue& own_queue = queues[queue_index];
+		std::lock_guard<std::mutex> lock(own_queue.mutex);
+		if (!own_queue.tasks.empty()) {
+			task = std::move(own_queue.tasks.back());
+			own_queue.tasks.pop_back();
+			queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+			stolen = false;
+			return true;
+		}
+	}
+
+	WorkerQueue& shared_queue = queues[worker_count];
+	{
+		std::lock_guard<std::mutex> lock(shared_queue.mutex);
+		if (!shared_queue.tasks.empty()) {
+			task = std::move(shared_queue.tasks.front());
+			shared_queue.tasks.pop_front();
+			queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+			stolen = false;
+			return true;
+		}
+	}
+
+	for (size_t offset = 1; offset <= worker_count; offset++) {
+		size_t victim = (queue_index + offset) % worker_count;
+		if (victim == queue_index) {
+			continue;
+		}
+
+		WorkerQueue& victim_queue = queues[victim];
+		std::lock_guard<std::mutex> lock(victim_queue.mutex);
+		if (!victim_queue.tasks.empty()) {
+			task = std::move(victim_queue.tasks.front());
+			victim_queue.tasks.pop_front();
+			queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+			stolen = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+/// @brief Runs a task and records it in the statistics of the running thread's queue.
+/// @param queue_index: The queue of the calling thread.
+/// @param task: The task to run.
+/// @param stolen: Whether the task was taken from another worker's queue.
+void PenguinJobSystem::execute(size_t queue_index, Task& task, bool stolen) {
+	auto start = std::chrono::steady_clock::now();
+	std::exception_ptr job_error;
+	try {
+		task.job();
+	}
+	catch (...) {
+		job_error = std::current_exception();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	WorkerQueue& queue = queues[queue_index];
+	queue.jobs_run.fetch_add(1, std::memory_order_relaxed);
+	queue.jobs_stolen.fetch_add(stolen ? 1 : 0, std::memory_order_relaxed);
+	queue.busy_ns.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+
+	// Release the job's captures before its counter is signalled, as they may refer to the waiter's frame.
+	task.job = nullptr;
+	finish(task.counter, job_error);
+}
+
+/// @brief Marks a task as finished, releasing any jobs that depended on its counter.
+/// @param counter: The counter tracking the task, or nullptr.
+/// @param job_error: The exception thrown by the task, if any.
+void PenguinJobSystem::finish(PenguinJobCounter* counter, std::exception_ptr job_error) {
+	if (counter) {
+		std::vector<PenguinJobCounter::Continuation> released;
+		{
+			std::lock_guard<std::mutex> lock(counter->mutex);
+			if (job_error && !counter->error) {
+				counter->error = job_error;
+			}
+			if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				released.swap(counter->continuations);
+			}
+		}
+
+		// The counter may be destroyed by its waiter from here on, so it is not touched again.
+		for (PenguinJobCounter::Continuation& continuation : released) {
+			submit(Task{ std::move(continuation.job), continuation.counter });
+		}
+	}
+	else if (job_error) {
+		std::lock_guard<std::mutex> lock(error_mutex);
+		if (!error) {
+			error = job_error;
+		}
+	}
+
+	unfinished_tasks.fetch_sub(1, std::memory_order_release);
+}
+
+/// @brief Runs a single queued job on the calling thread, if there is one.
+/// @return bool: True if a job was run, otherwise false.
+bool PenguinJobSystem::run_one_job() {
+	size_t queue_index = get_current_queue();
+	Task task;
+	bool stolen = false;
+	if (!find_task(queue_index, task, stolen)) {
+		return false;
+	}
+
+	execute(queue_index, task, stolen);
+	return true;
+}
+
+/// @brief Runs jobs until the system stops, sleeping while the queues are empty.
+/// @param index: The index of the worker's queue.
+void PenguinJobSystem::worker_loop(size_t index) {
+	current_worker = CurrentWorker{ this, index };
+
+	while (true) {
+		if (run_one_job()) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		work_available.wait(lock, [this] { return queued_tasks.load(std::memory_order_acquire) > 0 || stopping; });
+		if (stopping && queued_tasks.load(std::memory_order_acquire) == 0) {
+			return;
+		}
+	}
+}
+
+/// @brief Gets the queue of the calling thread.
+/// @return size_t: The worker's own queue, or the shared queue for threads outside the pool.
+size_t PenguinJobSystem::get_current_queue() const {
+	return current_worker.system == this ? current_worker.queue_index : worker_count;
+}
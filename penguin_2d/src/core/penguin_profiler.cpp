@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_profiler.cpp                                             ///
+///                                                                             ///
+/// PenguinProfiler records timing zones into a lock-free ring buffer and       ///
+/// reports per-zone percentiles and Chrome trace files from it.                ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_profiler.hpp"
+#include "json_escape.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <map>
+
+using namespace Penguin2D;
+
+/// @brief Constructs a PenguinProfiler.
+/// @param capacity: The number of zones kept, rounded up to a power of two.
+PenguinProfiler::PenguinProfiler(size_t capacity)
+	: epoch(std::chrono::steady_clock::now()),
+	slots(new Slot[std::bit_ceil(std::max<size_t>(capacity, 2))]),
+	mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1) {
+}
+
+/// @brief Enables or disables recording.
+/// @param enable: True to record zones, otherwise false.
+void PenguinProfiler::set_enabled(bool enable) {
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+/// @brief Records a completed zone.
+///
+/// The slot is marked as being written before its fields change, so a concurrent
+/// reader can tell a finished zone from one that is being overwritten.
+///
+/// @param name: The name of the zone.
+/// @param start_ns: When the zone opened.
+/// @param end_ns: When the zone closed.
+void PenguinProfiler::record(const char* name, uint64_t start_ns, uint64_t end_ns) {
+	uint64_t index = write_index.fetch_add(1, std::memory_order_relaxed);
+	Slot& slot = slots[index & mask];
+
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start_ns.store(start_ns, std::memory_order_relaxed);
+	slot.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+	slot.thread.store(get_thread_id(), std::memory_order_relaxed);
+	slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+/// @brief Reads every completed zone in the recorded window, oldest first.
+///
+/// Slots that are being written, or were overwritten while being read, are skipped.
+///
+/// @return std::vector<PenguinZoneRecord>: The recorded zones.
+std::vector<PenguinZoneRecord> PenguinProfiler::get_records() const {
+	uint64_t end = write_index.load(std::memory_order_acquire);
+	uint64_t capacity = mask + 1;
+	uint64_t begin = std::max(cleared_index.load(std::memory_order_relaxed), end > capacity ? end - capacity : 0);
+
+	std::vector<PenguinZoneRecord> records;
+	records.reserve((size_t)(end - begin));
+	for (uint64_t index = begin; index < end; index++) {
+		const Slot& slot = slots[index & mask];
+		uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != index + 1) {
+			continue;
+		}
+
+		PenguinZoneRecord record{
+			slot.name.load(std::memory_order_relaxed),
+			slot.start_ns.load(std::memory_order_relaxed),
+			slot.duration_ns.load(std::memory_order_relaxed),
+			slot.thread.load(std::memory_order_relaxed)
+		};
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == sequence && record.name) {
+			records.push_back(record);
+		}
+	}
+	return records;
+}
+
+/// @brief Gets the durations of a zone over the recorded window.
+/// @param name: The name of the zone.
+/// @return PenguinZoneStats: The zone's statistics.
+PenguinZoneStats PenguinProfiler::get_zone_stats(const std::string& name) const {
+	std::vector<uint64_t> durations;
+	for (const PenguinZoneRecord& record : get_records()) {
+		if (name == record.name) {
+			durations.push_back(record.duration_ns);
+		}
+	}
+	return compute_stats(name, durations);
+}
+
+/// @brief Gets the durations of every zone over the recorded window.
+/// @return std::vector<PenguinZoneStats>: The statistics of each zone, sorted by name.
+std::vector<PenguinZoneStats> PenguinProfiler::get_all_zone_stats() const {
+	std::map<std::string, std::vector<uint64_t>> durations_by_zone;
+	for (const PenguinZoneRecord& record : get_records()) {
+		durations_by_zone[record.name].push_back(record.duration_ns);
+	}
+
+	std::vector<PenguinZoneStats> all_stats;
+	for (auto& [name, durations] : durations_by_zone) {
+		all_stats.push_back(compute_stats(name, durations));
+	}
+	return all_stats;
+}
+
+/// @brief Writes the recorded window as a Chrome trace event file.
+///
+/// Each zone is written as a complete ("X") event with microsecond timestamps, with its
+/// name escaped so any zone name gives a valid file. If the file cannot be opened, an exception is thrown.
+///
+/// @param path: The file path to write to.
+void PenguinProfiler::write_chrome_trace(const std::string& path) const {
+	std::ofstream file(path);
+	Exception::throw_if(!file, "The trace file could not be opened: " + path, RUNTIME_ERROR);
+
+	std::vector<PenguinZoneRecord> records = get_records();
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	for (size_t i = 0; i < records.size(); i++) {
+		const PenguinZoneRecord& record = records[i];
+		file << "{\"name\":\"" << json_escape(record.name) << "\",\"cat\":\"penguin\",\"ph\":\"X\""
+			<< ",\"ts\":" << record.start_ns / 1000.0
+			<< ",\"dur\":" << record.duration_ns / 1000.0
+			<< ",\"pid\":1,\"tid\":" << record.thread << "}"
+			<< (i + 1 < records.size() ? ",\n" : "\n");
+	}
+	file << "]}\n";
+}
+
+/// @brief Discards every recorded zone.
+void PenguinProfiler::clear() {
+	cleared_index.store(write_index.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+/// @brief Gets a small id for the calling thread, assigned in the order threads first record a zone.
+/// @return The id of the thread.
+uint32_t PenguinProfiler::get_thread_id() {
+	static std::atomic<uint32_t> next_thread_id{ 0 };
+	thread_local uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+	return thread_id;
+}
+
+/// @brief Computes the statistics of a zone from its durations.
+/// @param name: The name of the zone.
+/// @param durations: The durations of the zone in nanoseconds. They are sorted in place.
+/// @return The zone's statistics.
+PenguinZoneStats PenguinProfiler::compute_stats(const std::string& name, std::vector<uint64_t>& durations) {
+	PenguinZoneStats stats;
+	stats.name = name;
+	stats.count = durations.size();
+	if (durations.empty()) {
+		return stats;
+	}
+
+	std::sort(durations.begin(), durations.end());
+	auto percentile = [&](double fraction) {
+		size_t rank = (size_t)std::ceil(fraction * durations.size());
+		return durations[std::clamp<size_t>(rank, 1, durations.size()) - 1] / 1.0e6;
+	};
+
+	uint64_t total = 0;
+	for (uint64_t duration : durations) {
+		total += duration;
+	}
+
+	stats.mean_ms = total / 1.0e6 / durations.size();
+	stats.p50_ms = percentile(0.50);
+	stats.p99_ms = percentile(0.99);
+	stats.max_ms = durations.back() / 1.0e6;
+	return stats;
+}
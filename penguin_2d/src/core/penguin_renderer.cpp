@@ -3,12 +3,23 @@
 ///                                                                             ///
 /// This file implements the PenguinRenderer class, which provides a set of		///
 /// functions for rendering shapes, lines, and pixels using SDL.				///
+///                                                                             ///
+/// In the BATCHED and SORTED render modes, primitives are recorded into a		///
+/// command buffer and submitted in flush() as merged SDL_RenderPoints,		///
+/// SDL_RenderRects, SDL_RenderFillRects and SDL_RenderGeometry calls.			///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "penguin_renderer.hpp"
 
 using namespace Penguin2D;
 
+/// @brief Converts a Colour into the floating point colour used by SDL vertices.
+/// @param colour: The colour to convert.
+/// @return The colour with each component in the range [0, 1].
+static SDL_FColor to_vertex_colour(Colour colour) {
+	return SDL_FColor{ colour.red / 255.0f, colour.green / 255.0f, colour.blue / 255.0f, colour.alpha / 255.0f };
+}
+
 /// @brief Constructs a renderer from the specified window.
 /// 
 /// This function initializes a PenguinRenderer for the given PenguinWindow and driver. 
@@ -20,7 +31,8 @@ PenguinRenderer::PenguinRenderer(PenguinWindow& window, const std::string& drive
 : renderer(SDL_CreateRenderer(
 	window.get_window(),
 	driver_name.empty() ? NULL : driver_name.c_str()), // If empty, allow SDL to handle getting the driver.
-	&SDL_DestroyRenderer) {
+	&SDL_DestroyRenderer),
+	texture_cache(renderer.get()) {
 
 	// Throw an exception if the renderer was not intialized.
 	Exception::throw_if(!renderer, "The renderer was not initialized.", RENDERER_ERROR);
@@ -28,8 +40,18 @@ PenguinRenderer::PenguinRenderer(PenguinWindow& window, const std::string& drive
 
 /// @brief Clears the renderer.
 ///
+/// Any primitives recorded since the last flush are discarded, as they would be
+/// cleared anyway, and the per-frame state change statistics are reset.
 /// If an error occurs during this process, an exception is thrown.
 void PenguinRenderer::clear() {
+	state_changes_issued = 0;
+	state_changes_skipped = 0;
+
+	draw_commands.clear();
+	point_arena.reset();
+	vertex_arena.reset();
+	index_arena.reset();
+
 	reset_colour();
 	Exception::throw_if(
 		!SDL_RenderClear(renderer.get()),
@@ -40,8 +62,10 @@ void PenguinRenderer::clear() {
 
 /// @brief Updates the window with the current rendering content.
 /// 
+/// Any recorded primitives are flushed before presenting.
 /// If an error occurs during this process, an exception is thrown.
 void PenguinRenderer::present() {
+	flush();
 	Exception::throw_if(
 		!SDL_RenderPresent(renderer.get()),
 		"Failed to set present renderer to window.",
@@ -51,13 +75,60 @@ void PenguinRenderer::present() {
 
 /// @brief Sets the drawing colour for rendering objects.
 /// 
+/// The SDL call is skipped if the colour is already bound to the renderer.
+/// If an error occurs while setting the colour, an exception is thrown.
+/// 
 /// @param colour: The colour to set for the renderer.
 void PenguinRenderer::set_colour(Colour colour) {
+	if (bound_colour && *bound_colour == colour) {
+		state_changes_skipped++;
+		return;
+	}
+
+	// Forget the bound colour first, so a failed call leaves the state unknown.
+	bound_colour.reset();
 	Exception::throw_if(
 		!SDL_SetRenderDrawColor(renderer.get(), colour.red, colour.green, colour.blue, colour.alpha),
 		"Failed to set renderer draw colour.",
 		RENDERER_ERROR
 	);
+	bound_colour = colour;
+	state_changes_issued++;
+}
+
+/// @brief Sets the blend mode used when drawing primitives.
+/// 
+/// The SDL call is skipped if the blend mode is already bound to the renderer.
+/// If an error occurs while setting the blend mode, an exception is thrown.
+/// 
+/// @param blend_mode: The SDL blend mode to set.
+void PenguinRenderer::set_blend_mode(SDL_BlendMode blend_mode) {
+	if (bound_blend_mode && *bound_blend_mode == blend_mode) {
+		state_changes_skipped++;
+		return;
+	}
+
+	// Primitives recorded before the change must be drawn with the previous blend mode.
+	flush();
+
+	bound_blend_mode.reset();
+	Exception::throw_if(
+		!SDL_SetRenderDrawBlendMode(renderer.get(), blend_mode),
+		"Failed to set renderer blend mode.",
+		RENDERER_ERROR
+	);
+	bound_blend_mode = blend_mode;
+	state_changes_issued++;
+}
+
+/// @brief Forgets the tracked draw colour and blend mode.
+/// 
+/// The renderer assumes it is the only one changing the SDL draw state. If the state
+/// is changed directly through get_renderer(), this function must be called so the
+/// next colour or blend mode change is sent to SDL.
+void PenguinRenderer::invalidate_state() {
+	bound_colour.reset();
+	bound_blend_mode.reset();
 }
 
 /// @brief Draws a line to the renderer.
@@ -69,6 +140,11 @@ void PenguinRenderer::set_colour(Colour colour) {
 /// @param vect_b: The ending point of the line.
 /// @param colour: The colour of the line to draw (optional, defaults to WHITE).
 void PenguinRenderer::draw_line(Vector2<> vect_a, Vector2<> vect_b, Colour colour) {
+	if (render_mode != PenguinRenderMode::IMMEDIATE) {
+		record_line(vect_a, vect_b, colour);
+		return;
+	}
+
 	set_colour(colour);
 	Exception::throw_if(
 		!SDL_RenderLine(renderer.get(), vect_a.x, vect_a.y, vect_b.x, vect_b.y),
@@ -86,6 +162,12 @@ void PenguinRenderer::draw_line(Vector2<> vect_a, Vector2<> vect_b, Colour colou
 /// @param vect: The coordinates of the pixel to draw.
 /// @param colour: The colour of the pixel (optional, defaults to WHITE).
 void PenguinRenderer::draw_pixel(Vector2<> vect, Colour colour) {
+	if (render_mode != PenguinRenderMode::IMMEDIATE) {
+		point_arena.push_back({ vect.x, vect.y });
+		submit_points(point_arena.size() - 1, 1, colour);
+		return;
+	}
+
 	set_colour(colour);
 	Exception::throw_if(
 		!SDL_RenderPoint(renderer.get(), vect.x, vect.y),
@@ -102,8 +184,13 @@ void PenguinRenderer::draw_pixel(Vector2<> vect, Colour colour) {
 /// @param rect: The rectangle object to draw.
 /// @param outline: The colour of the rectangle's outline (defaults to WHITE).
 void PenguinRenderer::draw_rect(Rect2<float> rect, Colour outline) {
-	set_colour(outline);
 	auto sdl_rect = (SDL_FRect)rect;
+	if (render_mode != PenguinRenderMode::IMMEDIATE) {
+		draw_commands.push_back({ PenguinPrimitive::RECT, outline, sdl_rect, 0, 0 });
+		return;
+	}
+
+	set_colour(outline);
 	Exception::throw_if(
 		!SDL_RenderRect(renderer.get(), &sdl_rect),
 		"Failed to draw the rect to the renderer.",
@@ -120,8 +207,13 @@ void PenguinRenderer::draw_rect(Rect2<float> rect, Colour outline) {
 /// @param rect: The rectangle object to draw.
 /// @param fill: The colour of the rectangle's fill (optional, defaults to WHITE).
 void PenguinRenderer::draw_filled_rect(Rect2<float> rect, Colour fill) {
-	set_colour(fill);
 	auto sdl_rect = (SDL_FRect)rect;
+	if (render_mode != PenguinRenderMode::IMMEDIATE) {
+		draw_commands.push_back({ PenguinPrimitive::FILLED_RECT, fill, sdl_rect, 0, 0 });
+		return;
+	}
+
+	set_colour(fill);
 	Exception::throw_if(
 		!SDL_RenderFillRect(renderer.get(), &sdl_rect),
 		"Failed to draw the filled rect to the renderer.",
@@ -132,65 +224,323 @@ void PenguinRenderer::draw_filled_rect(Rect2<float> rect, Colour fill) {
 /// @brief Draws a circle to the renderer.
 /// 
 /// This function draws a circle at the specified location with the given color.
+/// The outline points are cached by radius, so repeated draws only translate them.
 /// If an error occurs while drawing the circle, an exception is thrown.
 /// 
 /// @param vect: The center coordinates of the circle.
 /// @param radius: The radius of the circle.
 /// @param outline: The colour of the circle's outline (optional, defaults to WHITE).
 void PenguinRenderer::draw_circle(Vector2<float> center, int radius, Colour outline) {
-	// Initial points and decision variable.
-	int x = radius - 1;
-	int y = 0;
-	int dx = 1;
-	int dy = 1;
-	int err = dx - (radius << 1); // (radius << 1 = diameter)
+	const PenguinShapeMesh& mesh = get_shape_mesh({ PenguinShapeKind::CIRCLE, radius, radius, false });
+	submit_outline(mesh, center, outline);
+}
 
-	// Vector for points to be rendered onto screen.
-	std::vector<SDL_FPoint> points;
 
-	// Fill all the 8 octances.
-	while (x >= y) {
-		points.push_back({ center.x + x, center.y + y });
-		points.push_back({ center.x + x, center.y - y });
-		points.push_back({ center.x - x, center.y + y });
-		points.push_back({ center.x - x, center.y - y });
-		points.push_back({ center.x + y, center.y + x });
-		points.push_back({ center.x + y, center.y - x });
-		points.push_back({ center.x - y, center.y + x });
-		points.push_back({ center.x - y, center.y - x });
+/// @brief Draws a filled circle to the renderer.
+/// 
+/// This function draws a filled circle at the specified location as a triangle fan,
+/// submitted with a single SDL_RenderGeometry call (or merged into the current batch
+/// in a deferred render mode). If an error occurs while drawing the filled circle,
+/// an exception is thrown.
+/// 
+/// @param vect: The center coordinates of the circle.
+/// @param radius: The radius of the circle.
+/// @param fill: The colour of the filled circle (optional, defaults to WHITE).
+void PenguinRenderer::draw_filled_circle(Vector2<float> center, int radius, Colour fill) {
+	const PenguinShapeMesh& mesh = get_shape_mesh({ PenguinShapeKind::CIRCLE, radius, radius, true });
+	submit_mesh(mesh, center, fill);
+}
 
-		if (err <= 0) {
-			y++;
-			err += dy;
-			dy += 2;
-		}
+/// @brief Draws an ellipse to the renderer.
+/// 
+/// This function renders an ellipse at the specified position with the given radii.
+/// The outline points are cached by radii, so repeated draws only translate them.
+/// If rendering fails, an exception is thrown.
+/// 
+/// @param center: The center coordinates of the ellipse.
+/// @param radius_x: The horizontal radius of the ellipse.
+/// @param radius_y: The vertical radius of the ellipse.
+/// @param outline: The colour of the ellipse outline (optional, defaults to WHITE).
+void PenguinRenderer::draw_ellipse(Vector2<float> center, int radius_x, int radius_y, Colour outline) {
+	const PenguinShapeMesh& mesh = get_shape_mesh({ PenguinShapeKind::ELLIPSE, radius_x, radius_y, false });
+	submit_outline(mesh, center, outline);
+}
 
-		if (err > 0) {
-			x--;
-			dx += 2;
-			err += dx - (radius << 1);
-		}
+/// @brief Draws a filled ellipse to the renderer.
+/// 
+/// This function renders a filled ellipse at the specified position as a triangle fan,
+/// submitted with a single SDL_RenderGeometry call (or merged into the current batch
+/// in a deferred render mode). If rendering fails, an exception is thrown.
+/// 
+/// @param center: The center coordinates of the ellipse.
+/// @param radius_x: The horizontal radius of the ellipse.
+/// @param radius_y: The vertical radius of the ellipse.
+/// @param fill: The fill colour of the ellipse (optional, defaults to WHITE).
+void PenguinRenderer::draw_filled_ellipse(Vector2<float> center, int radius_x, int radius_y, Colour fill) {
+	const PenguinShapeMesh& mesh = get_shape_mesh({ PenguinShapeKind::ELLIPSE, radius_x, radius_y, true });
+	submit_mesh(mesh, center, fill);
+}
+
+/// @brief Resets the rendering color to the default value.
+/// 
+/// This function resets the renderer's drawing color to black.
+void PenguinRenderer::reset_colour() {
+	set_colour(Colours::BLACK); 
+}
+
+/// @brief Retrieves the underlying SDL renderer.
+/// 
+/// This function provides access to the internal SDL_Renderer pointer used for rendering.
+/// 
+/// @return SDL_Renderer*: A pointer to the SDL_Renderer instance.
+SDL_Renderer* PenguinRenderer::get_renderer() {
+	return renderer.get();
+}
+
+/// @brief Retrieves the texture cache of the renderer.
+///
+/// Sprites loaded from files share their textures through this cache, so each
+/// image is decoded and uploaded once.
+///
+/// @return PenguinTextureCache&: A reference to the renderer's texture cache.
+PenguinTextureCache& PenguinRenderer::get_texture_cache() {
+	return texture_cache;
+}
+
+/// @brief Draws points from the point arena to the renderer, or records them in a deferred render mode.
+/// 
+/// In the IMMEDIATE render mode, the points are released from the arena once drawn.
+/// If an error occurs while drawing the points, an exception is thrown.
+/// 
+/// @param first_point: The index of the first point in the point arena.
+/// @param count: The number of points to draw.
+/// @param colour: The colour of the points.
+void PenguinRenderer::submit_points(size_t first_point, size_t count, Colour colour) {
+	if (render_mode != PenguinRenderMode::IMMEDIATE) {
+		draw_commands.push_back({ PenguinPrimitive::POINTS, colour, SDL_FRect{}, first_point, count });
+		return;
 	}
 
-	// Draw the circle.
-	set_colour(outline);
+	set_colour(colour);
 	Exception::throw_if(
-		!SDL_RenderPoints(renderer.get(), points.data(), points.size()),
-		"Failed to draw a circle to the renderer.",
+		!SDL_RenderPoints(renderer.get(), point_arena.data() + first_point, (int)count),
+		"Failed to draw points to the renderer.",
 		RENDERER_ERROR
 	);
+	point_arena.rewind(first_point);
 }
 
+/// @brief Records a line as a one pixel wide quad of coloured geometry.
+/// 
+/// Storing lines as geometry lets lines of any colour be merged into a single
+/// SDL_RenderGeometry call when the command buffer is flushed.
+/// 
+/// @param vect_a: The starting point of the line.
+/// @param vect_b: The ending point of the line.
+/// @param colour: The colour of the line.
+void PenguinRenderer::record_line(Vector2<float> vect_a, Vector2<float> vect_b, Colour colour) {
+	// Direction along the line, extended by half a pixel at each end so the end points are covered.
+	float dir_x = vect_b.x - vect_a.x;
+	float dir_y = vect_b.y - vect_a.y;
+	float length = std::sqrt(dir_x * dir_x + dir_y * dir_y);
+	if (length > 0.0f) {
+		dir_x = dir_x / length * 0.5f;
+		dir_y = dir_y / length * 0.5f;
+	}
+	else {
+		dir_x = 0.5f; // A zero length line covers a single pixel.
+		dir_y = 0.0f;
+	}
 
-/// @brief Draws a filled circle to the renderer.
+	// Half pixel offset perpendicular to the line.
+	float normal_x = -dir_y;
+	float normal_y = dir_x;
+
+	// The pixel centres of the end points sit at +0.5, matching SDL_RenderLine.
+	float ax = vect_a.x + 0.5f - dir_x;
+	float ay = vect_a.y + 0.5f - dir_y;
+	float bx = vect_b.x + 0.5f + dir_x;
+	float by = vect_b.y + 0.5f + dir_y;
+
+	SDL_FColor vertex_colour = to_vertex_colour(colour);
+	size_t first_vertex = vertex_arena.size();
+	SDL_Vertex* vertices = vertex_arena.begin_write(4);
+	vertices[0] = { { ax + normal_x, ay + normal_y }, vertex_colour, { 0.0f, 0.0f } };
+	vertices[1] = { { ax - normal_x, ay - normal_y }, vertex_colour, { 0.0f, 0.0f } };
+	vertices[2] = { { bx - normal_x, by - normal_y }, vertex_colour, { 0.0f, 0.0f } };
+	vertices[3] = { { bx + normal_x, by + normal_y }, vertex_colour, { 0.0f, 0.0f } };
+	vertex_arena.end_write(4);
+
+	static constexpr int quad_indices[] = { 0, 1, 2, 0, 2, 3 };
+	submit_geometry(first_vertex, 4, quad_indices, 6, colour);
+}
+
+/// @brief Submits all recorded primitives to the renderer.
 /// 
-/// This function draws a filled circle at the specified location with the given color.
-/// If an error occurs while drawing the filled circle, an exception is thrown.
+/// Recorded primitives are grouped into runs of the same type (and the same colour for
+/// points and rects), and each run is drawn with a single SDL call. In the SORTED render
+/// mode, primitives are sorted by type and colour first so that each run is as long as possible.
+/// If an error occurs while drawing, an exception is thrown.
+void PenguinRenderer::flush() {
+	if (draw_commands.empty()) {
+		return;
+	}
+
+	if (render_mode == PenguinRenderMode::SORTED) {
+		std::stable_sort(draw_commands.begin(), draw_commands.end(), [](const PenguinDrawCommand& a, const PenguinDrawCommand& b) {
+			if (a.primitive != b.primitive) {
+				return a.primitive < b.primitive;
+			}
+			// Geometry is coloured per vertex, so the colour never splits a run.
+			return a.primitive != PenguinPrimitive::GEOMETRY && a.colour.to_rgba() < b.colour.to_rgba();
+		});
+	}
+
+	size_t first_command = 0;
+	while (first_command < draw_commands.size()) {
+		const PenguinDrawCommand& first = draw_commands[first_command];
+		size_t last_command = first_command + 1;
+
+		// Extend the run while the next command can be drawn in the same SDL call.
+		while (last_command < draw_commands.size()) {
+			const PenguinDrawCommand& next = draw_commands[last_command];
+			if (next.primitive != first.primitive || (first.primitive != PenguinPrimitive::GEOMETRY && next.colour != first.colour)) {
+				break;
+			}
+			last_command++;
+		}
+
+		submit_run(first_command, last_command);
+		first_command = last_command;
+	}
+
+	draw_commands.clear();
+	point_arena.reset();
+	vertex_arena.reset();
+	index_arena.reset();
+}
+
+/// @brief Sets how primitives are submitted to the renderer.
+/// 
+/// Any primitives recorded in the previous render mode are flushed first.
+/// 
+/// @param mode: The render mode to use.
+void PenguinRenderer::set_render_mode(PenguinRenderMode mode) {
+	flush();
+	render_mode = mode;
+}
+
+/// @brief Retrieves how primitives are submitted to the renderer.
+/// @return PenguinRenderMode: The current render mode.
+PenguinRenderMode PenguinRenderer::get_render_mode() const {
+	return render_mode;
+}
+
+/// @brief Draws a run of recorded commands that share a primitive type (and colour) with a single SDL call.
+/// 
+/// If an error occurs while drawing, an exception is thrown.
+/// 
+/// @param first_command: The index of the first command in the run.
+/// @param last_command: The index one past the last command in the run.
+void PenguinRenderer::submit_run(size_t first_command, size_t last_command) {
+	const PenguinDrawCommand& first = draw_commands[first_command];
+
+	switch (first.primitive) {
+	case PenguinPrimitive::POINTS:
+		merged_points.reset();
+		for (size_t i = first_command; i < last_command; i++) {
+			merged_points.append(point_arena.data() + draw_commands[i].first, draw_commands[i].count);
+		}
+		set_colour(first.colour);
+		Exception::throw_if(
+			!SDL_RenderPoints(renderer.get(), merged_points.data(), (int)merged_points.size()),
+			"Failed to draw batched points to the renderer.",
+			RENDERER_ERROR
+		);
+		break;
+
+	case PenguinPrimitive::RECT:
+	case PenguinPrimitive::FILLED_RECT:
+		merged_rects.reset();
+		for (size_t i = first_command; i < last_command; i++) {
+			merged_rects.push_back(draw_commands[i].rect);
+		}
+		set_colour(first.colour);
+		if (first.primitive == PenguinPrimitive::RECT) {
+			Exception::throw_if(
+				!SDL_RenderRects(renderer.get(), merged_rects.data(), (int)merged_rects.size()),
+				"Failed to draw batched rects to the renderer.",
+				RENDERER_ERROR
+			);
+		}
+		else {
+			Exception::throw_if(
+				!SDL_RenderFillRects(renderer.get(), merged_rects.data(), (int)merged_rects.size()),
+				"Failed to draw batched filled rects to the renderer.",
+				RENDERER_ERROR
+			);
+		}
+		break;
+
+	case PenguinPrimitive::GEOMETRY:
+		merged_indices.reset();
+		for (size_t i = first_command; i < last_command; i++) {
+			merged_indices.append(index_arena.data() + draw_commands[i].first, draw_commands[i].count);
+		}
+		Exception::throw_if(
+			!SDL_RenderGeometry(renderer.get(), NULL, vertex_arena.data(), (int)vertex_arena.size(), merged_indices.data(), (int)merged_indices.size()),
+			"Failed to draw batched geometry to the renderer.",
+			RENDERER_ERROR
+		);
+		break;
+	}
+}
+
+/// @brief Retrieves the unit circle used to build a fan with the given radii.
+/// 
+/// The number of segments is chosen so that the distance between the fan and the true
+/// ellipse stays under an eighth of a pixel, then rounded up to a power of two so that
+/// radii of a similar size share the same cached table.
+/// 
+/// @param radius_x: The horizontal radius of the shape.
+/// @param radius_y: The vertical radius of the shape.
+/// @return The cached unit circle for the radius bucket.
+const PenguinUnitCircle& PenguinRenderer::get_unit_circle(float radius_x, float radius_y) {
+	constexpr float max_error = 0.125f;
+	float radius = std::max({ radius_x, radius_y, max_error });
+	float step = std::acos(std::max(-1.0f, 1.0f - max_error / radius));
+	int needed = (int)std::ceil(std::numbers::pi_v<float> / step);
+
+	int segments = MIN_CIRCLE_SEGMENTS;
+	while (segments < needed && segments < MAX_CIRCLE_SEGMENTS) {
+		segments <<= 1;
+	}
+
+	auto it = unit_circles.find(segments);
+	if (it != unit_circles.end()) {
+		return it->second;
+	}
+
+	PenguinUnitCircle& unit_circle = unit_circles[segments];
+	unit_circle.points.reserve(segments);
+	unit_circle.fan_indices.reserve(segments * 3);
+	for (int i = 0; i < segments; i++) {
+		float angle = 2.0f * std::numbers::pi_v<float> * i / segments;
+		unit_circle.points.push_back({ std::cos(angle), std::sin(angle) });
+
+		// Vertex 0 is the centre of the fan, the rim starts at vertex 1.
+		unit_circle.fan_indices.push_back(0);
+		unit_circle.fan_indices.push_back(1 + i);
+		unit_circle.fan_indices.push_back(1 + (i + 1) % segments);
+	}
+	return unit_circle;
+}
+
+/// @brief Builds the outline points of a circle around the origin.
 /// 
-/// @param vect: The center coordinates of the circle.
 /// @param radius: The radius of the circle.
-/// @param fill: The colour of the filled circle (optional, defaults to WHITE).
-void PenguinRenderer::draw_filled_circle(Vector2<float> center, int radius, Colour fill) {
+/// @param points: The points to append the outline to.
+void PenguinRenderer::build_circle_outline(int radius, std::vector<SDL_FPoint>& points) {
 	// Initial points and decision variable.
 	int x = radius - 1;
 	int y = 0;
@@ -198,13 +548,19 @@ void PenguinRenderer::draw_filled_circle(Vector2<float> center, int radius, Colo
 	int dy = 1;
 	int err = dx - (radius << 1); // (radius << 1 = diameter)
 
-	while (x >= y) {
-		draw_horizontal_line(center.x - x, center.x + x, center.y + y, fill); // Top span
-		draw_horizontal_line(center.x - x, center.x + x, center.y - y, fill); // Bottom span
+	// Every iteration moves x - y closer to zero by at least one, so at most radius iterations of 8 points are generated.
+	points.reserve(8 * (size_t)std::max(radius, 1));
 
-		// Left and right spans.
-		draw_horizontal_line(center.x - y, center.x + y, center.y + x, fill); // Right span
-		draw_horizontal_line(center.x - y, center.x + y, center.y - x, fill); // Left span
+	// Fill all the 8 octances.
+	while (x >= y) {
+		points.push_back({ (float)x, (float)y });
+		points.push_back({ (float)x, (float)-y });
+		points.push_back({ (float)-x, (float)y });
+		points.push_back({ (float)-x, (float)-y });
+		points.push_back({ (float)y, (float)x });
+		points.push_back({ (float)y, (float)-x });
+		points.push_back({ (float)-y, (float)x });
+		points.push_back({ (float)-y, (float)-x });
 
 		if (err <= 0) {
 			y++;
@@ -218,19 +574,17 @@ void PenguinRenderer::draw_filled_circle(Vector2<float> center, int radius, Colo
 			err += dx - (radius << 1);
 		}
 	}
+
 }
 
-/// @brief Draws an ellipse to the renderer.
+/// @brief Builds the outline points of an ellipse around the origin.
 /// 
-/// This function renders an ellipse at the specified position with the given radii.
 /// The function ensures symmetry and accuracy by computing points for each region.
-/// If rendering fails, an exception is thrown.
 /// 
-/// @param center: The center coordinates of the ellipse.
 /// @param radius_x: The horizontal radius of the ellipse.
 /// @param radius_y: The vertical radius of the ellipse.
-/// @param outline: The colour of the ellipse outline (optional, defaults to WHITE).
-void PenguinRenderer::draw_ellipse(Vector2<float> center, int radius_x, int radius_y, Colour outline) {
+/// @param points: The points to append the outline to.
+void PenguinRenderer::build_ellipse_outline(int radius_x, int radius_y, std::vector<SDL_FPoint>& points) {
 	// Squares of the radii for the ellipse.
 	int rx2 = radius_x * radius_x;
 	int ry2 = radius_y * radius_y;
@@ -242,16 +596,16 @@ void PenguinRenderer::draw_ellipse(Vector2<float> center, int radius_x, int radi
 	int dy = 2 * rx2 * y;
 	int err = ry2 - (rx2 * radius_y) + (rx2 / 4);
 
-	// Vector for points to be rendered onto the screen.
-	std::vector<SDL_FPoint> points;
+	// Region 1 steps x at most radius_x + 1 times and region 2 steps y at most radius_y + 1 times, each producing 4 points.
+	points.reserve(4 * ((size_t)std::max(radius_x, 0) + (size_t)std::max(radius_y, 0) + 2));
 
 	// |slope| < 1 (region 1).
 	while (dx < dy) {
 		// Symmetrical points.
-		points.push_back({ center.x + x, center.y + y });
-		points.push_back({ center.x - x, center.y + y });
-		points.push_back({ center.x + x, center.y - y });
-		points.push_back({ center.x - x, center.y - y });
+		points.push_back({ (float)x, (float)y });
+		points.push_back({ (float)-x, (float)y });
+		points.push_back({ (float)x, (float)-y });
+		points.push_back({ (float)-x, (float)-y });
 
 		if (err < 0) {
 			x++;
@@ -272,10 +626,10 @@ void PenguinRenderer::draw_ellipse(Vector2<float> center, int radius_x, int radi
 	// |slope| >= 1 (region 2).
 	while (y >= 0) {
 		// Symmetrical points.
-		points.push_back({ center.x + x, center.y + y });
-		points.push_back({ center.x - x, center.y + y });
-		points.push_back({ center.x + x, center.y - y });
-		points.push_back({ center.x - x, center.y - y });
+		points.push_back({ (float)x, (float)y });
+		points.push_back({ (float)-x, (float)y });
+		points.push_back({ (float)x, (float)-y });
+		points.push_back({ (float)-x, (float)-y });
 
 		if (err > 0) {
 			y--;
@@ -291,125 +645,183 @@ void PenguinRenderer::draw_ellipse(Vector2<float> center, int radius_x, int radi
 		}
 	}
 
-	// Draw the ellipse.
-	set_colour(outline);
-	Exception::throw_if(
-		!SDL_RenderPoints(renderer.get(), points.data(), points.size()),
-		"Failed to draw a circle to the renderer.",
-		RENDERER_ERROR
-	);
 }
 
-/// @brief Draws a filled ellipse to the renderer.
-/// 
-/// This function renders a filled ellipse at the specified position.
-/// It fills horizontal lines across the ellipse to ensure a solid fill.
-/// If rendering fails, an exception is thrown.
+/// @brief Builds a filled ellipse around the origin as a triangle fan.
 /// 
-/// @param center: The center coordinates of the ellipse.
-/// @param radius_x: The horizontal radius of the ellipse.
-/// @param radius_y: The vertical radius of the ellipse.
-/// @param fill: The fill colour of the ellipse (optional, defaults to WHITE).
-void PenguinRenderer::draw_filled_ellipse(Vector2<float> center, int radius_x, int radius_y, Colour fill) {
-	// Squares of the radii for the ellipse.
-	int rx2 = radius_x * radius_x;
-	int ry2 = radius_y * radius_y;
+/// @param radius_x: The horizontal radius of the shape, measured between pixel centres.
+/// @param radius_y: The vertical radius of the shape, measured between pixel centres.
+/// @param mesh: The mesh to store the fan's vertex positions and indices in.
+void PenguinRenderer::build_filled_fan(float radius_x, float radius_y, PenguinShapeMesh& mesh) {
+	if (radius_x <= 0.0f || radius_y <= 0.0f) {
+		return;
+	}
 
-	// Initial points and decision variable for region 1.
-	int x = 0;
-	int y = radius_y;
-	int dx = 2 * ry2 * x;
-	int dy = 2 * rx2 * y;
-	int err = ry2 - (rx2 * radius_y) + (rx2 / 4);
+	const PenguinUnitCircle& unit_circle = get_unit_circle(radius_x, radius_y);
 
-	// Vector for points to be rendered onto the screen.
-	std::vector<SDL_FPoint> points;
+	// The fan's centre plus one vertex per rim point.
+	mesh.points.reserve(unit_circle.points.size() + 1);
+	mesh.points.push_back({ 0.0f, 0.0f });
+	for (const SDL_FPoint& point : unit_circle.points) {
+		mesh.points.push_back({ point.x * radius_x, point.y * radius_y });
+	}
+	mesh.indices = unit_circle.fan_indices;
+}
 
-	// |slope| < 1 (region 1).
-	while (dx < dy) {
-		// Fill horizontal lines for symmetrical points.
-		for (int i = center.x - x; i <= center.x + x; i++) {
-			points.push_back({ (float)i, center.y + y });
-			points.push_back({ (float)i, center.y - y });
+/// @brief Retrieves the origin-relative mesh of a circle or ellipse, building it on a cache miss.
+/// 
+/// Meshes are kept in a least recently used cache, so shapes with the same radii only
+/// run the midpoint or fan algorithms once. If the cache is disabled, the mesh is rebuilt
+/// into a reused mesh on every call.
+/// 
+/// @param key: The shape to retrieve the mesh for.
+/// @return The mesh of the shape, valid until the next call.
+const PenguinShapeMesh& PenguinRenderer::get_shape_mesh(const PenguinShapeKey& key) {
+	auto it = shape_cache_lookup.find(key);
+	if (it != shape_cache_lookup.end()) {
+		// Move the entry to the front of the cache, marking it as the most recently used.
+		shape_cache.splice(shape_cache.begin(), shape_cache, it->second);
+		shape_cache_hits++;
+		return it->second->second;
+	}
+	shape_cache_misses++;
+
+	PenguinShapeMesh* mesh = &uncached_mesh;
+	if (shape_cache_capacity > 0) {
+		// Evict the least recently used entry once the cache is full.
+		if (shape_cache.size() >= shape_cache_capacity) {
+			shape_cache_lookup.erase(shape_cache.back().first);
+			shape_cache.pop_back();
 		}
+		shape_cache.emplace_front(key, PenguinShapeMesh{});
+		shape_cache_lookup[key] = shape_cache.begin();
+		mesh = &shape_cache.front().second;
+	}
 
-		if (err < 0) {
-			x++;
-			dx += 2 * ry2;
-			err += dx + ry2;
+	mesh->points.clear();
+	mesh->indices.clear();
+	switch (key.kind) {
+	case PenguinShapeKind::CIRCLE:
+		if (key.filled) {
+			// The outline algorithm starts at radius - 1, so the outermost pixel centres sit at radius - 0.5.
+			build_filled_fan(key.radius_x - 0.5f, key.radius_y - 0.5f, *mesh);
 		}
 		else {
-			x++;
-			y--;
-			dx += 2 * ry2;
-			dy -= 2 * rx2;
-			err += dx - dy + ry2;
-		}
-	}
-
-	err = ry2 * (x + 0.5) * (x + 0.5) + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
-
-	// |slope| >= 1 (region 2).
-	while (y >= 0) {
-		// Fill horizontal lines for symmetrical points.
-		for (int i = center.x - x; i <= center.x + x; i++) {
-			points.push_back({ (float)i, center.y + y });
-			points.push_back({ (float)i, center.y - y });
+			build_circle_outline(key.radius_x, mesh->points);
 		}
+		break;
 
-		if (err > 0) {
-			y--;
-			dy -= 2 * rx2;
-			err += rx2 - dy;
+	case PenguinShapeKind::ELLIPSE:
+		if (key.filled) {
+			// The extra half pixel covers the outermost pixels drawn by the outline.
+			build_filled_fan(key.radius_x + 0.5f, key.radius_y + 0.5f, *mesh);
 		}
 		else {
-			y--;
-			x++;
-			dx += 2 * ry2;
-			dy -= 2 * rx2;
-			err += dx - dy + rx2;
+			build_ellipse_outline(key.radius_x, key.radius_y, mesh->points);
 		}
+		break;
 	}
+	return *mesh;
+}
 
-	// Draw the filled ellipse.
-	set_colour(fill);
-	Exception::throw_if(
-		!SDL_RenderPoints(renderer.get(), points.data(), points.size()),
-		"Failed to draw a filled ellipse to the renderer.",
-		RENDERER_ERROR
-	);
+/// @brief Draws an outline mesh translated by the given centre.
+/// 
+/// @param mesh: The origin-relative outline points.
+/// @param center: The center to translate the outline to.
+/// @param outline: The colour of the outline.
+void PenguinRenderer::submit_outline(const PenguinShapeMesh& mesh, Vector2<float> center, Colour outline) {
+	size_t first_point = point_arena.size();
+	SDL_FPoint* points = point_arena.begin_write(mesh.points.size());
+	for (size_t i = 0; i < mesh.points.size(); i++) {
+		points[i] = { center.x + mesh.points[i].x, center.y + mesh.points[i].y };
+	}
+	point_arena.end_write(mesh.points.size());
+
+	submit_points(first_point, mesh.points.size(), outline);
 }
 
-/// @brief Resets the rendering color to the default value.
+/// @brief Draws a triangle mesh translated by the given centre.
 /// 
-/// This function resets the renderer's drawing color to black.
-void PenguinRenderer::reset_colour() {
-	set_colour(Colours::BLACK); 
+/// @param mesh: The origin-relative vertex positions and triangle indices.
+/// @param center: The center to translate the mesh to.
+/// @param fill: The fill colour of the mesh.
+void PenguinRenderer::submit_mesh(const PenguinShapeMesh& mesh, Vector2<float> center, Colour fill) {
+	if (mesh.indices.empty()) {
+		return;
+	}
+
+	SDL_FColor vertex_colour = to_vertex_colour(fill);
+
+	// Pixel centres sit at +0.5, matching the points drawn by the outline functions.
+	float center_x = center.x + 0.5f;
+	float center_y = center.y + 0.5f;
+
+	size_t first_vertex = vertex_arena.size();
+	SDL_Vertex* vertices = vertex_arena.begin_write(mesh.points.size());
+	for (size_t i = 0; i < mesh.points.size(); i++) {
+		vertices[i] = { { center_x + mesh.points[i].x, center_y + mesh.points[i].y }, vertex_colour, { 0.0f, 0.0f } };
+	}
+	vertex_arena.end_write(mesh.points.size());
+
+	submit_geometry(first_vertex, mesh.points.size(), mesh.indices.data(), mesh.indices.size(), fill);
 }
 
-/// @brief Retrieves the underlying SDL renderer.
+/// @brief Sets the number of circle and ellipse meshes kept in the shape cache.
 /// 
-/// This function provides access to the internal SDL_Renderer pointer used for rendering.
+/// If the cache holds more meshes than the new capacity, the least recently used meshes are evicted.
+/// A capacity of zero disables the cache.
 /// 
-/// @return SDL_Renderer*: A pointer to the SDL_Renderer instance.
-SDL_Renderer* PenguinRenderer::get_renderer() {
-	return renderer.get();
+/// @param capacity: The maximum number of cached meshes.
+void PenguinRenderer::set_shape_cache_capacity(size_t capacity) {
+	shape_cache_capacity = capacity;
+	while (shape_cache.size() > shape_cache_capacity) {
+		shape_cache_lookup.erase(shape_cache.back().first);
+		shape_cache.pop_back();
+	}
 }
 
-/// @brief Draws a horizontal line to the renderer.
+/// @brief Draws coloured geometry from the vertex arena to the renderer, or records it in a deferred render mode.
 /// 
-/// This function draws a straight horizontal line at a specified y-coordinate
-/// from x1 to x2. If rendering fails, an exception is thrown.
+/// In the IMMEDIATE render mode, the vertices are released from the arena once drawn.
+/// If an error occurs while drawing the geometry, an exception is thrown.
 /// 
-/// @param x1: The x-coordinate of the start position.
-/// @param x2: The x-coordinate of the end position.
-/// @param y: The y-coordinate of the line.
-/// @param colour: The colour of the line.
-void PenguinRenderer::draw_horizontal_line(float x1, float x2, float y, Colour colour) {
-	set_colour(colour);
+/// @param first_vertex: The index of the first vertex in the vertex arena.
+/// @param vertex_count: The number of vertices.
+/// @param indices: The indices of the triangles, relative to the first vertex.
+/// @param index_count: The number of indices.
+/// @param colour: The colour of the geometry, used to sort commands in the SORTED render mode.
+void PenguinRenderer::submit_geometry(size_t first_vertex, size_t vertex_count, const int* indices, size_t index_count, Colour colour) {
+	if (render_mode != PenguinRenderMode::IMMEDIATE) {
+		draw_commands.push_back({ PenguinPrimitive::GEOMETRY, colour, SDL_FRect{}, index_arena.size(), index_count });
+		int* batch_indices = index_arena.begin_write(index_count);
+		for (size_t i = 0; i < index_count; i++) {
+			batch_indices[i] = (int)first_vertex + indices[i];
+		}
+		index_arena.end_write(index_count);
+		return;
+	}
+
 	Exception::throw_if(
-		!SDL_RenderLine(renderer.get(), x1, y, x2, y),
-		"Failed to render a line to the screen.",
+		!SDL_RenderGeometry(renderer.get(), NULL, vertex_arena.data() + first_vertex, (int)vertex_count, indices, (int)index_count),
+		"Failed to draw geometry to the renderer.",
 		RENDERER_ERROR
 	);
-}
\ No newline at end of file
+	vertex_arena.rewind(first_vertex);
+}
+
+/// @brief Retrieves the renderer's statistics.
+/// 
+/// @return PenguinRenderStats: The current statistics of the renderer.
+PenguinRenderStats PenguinRenderer::get_stats() const {
+	PenguinRenderStats stats;
+	stats.scratch_allocations = point_arena.get_allocation_count() + vertex_arena.get_allocation_count() + index_arena.get_allocation_count()
+		+ merged_points.get_allocation_count() + merged_rects.get_allocation_count() + merged_indices.get_allocation_count();
+	stats.scratch_bytes = point_arena.get_capacity() * sizeof(SDL_FPoint) + vertex_arena.get_capacity() * sizeof(SDL_Vertex) + index_arena.get_capacity() * sizeof(int)
+		+ merged_points.get_capacity() * sizeof(SDL_FPoint) + merged_rects.get_capacity() * sizeof(SDL_FRect) + merged_indices.get_capacity() * sizeof(int);
+	stats.shape_cache_hits = shape_cache_hits;
+	stats.shape_cache_misses = shape_cache_misses;
+	stats.shape_cache_size = shape_cache.size();
+	stats.state_changes_issued = state_changes_issued;
+	stats.state_changes_skipped = state_changes_skipped;
+	return stats;
+}
@@ -1,8 +1,8 @@
 ///////////////////////////////////////////////////////////////////////////////////
 /// File name: penguin_text_renderer.cpp                                        ///
 ///                                                                             ///
-/// This file implements the PenguinTextRenderer class, which is responsible	///
-/// for rendering text using SDL_ttf.											///
+/// This file implements the PenguinTextRenderer class, which is responsible    ///
+/// for rendering text using SDL_ttf.                                           ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "penguin_text_renderer.hpp"
@@ -11,27 +11,43 @@ using namespace Penguin2D;
 
 /// @brief Constructs a text renderer for rendering text onto the screen.
 /// 
-/// This constructor initializes the text renderer using the provided renderer,
-/// allowing text to be rendered onto the screen. If the text renderer cannot be initialized,
-/// an exception is thrown.
+/// Texts are drawn from glyph atlases created on this renderer, so no SDL_ttf text
+/// engine is needed.
 /// 
-/// @param renderer: The renderer connected to the main window, used to create the text renderer.
+/// @param renderer: The renderer connected to the main window, used to draw text.
 PenguinTextRenderer::PenguinTextRenderer(PenguinRenderer& renderer)
-	: text_renderer(TTF_CreateRendererTextEngine(renderer.get_renderer()), &TTF_DestroyRendererTextEngine) {
+	: renderer(renderer) {
+}
 
-	Exception::throw_if(!text_renderer, "The text renderer could not be initalized.", RENDERER_ERROR);
+/// @brief Retrieves the renderer associated with the text renderer.
+/// 
+/// @return PenguinRenderer&: The renderer that text is drawn onto.
+PenguinRenderer& PenguinTextRenderer::get_renderer() {
+	return renderer;
 }
 
-/// @brief Retrieves the raw pointer of the text renderer.
+/// @brief Retrieves the font registry of the text renderer.
 /// 
-/// This function returns the underlying SDL text engine used for text rendering.
-/// If the text renderer has not been initialized, an exception is thrown.
+/// Texts created with this text renderer open their fonts through the registry,
+/// so texts using the same font file and size share one font.
 /// 
-/// @return TTF_TextEngine*: The raw pointer to the SDL text engine used for rendering text.
-TTF_TextEngine* PenguinTextRenderer::get_text_renderer() {
+/// @return PenguinFontRegistry&: The registry of fonts shared between texts.
+PenguinFontRegistry& PenguinTextRenderer::get_font_registry() {
+	return font_registry;
+}
 
-	// Throw error if the text renderer has not been initialized.
-	Exception::throw_if(!text_renderer, "The text renderer could not be initalized.", RENDERER_ERROR);
+/// @brief Retrieves the glyph atlas of a font.
+/// 
+/// Each font has a single glyph atlas, so every text using the font shares its
+/// rasterized glyphs and page textures.
+/// 
+/// @param font: The font to retrieve the glyph atlas of.
+/// @return PenguinGlyphAtlas&: The glyph atlas of the font.
+PenguinGlyphAtlas& PenguinTextRenderer::get_glyph_atlas(const PenguinFont& font) {
+	auto cached = glyph_atlases.find(&font);
+	if (cached != glyph_atlases.end()) {
+		return *cached->second;
+	}
 
-	return text_renderer.get();
-}
\ No newline at end of file
+	return *glyph_atlases.emplace(&font, std::make_unique<PenguinGlyphAtlas>(renderer, font)).first->second;
+}
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_texture_cache.cpp                                        ///
+///                                                                             ///
+/// PenguinTextureCache loads each image file once and shares the texture       ///
+/// between its users, evicting unused textures to stay under a memory budget.  ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_texture_cache.hpp"
+#include "file_path.hpp"
+
+// SDL related include files
+#include <SDL3_image/SDL_image.h>
+
+// C++ library files
+#include <algorithm>
+#include <vector>
+
+using namespace Penguin2D;
+
+/// @brief Constructs an empty PenguinTextureCache.
+/// @param renderer: The SDL_Renderer used to create the textures.
+PenguinTextureCache::PenguinTextureCache(SDL_Renderer* renderer)
+	: renderer(renderer) {
+}
+
+/// @brief Retrieves the texture for an image file, loading it if it is not cached.
+///
+/// Paths that refer to the same file (e.g., "assets/../assets/ball.png" and
+/// "assets/ball.png") share a texture. Loading a new texture may evict unused
+/// textures if the memory budget is exceeded.
+///
+/// @param path: The file path to the image.
+/// @return A shared handle to the texture, or an empty handle if the image could not be loaded.
+std::shared_ptr<SDL_Texture> PenguinTextureCache::load(const std::string& path) {
+	std::string key = get_canonical_path(path);
+	use_clock++;
+
+	auto cached = textures.find(key);
+	if (cached != textures.end()) {
+		hits++;
+		cached->second.last_used = use_clock;
+		return cached->second.texture;
+	}
+
+	misses++;
+	std::shared_ptr<SDL_Texture> texture(IMG_LoadTexture(renderer, path.c_str()), &SDL_DestroyTexture);
+	if (!texture) {
+		return nullptr;
+	}
+
+	size_t bytes = (size_t)texture->w * (size_t)texture->h * (size_t)std::max(1, (int)SDL_BYTESPERPIXEL(texture->format));
+	textures.emplace(key, CachedTexture{ texture, bytes, use_clock });
+	bytes_resident += bytes;
+	trim_to_budget();
+	return texture;
+}
+
+/// @brief Checks if the texture for an image file is cached.
+/// @param path: The file path to the image.
+/// @return True if the texture is cached, otherwise false.
+bool PenguinTextureCache::contains(const std::string& path) const {
+	return textures.contains(get_canonical_path(path));
+}
+
+/// @brief Removes every texture that is only held by the cache.
+/// @return The number of textures removed.
+size_t PenguinTextureCache::evict_unused() {
+	size_t removed = 0;
+	for (auto it = textures.begin(); it != textures.end();) {
+		if (it->second.texture.use_count() == 1) {
+			bytes_resident -= it->second.bytes;
+			it = textures.erase(it);
+			removed++;
+		}
+		else {
+			++it;
+		}
+	}
+	evictions += removed;
+	return removed;
+}
+
+/// @brief Sets the memory budget, evicting unused textures if it is exceeded.
+/// @param bytes: The budget in bytes (0 means unlimited).
+void PenguinTextureCache::set_memory_budget(size_t bytes) {
+	memory_budget = bytes;
+	trim_to_budget();
+}
+
+/// @brief Gets the memory budget.
+/// @return The budget in bytes (0 means unlimited).
+size_t PenguinTextureCache::get_memory_budget() const {
+	return memory_budget;
+}
+
+/// @brief Gets the estimated size of the cached textures.
+/// @return The size in bytes.
+size_t PenguinTextureCache::get_bytes_resident() const {
+	return bytes_resident;
+}
+
+/// @brief Gets the statistics of the cache.
+/// @return The current statistics of the cache.
+PenguinTextureCacheStats PenguinTextureCache::get_stats() const {
+	return PenguinTextureCacheStats{ hits, misses, evictions, bytes_resident, textures.size() };
+}
+
+/// @brief Evicts the least recently used unused textures until the cache fits its budget.
+///
+/// Textures that still have handles outside the cache are never evicted, so the cache
+/// may remain over budget if every texture is in use.
+void PenguinTextureCache::trim_to_budget() {
+	if (memory_budget == 0 || bytes_resident <= memory_budget) {
+		return;
+	}
+
+	std::vector<std::unordered_map<std::string, CachedTexture>::iterator> unused;
+	for (auto it = textures.begin(); it != textures.end(); ++it) {
+		if (it->second.texture.use_count() == 1) {
+			unused.push_back(it);
+		}
+	}
+	std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) {
+		return a->second.last_used < b->second.last_used;
+	});
+
+	for (auto it : unused) {
+		if (bytes_resident <= memory_budget) {
+			break;
+		}
+		bytes_resident -= it->second.bytes;
+		textures.erase(it);
+		evictions++;
+	}
+}
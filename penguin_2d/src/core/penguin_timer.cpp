@@ -6,10 +6,17 @@
 ///                                                                             ///
 /// This class is used internally in PenguinGameWindow to update and render     ///
 /// the game by using functions such as consume_time() and update_frame_time(). ///
+///                                                                             ///
+/// The cap waits with a PenguinFramePacer on a fixed schedule of frame starts, ///
+/// and the intervals between frame starts are kept to report frame jitter.     ///
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "penguin_timer.hpp"
 
+// C++ library files
+#include <algorithm>
+#include <cmath>
+
 using namespace Penguin2D;
 
 /// @brief Calculates the frame time and updates the accumulator.
@@ -24,8 +31,11 @@ void PenguinTimer::update_frame_time() {
         frame_time = 0.25;
     }
     prev_time = curr_time;
-    accumulator += frame_time;
 
+    // Under TIME_DILATION the game clock may run slower than real time.
+    timestep_stats.dilated_time += frame_time * (1.0 - time_scale);
+    accumulator += frame_time * time_scale;
+    substeps = 0;
 }
 
 /// @brief Updates the FPS counter.
@@ -48,13 +58,93 @@ void PenguinTimer::update_fps() {
     }
 }
 
-/// @brief Consumes a fixed timestep from the accumulator and updates running time.
+/// @brief Consumes the step that was just run from the accumulator and updates running time.
 ///
-/// This function removes a fixed delta time from the accumulator to keep time
-/// progression consistent with the game loop's update rate.
+/// This function removes the step's time (normally the fixed delta time) from the
+/// accumulator to keep time progression consistent with the game loop's update rate.
 void PenguinTimer::consume_time() {
-    accumulator -= delta_time;
-    running_time += delta_time;
+    if (is_catch_up_step()) {
+        timestep_stats.catch_up_steps++;
+    }
+
+    double step_time = get_step_time();
+    accumulator -= step_time;
+    running_time += step_time;
+    substeps++;
+}
+
+/// @brief Applies the overload mode to any whole steps left after the frame's updates.
+///
+/// Steps are only left over when the substep limit or the update budget stopped the
+/// frame's updates early. The whole steps are then discarded, so the accumulator cannot
+/// grow from frame to frame, and counted as dropped time; the fraction of a step that
+/// is left keeps alpha meaningful. In TIME_DILATION mode the game clock is also slowed
+/// to the speed the updates kept up with, and sped back up once they fit again.
+void PenguinTimer::end_updates() {
+    if (accumulator < delta_time) {
+        time_scale = std::min(1.0, time_scale * 1.05);
+        return;
+    }
+
+    double whole_steps = std::floor(accumulator / delta_time) * delta_time;
+    accumulator -= whole_steps;
+    timestep_stats.overloaded_frames++;
+    timestep_stats.dropped_time += whole_steps;
+
+    if (overload_mode == PenguinOverloadMode::TIME_DILATION) {
+        double simulated_time = substeps * delta_time;
+        time_scale = std::clamp(time_scale * simulated_time / (simulated_time + whole_steps), min_time_scale, 1.0);
+    }
+}
+
+/// @brief Records how long an update took, for the update budget.
+/// @param seconds: The duration of one update in seconds.
+void PenguinTimer::record_update_cost(double seconds) {
+    update_cost = update_cost == 0.0 ? seconds : update_cost + 0.1 * (seconds - update_cost);
+}
+
+/// @brief Limits the number of updates run in a frame.
+///
+/// Without a limit, a frame runs as many updates as its frame time allows (up to 0.25
+/// seconds' worth), so updates slower than the delta time make every frame slower still.
+///
+/// @param max: The maximum number of updates per frame (0 for no limit).
+void PenguinTimer::set_max_substeps(int max) {
+    max_substeps = std::max(0, max);
+}
+
+/// @brief Limits the time spent on updates in a frame, based on their measured cost.
+///
+/// A frame stops updating once another update is predicted, from the moving average
+/// of record_update_cost(), to go over the budget. At least one update always runs.
+///
+/// @param seconds: The update budget per frame in seconds (0 for no budget).
+void PenguinTimer::set_update_budget(double seconds) {
+    update_budget = std::max(0.0, seconds);
+}
+
+/// @brief Sets how the timer copes when the updates cannot catch up with real time.
+/// @param mode: The overload mode.
+void PenguinTimer::set_overload_mode(PenguinOverloadMode mode) {
+    overload_mode = mode;
+    if (mode != PenguinOverloadMode::TIME_DILATION) {
+        time_scale = 1.0;
+    }
+}
+
+/// @brief Sets how far TIME_DILATION may slow the game clock.
+/// @param scale: The slowest game clock speed relative to real time (between 0 and 1).
+void PenguinTimer::set_min_time_scale(double scale) {
+    min_time_scale = std::clamp(scale, 0.01, 1.0);
+}
+
+/// @brief Gets the counters of how the fixed timestep coped with overload.
+/// @return PenguinTimestepStats: The timestep statistics.
+PenguinTimestepStats PenguinTimer::get_timestep_stats() const {
+    PenguinTimestepStats stats = timestep_stats;
+    stats.time_scale = time_scale;
+    stats.update_cost_ms = update_cost * 1000.0;
+    return stats;
 }
 
 /// @brief Enables or disables FPS capping and sets the target frame rate.
@@ -67,32 +157,104 @@ void PenguinTimer::set_fps_cap(bool enable, double fps) {
     // Cap FPS to the fps parameter (if enabled == true).
     cap_fps = enable;
     if (enable) {
+        calibrate_frame_pacer();
         target_fps = fps;
         target_frame_time = 1.0 / target_fps;
+        next_frame_start = penguin_clock::now(); // Start the schedule from the current frame.
     }
 }
 
-/// @brief Delays execution to maintain a consistent frame rate.
+/// @brief Calibrates the frame pacer if the frame rate is capped and it has not been calibrated.
 ///
-/// This function ensures that the frame rate does not exceed the specified cap
-/// by pausing execution for the required duration.
-void PenguinTimer::cap_frame_rate() const {
-    if (!cap_fps) return; // No capping needed if disabled.
+/// Calibration sleeps a few milliseconds, so it runs at startup rather than in the first
+/// capped frame. A pacer in SLEEP mode needs no calibration.
+void PenguinTimer::calibrate_frame_pacer() {
+    if (cap_fps && pacer.get_mode() != PenguinPacingMode::SLEEP && !pacer.get_stats().calibrated) {
+        pacer.calibrate();
+    }
+}
 
-    auto curr_time = penguin_clock::now();
-    double elapsed_time = std::chrono::duration<double>(curr_time - prev_time).count();
+/// @brief Waits for the next frame start and records the interval between frame starts.
+///
+/// Frames are paced on a fixed schedule of frame start boundaries, each one target
+/// frame time after the previous boundary, rather than on the time since the frame's
+/// update began. A late wake-up therefore shortens the next wait instead of drifting
+/// the frame rate. A frame that overruns the schedule resets it, so a stall is not
+/// followed by a burst of unpaced frames.
+void PenguinTimer::cap_frame_rate() {
+    if (cap_fps) {
+        auto frame_duration = std::chrono::duration_cast<penguin_clock::duration>(std::chrono::duration<double>(target_frame_time));
+        next_frame_start += frame_duration;
+
+        auto curr_time = penguin_clock::now();
+        if (next_frame_start < curr_time) {
+            next_frame_start = curr_time;
+        }
+        pacer.wait_until(next_frame_start);
+    }
 
-    // Enforce target frame rate.
-    if (elapsed_time < target_frame_time) {
-        double sleep_time = target_frame_time - elapsed_time;
-        std::this_thread::sleep_for(std::chrono::duration<double>(sleep_time));
+    // Record the interval between frame starts for the jitter statistics.
+    auto frame_start = penguin_clock::now();
+    frame_intervals[frame_interval_count % FRAME_HISTORY] = std::chrono::duration<double>(frame_start - last_frame_start).count();
+    frame_interval_count++;
+    last_frame_start = frame_start;
+    if (!cap_fps) {
+        next_frame_start = frame_start;
     }
 }
 
-/// @brief Determines if enough time has accumulated for an update.
+/// @brief Sets how the frame rate cap waits for the next frame.
+/// @param mode: The pacing mode.
+void PenguinTimer::set_pacing_mode(PenguinPacingMode mode) {
+    pacer.set_mode(mode);
+}
+
+/// @brief Gets the frame pacer used by the frame rate cap.
+/// @return PenguinFramePacer&: The frame pacer.
+PenguinFramePacer& PenguinTimer::get_frame_pacer() {
+    return pacer;
+}
+
+/// @brief Gets statistics of the intervals between recent frame starts.
+///
+/// The statistics cover the last FRAME_HISTORY frames. The standard deviation is
+/// the frame jitter: close to zero when every frame starts on schedule.
+///
+/// @return PenguinFrameStats: The frame interval statistics.
+PenguinFrameStats PenguinTimer::get_frame_stats() const {
+    PenguinFrameStats stats;
+    stats.count = std::min(frame_interval_count, FRAME_HISTORY);
+    if (stats.count == 0) {
+        return stats;
+    }
+
+    double total = 0.0;
+    double shortest = frame_intervals[0];
+    double longest = frame_intervals[0];
+    for (size_t i = 0; i < stats.count; i++) {
+        total += frame_intervals[i];
+        shortest = std::min(shortest, frame_intervals[i]);
+        longest = std::max(longest, frame_intervals[i]);
+    }
+    double mean = total / stats.count;
+
+    double squared_total = 0.0;
+    for (size_t i = 0; i < stats.count; i++) {
+        squared_total += (frame_intervals[i] - mean) * (frame_intervals[i] - mean);
+    }
+
+    stats.mean_ms = mean * 1000.0;
+    stats.stddev_ms = std::sqrt(squared_total / stats.count) * 1000.0;
+    stats.min_ms = shortest * 1000.0;
+    stats.max_ms = longest * 1000.0;
+    return stats;
+}
+
+/// @brief Determines if enough time has accumulated for an update, and the frame has room for it.
 /// @return True if an update should occur, otherwise false.
 bool PenguinTimer::should_update() const {
-    return accumulator >= delta_time;
+    // The first update always runs, so an overloaded game slows down rather than freezes.
+    return accumulator >= delta_time && (substeps == 0 || has_room_for_steps(1));
 }
 
 /// @brief Returns the interpolation factor for rendering.
@@ -110,6 +272,25 @@ double PenguinTimer::get_delta_time() const {
     return delta_time;
 }
 
+/// @brief Retrieves the delta time of the next update.
+///
+/// In VARIABLE_STEP mode, the last update a frame has room for covers every whole
+/// step left in the accumulator, so no simulation time is dropped.
+///
+/// @return The delta time of the next update, in seconds.
+double PenguinTimer::get_step_time() const {
+    if (is_catch_up_step()) {
+        return std::floor(accumulator / delta_time) * delta_time;
+    }
+    return delta_time;
+}
+
+/// @brief Checks if the next update is a catch-up step.
+/// @return True if the next update is a longer VARIABLE_STEP catch-up step, otherwise false.
+bool PenguinTimer::is_catch_up_step() const {
+    return overload_mode == PenguinOverloadMode::VARIABLE_STEP && accumulator >= 2.0 * delta_time && !has_room_for_steps(2);
+}
+
 /// @brief Retrieves the current FPS value.
 /// @return The current FPS as a double.
 double PenguinTimer::get_fps() const {
@@ -123,4 +304,14 @@ double PenguinTimer::get_fps() const {
 /// @param ms: The amount of time to delay execution for, in milliseconds.
 void PenguinTimer::delay(double ms) {
     SDL_Delay(ms);
+}
+
+/// @brief Checks if the current frame has room for more updates.
+/// @param steps: The number of further updates.
+/// @return True if the updates fit in the substep limit and the update budget, otherwise false.
+bool PenguinTimer::has_room_for_steps(int steps) const {
+    if (max_substeps > 0 && substeps + steps > max_substeps) {
+        return false;
+    }
+    return update_budget <= 0.0 || (substeps + steps) * update_cost <= update_budget;
 }
\ No newline at end of file
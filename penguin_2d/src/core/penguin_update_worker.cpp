@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_update_worker.cpp                                             ///
+///                                                                             ///
+/// PenguinUpdateWorker runs batches of fixed update steps on its own thread,   ///
+/// so PenguinGameWindow can draw one frame while the next one is simulated.    ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_update_worker.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <chrono>
+
+using namespace Penguin2D;
+
+/// @brief Constructs a PenguinUpdateWorker and starts its thread.
+/// @param game: The game to update.
+/// @param profiler: The profiler each update step is recorded in.
+/// @param begin_step: Called on the worker thread before each update step.
+PenguinUpdateWorker::PenguinUpdateWorker(PenguinGame& game, PenguinProfiler& profiler, std::function<void()> begin_step)
+	: game(game), profiler(profiler), begin_step(std::move(begin_step)), thread(&PenguinUpdateWorker::worker_loop, this) {
+}
+
+/// @brief Finishes the batch in flight, if any, and joins the thread.
+///
+/// An exception from the last batch is discarded here; call wait() first to observe it.
+PenguinUpdateWorker::~PenguinUpdateWorker() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	batch_started.notify_one();
+	thread.join();
+}
+
+/// @brief Starts a batch of update steps.
+/// @param steps: The number of fixed steps.
+/// @param delta_time: The delta time passed to each fixed step.
+/// @param catch_up_time: The delta time of a final catch-up step, or 0 for none.
+void PenguinUpdateWorker::start_updates(int steps, double delta_time, double catch_up_time) {
+	if (steps <= 0 && catch_up_time <= 0.0) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending_steps = std::max(0, steps);
+		step_delta_time = delta_time;
+		step_catch_up_time = catch_up_time;
+		busy = true;
+	}
+	batch_started.notify_one();
+}
+
+/// @brief Blocks until the batch in flight has finished.
+/// @return double: The average duration of one update in the batch in seconds, or 0 if no batch ran since the last wait.
+/// @throws The exception thrown by update(), if any.
+double PenguinUpdateWorker::wait() {
+	std::unique_lock<std::mutex> lock(mutex);
+	batch_finished.wait(lock, [this] { return !busy; });
+
+	if (error) {
+		std::exception_ptr batch_error = error;
+		error = nullptr;
+		std::rethrow_exception(batch_error);
+	}
+
+	double batch_step_cost = step_cost;
+	step_cost = 0.0;
+	return batch_step_cost;
+}
+
+/// @brief Waits for batches and runs them until the worker is stopped.
+///
+/// The lock is released while update() runs, so the main thread is only ever blocked
+/// by the hand-off itself.
+void PenguinUpdateWorker::worker_loop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		batch_started.wait(lock, [this] { return busy || stopping; });
+		if (!busy) {
+			return;
+		}
+
+		int steps = pending_steps;
+		double delta_time = step_delta_time;
+		double catch_up_time = step_catch_up_time;
+		lock.unlock();
+
+		auto batch_start = std::chrono::steady_clock::now();
+		std::exception_ptr batch_error;
+		try {
+			for (int step = 0; step < steps; step++) {
+				PENGUIN_PROFILE_SCOPE(profiler, "update");
+				begin_step();
+				game.update(delta_time);
+			}
+			if (catch_up_time > 0.0) {
+				PENGUIN_PROFILE_SCOPE(profiler, "update");
+				begin_step();
+				game.update(catch_up_time);
+			}
+		}
+		catch (...) {
+			batch_error = std::current_exception();
+		}
+		double batch_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - batch_start).count();
+
+		lock.lock();
+		step_cost = batch_time / (steps + (catch_up_time > 0.0 ? 1 : 0));
+		error = batch_error;
+		busy = false;
+		batch_finished.notify_one();
+	}
+}
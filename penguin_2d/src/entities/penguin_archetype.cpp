@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_archetype.cpp                                                 ///
+///                                                                             ///
+/// PenguinArchetype lays out fixed-size chunks as one array per component      ///
+/// type and keeps its entities densely packed in them. Also implements the     ///
+/// component type registry.                                                    ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_archetype.hpp"
+#include "exception.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace Penguin2D;
+
+namespace {
+	std::array<PenguinComponentInfo, PENGUIN_MAX_COMPONENTS> component_infos; /// The registered component types, by id.
+	std::atomic<PenguinComponentId> component_count{ 0 }; /// The number of registered component types.
+	std::mutex registry_mutex; /// Serializes registration.
+
+	/// @brief Rounds an offset up to a multiple of an alignment.
+	size_t align_up(size_t offset, size_t alignment) {
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+}
+
+/// @brief Registers a component type and assigns it the next id.
+///
+/// If more than PENGUIN_MAX_COMPONENTS types are registered, an exception is thrown.
+///
+/// @param info: The description of the component type.
+/// @return PenguinComponentId: The id of the component type.
+PenguinComponentId PenguinComponentRegistry::register_component(const PenguinComponentInfo& info) {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	PenguinComponentId id = component_count.load(std::memory_order_relaxed);
+	Exception::throw_if(id >= PENGUIN_MAX_COMPONENTS, "Too many component types are registered. The limit is " + std::to_string(PENGUIN_MAX_COMPONENTS) + ".", RUNTIME_ERROR);
+
+	component_infos[id] = info;
+	component_count.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+/// @brief Gets the description of a registered component type.
+/// @param id: The id of the component type.
+/// @return const PenguinComponentInfo&: The description of the component type.
+const PenguinComponentInfo& PenguinComponentRegistry::get_info(PenguinComponentId id) {
+	return component_infos[id];
+}
+
+/// @brief Gets the number of registered component types.
+/// @return PenguinComponentId: The number of registered component types.
+PenguinComponentId PenguinComponentRegistry::get_count() {
+	return component_count.load(std::memory_order_acquire);
+}
+
+/// @brief Constructs an empty PenguinArchetype and lays out its chunks.
+///
+/// A chunk starts with the entity ids, followed by one aligned array per component type.
+/// The chunk capacity is the number of entities that fit in CHUNK_BYTES, or one if a
+/// single entity is larger than that.
+///
+/// @param mask: The component types of the archetype.
+PenguinArchetype::PenguinArchetype(PenguinComponentMask mask)
+	: mask(mask) {
+	columns_by_id.fill(-1);
+
+	size_t row_bytes = sizeof(PenguinEntityId);
+	size_t padding_bytes = 0;
+	for (PenguinComponentId id = 0; id < PENGUIN_MAX_COMPONENTS; id++) {
+		if (mask & (PenguinComponentMask(1) << id)) {
+			const PenguinComponentInfo& info = PenguinComponentRegistry::get_info(id);
+			columns_by_id[id] = (int)components.size();
+			components.push_back(id);
+			column_sizes.push_back(info.size);
+			row_bytes += info.size;
+			padding_bytes += info.alignment;
+			chunk_alignment = std::max(chunk_alignment, info.alignment);
+		}
+	}
+
+	chunk_capacity = CHUNK_BYTES > padding_bytes ? (CHUNK_BYTES - padding_bytes) / row_bytes : 0;
+	chunk_capacity = std::max<size_t>(chunk_capacity, 1);
+
+	size_t offset = chunk_capacity * sizeof(PenguinEntityId);
+	for (PenguinComponentId id : components) {
+		const PenguinComponentInfo& info = PenguinComponentRegistry::get_info(id);
+		offset = align_up(offset, info.alignment);
+		column_offsets.push_back(offset);
+		offset += chunk_capacity * info.size;
+	}
+	chunk_bytes = align_up(std::max<size_t>(offset, 1), chunk_alignment);
+}
+
+/// @brief Destroys every component of the archetype.
+PenguinArchetype::~PenguinArchetype() {
+	for (size_t column = 0; column < components.size(); column++) {
+		const PenguinComponentInfo& info = PenguinComponentRegistry::get_info(components[column]);
+		for (size_t row = 0; row < entity_count; row++) {
+			info.destroy(get_component(row, (int)column));
+		}
+	}
+}
+
+/// @brief Appends a row for an entity, allocating a new chunk if the last one is full.
+/// @param entity: The entity the row belongs to.
+/// @return size_t: The row of the entity.
+size_t PenguinArchetype::push_entity(PenguinEntityId entity) {
+	if (entity_count == chunks.size() * chunk_capacity) {
+		std::byte* chunk = static_cast<std::byte*>(::operator new[](chunk_bytes, std::align_val_t(chunk_alignment)));
+		chunks.emplace_back(chunk, ChunkDeleter{ chunk_alignment });
+	}
+
+	size_t row = entity_count++;
+	get_entities(row / chunk_capacity)[row % chunk_capacity] = entity;
+	return row;
+}
+
+/// @brief Removes a row by moving the last entity into it, and frees the last chunk once it is empty.
+/// @param row: The row to remove.
+/// @param destroy_components: True to destroy the row's components, false if they were already moved out.
+/// @return PenguinEntityId: The entity moved into the row, or a null id if the removed row was the last one.
+PenguinEntityId PenguinArchetype::erase_row(size_t row, bool destroy_components) {
+	size_t last_row = entity_count - 1;
+	PenguinEntityId moved_entity;
+
+	for (size_t column = 0; column < components.size(); column++) {
+		const PenguinComponentInfo& info = PenguinComponentRegistry::get_info(components[column]);
+		if (destroy_components) {
+			info.destroy(get_component(row, (int)column));
+		}
+		if (row != last_row) {
+			info.relocate(get_component(row, (int)column), get_component(last_row, (int)column));
+		}
+	}
+
+	if (row != last_row) {
+		moved_entity = get_entity(last_row);
+		get_entities(row / chunk_capacity)[row % chunk_capacity] = moved_entity;
+	}
+
+	entity_count--;
+	if (entity_count == (chunks.size() - 1) * chunk_capacity) {
+		chunks.pop_back();
+	}
+	return moved_entity;
+}
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_system_scheduler.cpp                                          ///
+///                                                                             ///
+/// PenguinSystemScheduler links each system to the earlier systems it          ///
+/// conflicts with. Each tick it queues the systems with no dependencies, and   ///
+/// a finishing system queues each dependent whose last dependency it was.      ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_system_scheduler.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+using namespace Penguin2D;
+
+namespace {
+	/// @brief Gets a copy of a name that lives as long as the program, as profiler zones require.
+	/// @param name: The name.
+	/// @return The copy.
+	const char* intern_name(const std::string& name) {
+		static std::mutex mutex;
+		static std::unordered_set<std::string> names;
+		std::lock_guard<std::mutex> lock(mutex);
+		return names.insert(name).first->c_str();
+	}
+}
+
+/// @brief Constructs a PenguinSystemScheduler with no systems.
+/// @param world: The world the systems run on.
+/// @param job_system: The job system that runs the systems.
+PenguinSystemScheduler::PenguinSystemScheduler(PenguinWorld& world, PenguinJobSystem& job_system)
+	: world(world), job_system(job_system) {
+}
+
+/// @brief Adds a system. It runs after every earlier-added system it conflicts with.
+/// @param name: The name of the system, shown in the schedule and the profiler.
+/// @param access: The component types the system reads and writes.
+/// @param system: The function run each tick.
+/// @return size_t: The index of the system.
+size_t PenguinSystemScheduler::add_system(const std::string& name, const PenguinSystemAccess& access, PenguinSystem system) {
+	Exception::throw_if(!system, "The system " + name + " has no function.", RUNTIME_ERROR);
+
+	auto node = std::make_unique<SystemNode>();
+	node->name = name;
+	node->zone_name = intern_name(name);
+	node->access = access;
+	node->access.reads &= ~access.writes;
+	node->system = std::move(system);
+	node->stats.name = name;
+
+	size_t index = systems.size();
+	for (size_t earlier = 0; earlier < index; earlier++) {
+		if (systems[earlier]->access.conflicts_with(node->access)) {
+			node->dependencies.push_back(earlier);
+			node->stage = std::max(node->stage, systems[earlier]->stage + 1);
+			systems[earlier]->dependents.push_back(index);
+		}
+	}
+	node->stats.stage = node->stage;
+
+	systems.push_back(std::move(node));
+	return index;
+}
+
+/// @brief Runs every system once, waits for them, and flushes the world's command buffer.
+///
+/// The calling thread runs systems too while it waits. If a system throws, the systems that
+/// have not started yet are skipped and the command buffer is not flushed.
+///
+/// @param delta_time: The delta time passed to each system.
+void PenguinSystemScheduler::run(double delta_time) {
+	auto tick_start = std::chrono::steady_clock::now();
+
+	failed.store(false, std::memory_order_relaxed);
+	error = nullptr;
+	for (std::unique_ptr<SystemNode>& node : systems) {
+		node->remaining_dependencies.store(node->dependencies.size(), std::memory_order_relaxed);
+	}
+
+	PenguinJobCounter counter;
+	for (size_t index = 0; index < systems.size(); index++) {
+		if (systems[index]->dependencies.empty()) {
+			job_system.run([this, index, delta_time, &counter] { run_system(index, delta_time, counter); }, counter);
+		}
+	}
+	job_system.wait(counter);
+	last_tick_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tick_start).count();
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	world.flush_commands();
+}
+
+/// @brief Records each system run as a zone named after the system.
+/// @param profiler: The profiler to record in, or nullptr to stop recording.
+void PenguinSystemScheduler::set_profiler(PenguinProfiler* profiler) {
+	this->profiler = profiler;
+}
+
+/// @brief Gets the number of systems.
+/// @return size_t: The number of systems.
+size_t PenguinSystemScheduler::get_system_count() const {
+	return systems.size();
+}
+
+/// @brief Gets the timings and schedule of every system.
+/// @return std::vector<PenguinSystemStats>: One entry per system, in the order they were added.
+std::vector<PenguinSystemStats> PenguinSystemScheduler::get_system_stats() const {
+	std::vector<PenguinSystemStats> stats;
+	for (const std::unique_ptr<SystemNode>& node : systems) {
+		stats.push_back(node->stats);
+	}
+	return stats;
+}
+
+/// @brief Resets the timings of every system.
+void PenguinSystemScheduler::reset_stats() {
+	for (std::unique_ptr<SystemNode>& node : systems) {
+		node->stats = PenguinSystemStats{ node->name, node->stage };
+	}
+	last_tick_ms = 0.0;
+}
+
+/// @brief Writes the schedule: each stage's systems, their access and dependencies, and their timings.
+///
+/// The critical path is the slowest chain of dependent systems in the last tick, which no
+/// number of cores can make the tick shorter than.
+///
+/// @param out: The stream to write to.
+void PenguinSystemScheduler::write_schedule(std::ostream& out) const {
+	// Finish times of the last tick if every system started as soon as its dependencies finished.
+	std::vector<double> finish_ms(systems.size(), 0.0);
+	double critical_path_ms = 0.0;
+	size_t stage_count = 0;
+	for (size_t index = 0; index < systems.size(); index++) {
+		const SystemNode& node = *systems[index];
+		for (size_t dependency : node.dependencies) {
+			finish_ms[index] = std::max(finish_ms[index], finish_ms[dependency]);
+		}
+		finish_ms[index] += node.stats.last_ms;
+		critical_path_ms = std::max(critical_path_ms, finish_ms[index]);
+		stage_count = std::max(stage_count, node.stage + 1);
+	}
+
+	out << "Schedule: " << systems.size() << " systems in " << stage_count << " stages, on " << job_system.get_worker_count() + 1 << " threads\n";
+	out << "Last tick: " << last_tick_ms << " ms (critical path " << critical_path_ms << " ms)\n";
+	for (size_t stage = 0; stage < stage_count; stage++) {
+		out << "Stage " << stage << ":\n";
+		for (size_t index = 0; index < systems.size(); index++) {
+			const SystemNode& node = *systems[index];
+			if (node.stage != stage) {
+				continue;
+			}
+
+			out << "  " << node.name << (node.access.exclusive ? " [exclusive]" : "")
+				<< "  reads: " << describe_mask(node.access.reads)
+				<< "  writes: " << describe_mask(node.access.writes);
+			if (!node.dependencies.empty()) {
+				out << "  after:";
+				for (size_t dependency : node.dependencies) {
+					out << " " << systems[dependency]->name;
+				}
+			}
+			out << "\n    last " << node.stats.last_ms << " ms, mean " << node.stats.mean_ms
+				<< " ms, max " << node.stats.max_ms << " ms over " << node.stats.runs << " runs\n";
+		}
+	}
+}
+
+/// @brief Runs a system, then queues each dependent whose last dependency it was.
+/// @param index: The index of the system.
+/// @param delta_time: The delta time passed to the system.
+/// @param counter: The counter tracking the tick's systems.
+void PenguinSystemScheduler::run_system(size_t index, double delta_time, PenguinJobCounter& counter) {
+	SystemNode& node = *systems[index];
+
+	if (!failed.load(std::memory_order_acquire)) {
+#ifndef PENGUIN_DISABLE_PROFILER
+		uint64_t zone_start = profiler ? profiler->now() : 0;
+#endif
+		auto start = std::chrono::steady_clock::now();
+		try {
+			node.system(world, delta_time);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(error_mutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+			failed.store(true, std::memory_order_release);
+		}
+		double run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+#ifndef PENGUIN_DISABLE_PROFILER
+		if (profiler && profiler->is_enabled()) {
+			profiler->record(node.zone_name, zone_start, profiler->now());
+		}
+#endif
+
+		PenguinSystemStats& stats = node.stats;
+		stats.runs++;
+		stats.last_ms = run_ms;
+		stats.mean_ms += (run_ms - stats.mean_ms) / stats.runs;
+		stats.max_ms = std::max(stats.max_ms, run_ms);
+	}
+
+	for (size_t dependent : node.dependents) {
+		if (systems[dependent]->remaining_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			job_system.run([this, dependent, delta_time, &counter] { run_system(dependent, delta_time, counter); }, counter);
+		}
+	}
+}
+
+/// @brief Describes a set of component types.
+/// @param mask: The component types.
+/// @return std::string: The names of the component types, or "-" for none.
+std::string PenguinSystemScheduler::describe_mask(PenguinComponentMask mask) {
+	std::string description;
+	for (PenguinComponentId id = 0; id < PENGUIN_MAX_COMPONENTS; id++) {
+		if (mask & (PenguinComponentMask(1) << id)) {
+			description += (description.empty() ? "" : ", ") + std::string(PenguinComponentRegistry::get_info(id).name);
+		}
+	}
+	return description.empty() ? "-" : description;
+}
@@ -0,0 +1,246 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_world.cpp                                                     ///
+///                                                                             ///
+/// PenguinWorld keeps a record per entity index pointing at its archetype and  ///
+/// row, moves entities between archetypes as components change, and caches     ///
+/// the archetypes that match each query. Also implements the command buffer.   ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_world.hpp"
+
+using namespace Penguin2D;
+
+/// @brief Records the destruction of an entity.
+/// @param entity: The entity to destroy.
+void PenguinCommandBuffer::destroy(PenguinEntityId entity) {
+	push([entity](PenguinWorld& world) {
+		if (world.is_alive(entity)) {
+			world.destroy(entity);
+		}
+	});
+}
+
+/// @brief Gets the number of recorded commands.
+/// @return size_t: The number of commands waiting to be applied.
+size_t PenguinCommandBuffer::get_command_count() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return commands.size();
+}
+
+/// @brief Applies every recorded command to a world, in order, and clears the buffer.
+///
+/// Commands recorded while applying (e.g., by a component's destructor) are applied too.
+/// If a command throws, the commands before it stay applied, the buffer is cleared (dropping
+/// the commands after it, including those recorded while applying), and the exception is
+/// rethrown, so the next apply() does not replay a half-applied batch.
+///
+/// @param world: The world to change.
+void PenguinCommandBuffer::apply(PenguinWorld& world) {
+	while (true) {
+		std::vector<PenguinCommand> pending;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (commands.empty()) {
+				return;
+			}
+			pending.swap(commands);
+		}
+
+		try {
+			for (PenguinCommand& command : pending) {
+				command(world);
+			}
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(mutex);
+			commands.clear();
+			throw;
+		}
+	}
+}
+
+/// @brief Appends a command.
+/// @param command: The command.
+void PenguinCommandBuffer::push(PenguinCommand command) {
+	std::lock_guard<std::mutex> lock(mutex);
+	commands.push_back(std::move(command));
+}
+
+/// @brief Creates an entity with no components.
+/// @return PenguinEntityId: The id of the entity.
+PenguinEntityId PenguinWorld::create() {
+	check_structural_change();
+	return allocate_entity(get_archetype(0));
+}
+
+/// @brief Destroys an entity and its components.
+///
+/// If the entity does not exist, an exception is thrown.
+///
+/// @param entity: The entity to destroy.
+void PenguinWorld::destroy(PenguinEntityId entity) {
+	check_structural_change();
+	EntityRecord& record = get_record(entity);
+
+	PenguinEntityId moved_entity = record.archetype->erase_row(record.row, true);
+	if (!moved_entity.is_null()) {
+		records[moved_entity.index].row = record.row;
+	}
+
+	record.archetype = nullptr;
+	record.generation++;
+	free_indices.push_back(entity.index);
+	entity_count--;
+}
+
+/// @brief Checks if an entity exists.
+/// @param entity: The entity.
+/// @return bool: True if the entity exists, otherwise false.
+bool PenguinWorld::is_alive(PenguinEntityId entity) const {
+	return entity.index < records.size() && records[entity.index].archetype != nullptr
+		&& records[entity.index].generation == entity.generation;
+}
+
+/// @brief Gets the buffer that records structural changes to apply later.
+/// @return PenguinCommandBuffer&: The world's command buffer.
+PenguinCommandBuffer& PenguinWorld::get_commands() {
+	return commands;
+}
+
+/// @brief Applies the commands recorded in the world's command buffer.
+///
+/// If a query is running, an exception is thrown.
+void PenguinWorld::flush_commands() {
+	check_structural_change();
+	commands.apply(*this);
+}
+
+/// @brief Gets the number of entities.
+/// @return size_t: The number of entities in the world.
+size_t PenguinWorld::get_entity_count() const {
+	return entity_count;
+}
+
+/// @brief Gets the number of archetypes.
+/// @return size_t: The number of distinct sets of component types in use, or used before.
+size_t PenguinWorld::get_archetype_count() const {
+	return archetypes.size();
+}
+
+/// @brief Gets every archetype that has a set of component types.
+///
+/// The result is cached per mask and only the archetypes created since the last call are
+/// checked, so repeated queries cost a map lookup.
+///
+/// @param mask: The component types.
+/// @return const std::vector<PenguinArchetype*>&: The matching archetypes, in creation order.
+const std::vector<PenguinArchetype*>& PenguinWorld::get_matching_archetypes(PenguinComponentMask mask) {
+	std::lock_guard<std::mutex> lock(query_mutex);
+	QueryCache& query = queries[mask];
+	for (; query.archetypes_checked < archetypes.size(); query.archetypes_checked++) {
+		PenguinArchetype* archetype = archetypes[query.archetypes_checked].get();
+		if ((archetype->get_mask() & mask) == mask) {
+			query.archetypes.push_back(archetype);
+		}
+	}
+	return query.archetypes;
+}
+
+/// @brief Gives a new entity a record, reusing a free index if there is one, and a row in an archetype.
+/// @param archetype: The archetype of the entity.
+/// @return PenguinEntityId: The id of the entity.
+PenguinEntityId PenguinWorld::allocate_entity(PenguinArchetype* archetype) {
+	uint32_t index;
+	if (!free_indices.empty()) {
+		index = free_indices.back();
+		free_indices.pop_back();
+	}
+	else {
+		Exception::throw_if(records.size() >= UINT32_MAX, "Too many entities are alive.", RUNTIME_ERROR);
+		index = (uint32_t)records.size();
+		records.emplace_back();
+	}
+
+	EntityRecord& record = records[index];
+	PenguinEntityId entity{ index, record.generation };
+	record.archetype = archetype;
+	record.row = archetype->push_entity(entity);
+	entity_count++;
+	return entity;
+}
+
+/// @brief Gets the archetype of a set of component types, creating it if needed.
+/// @param mask: The component types.
+/// @return PenguinArchetype*: The archetype.
+PenguinArchetype* PenguinWorld::get_archetype(PenguinComponentMask mask) {
+	auto it = archetypes_by_mask.find(mask);
+	if (it != archetypes_by_mask.end()) {
+		return it->second;
+	}
+
+	archetypes.push_back(std::make_unique<PenguinArchetype>(mask));
+	PenguinArchetype* archetype = archetypes.back().get();
+	archetypes_by_mask.emplace(mask, archetype);
+	return archetype;
+}
+
+/// @brief Moves an entity to another archetype, keeping the components both archetypes share.
+///
+/// Components the target archetype lacks are destroyed. Components only the target has are
+/// left uninitialized for the caller to construct.
+///
+/// @param record: The record of the entity.
+/// @param target: The archetype to move the entity to.
+void PenguinWorld::move_entity(EntityRecord& record, PenguinArchetype* target) {
+	PenguinArchetype* source = record.archetype;
+	size_t source_row = record.row;
+	size_t target_row = target->push_entity(source->get_entity(source_row));
+
+	const std::vector<PenguinComponentId>& source_components = source->get_components();
+	for (size_t column = 0; column < source_components.size(); column++) {
+		const PenguinComponentInfo& info = PenguinComponentRegistry::get_info(source_components[column]);
+		int target_column = target->get_column(source_components[column]);
+		if (target_column >= 0) {
+			info.relocate(target->get_component(target_row, target_column), source->get_component(source_row, (int)column));
+		}
+		else {
+			info.destroy(source->get_component(source_row, (int)column));
+		}
+	}
+
+	PenguinEntityId moved_entity = source->erase_row(source_row, false);
+	if (!moved_entity.is_null()) {
+		records[moved_entity.index].row = source_row;
+	}
+
+	record.archetype = target;
+	record.row = target_row;
+}
+
+/// @brief Gets the record of an entity.
+///
+/// If the entity does not exist, an exception is thrown.
+///
+/// @param entity: The entity.
+/// @return EntityRecord&: The record of the entity.
+PenguinWorld::EntityRecord& PenguinWorld::get_record(PenguinEntityId entity) {
+	Exception::throw_if(!is_alive(entity), "The entity does not exist.", RUNTIME_ERROR);
+	return records[entity.index];
+}
+
+/// @brief Gets the record of an entity.
+///
+/// If the entity does not exist, an exception is thrown.
+///
+/// @param entity: The entity.
+/// @return const EntityRecord&: The record of the entity.
+const PenguinWorld::EntityRecord& PenguinWorld::get_record(PenguinEntityId entity) const {
+	Exception::throw_if(!is_alive(entity), "The entity does not exist.", RUNTIME_ERROR);
+	return records[entity.index];
+}
+
+/// @brief Throws an exception if a query is running, as structural changes would move the data it iterates.
+void PenguinWorld::check_structural_change() const {
+	Exception::throw_if(iteration_depth.load(std::memory_order_relaxed) > 0,
+		"Entities and components cannot be created or removed while a query runs. Use the world's command buffer instead.", RUNTIME_ERROR);
+}
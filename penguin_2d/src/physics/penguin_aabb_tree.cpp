@@ -0,0 +1,711 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_aabb_tree.cpp                                                 ///
+///                                                                             ///
+/// PenguinAABBTree inserts a leaf next to the sibling that grows the tree's    ///
+/// perimeter least, and keeps the tree balanced with rotations on the way back ///
+/// up. build() and rebuild() instead split the leaves top-down into 16 bins by ///
+/// centroid, choosing the split with the smallest perimeter-weighted cost.     ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_aabb_tree.hpp"
+#include "exception.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace Penguin2D;
+
+/// @brief Constructs an empty PenguinAABBTree.
+/// @param margin: How far the bounds of a dynamic collider are fattened on each side.
+PenguinAABBTree::PenguinAABBTree(float margin)
+	: margin(std::max(0.0f, margin)) {
+}
+
+/// @brief Adds a collider.
+///
+/// If the id is already in the tree, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @param bounds: The bounds of the collider.
+/// @param is_static: True if the collider never moves, so its bounds are not fattened.
+void PenguinAABBTree::insert(PenguinColliderId id, const Rect2<float>& bounds, bool is_static) {
+	Exception::throw_if(id == UINT32_MAX, "The collider id " + std::to_string(id) + " is reserved.", RUNTIME_ERROR);
+	if (id >= leaves.size()) {
+		leaves.resize((size_t)id + 1, NULL_NODE);
+	}
+	Exception::throw_if(leaves[id] != NULL_NODE, "The collider " + std::to_string(id) + " is already in the AABB tree.", RUNTIME_ERROR);
+
+	int32_t leaf = allocate_node();
+	Node& node = nodes[leaf];
+	node.bounds = bounds;
+	node.fat_bounds = get_fat_bounds(bounds, Vector2<float>(), is_static);
+	node.id = id;
+	node.is_static = is_static;
+	leaves[id] = leaf;
+	leaf_count++;
+
+	insert_leaf(leaf);
+}
+
+/// @brief Updates the bounds of a collider.
+///
+/// If the id is not in the tree, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @param bounds: The new bounds of the collider.
+/// @param displacement: The expected movement before the next update, used to fatten the bounds ahead of it.
+/// @return bool: True if the collider left its fattened bounds and was reinserted, otherwise false.
+bool PenguinAABBTree::move(PenguinColliderId id, const Rect2<float>& bounds, Vector2<float> displacement) {
+	int32_t leaf = get_leaf(id);
+	nodes[leaf].bounds = bounds;
+	if (nodes[leaf].fat_bounds.contains(to_bounds(bounds))) {
+		return false;
+	}
+
+	remove_leaf(leaf);
+	nodes[leaf].fat_bounds = get_fat_bounds(bounds, displacement, nodes[leaf].is_static);
+	insert_leaf(leaf);
+	return true;
+}
+
+/// @brief Removes a collider.
+///
+/// If the id is not in the tree, an exception is thrown.
+///
+/// @param id: The id of the collider.
+void PenguinAABBTree::remove(PenguinColliderId id) {
+	int32_t leaf = get_leaf(id);
+	remove_leaf(leaf);
+	free_node(leaf);
+	leaves[id] = NULL_NODE;
+	leaf_count--;
+}
+
+/// @brief Checks if a collider is in the tree.
+/// @param id: The id of the collider.
+/// @return bool: True if the collider is in the tree, otherwise false.
+bool PenguinAABBTree::contains(PenguinColliderId id) const {
+	return id < leaves.size() && leaves[id] != NULL_NODE;
+}
+
+/// @brief Gets the bounds of a collider.
+///
+/// If the id is not in the tree, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @return const Rect2<float>&: The bounds of the collider.
+const Rect2<float>& PenguinAABBTree::get_bounds(PenguinColliderId id) const {
+	return nodes[get_leaf(id)].bounds;
+}
+
+/// @brief Gets the fattened bounds of a collider, within which it can move without a reinsert.
+///
+/// If the id is not in the tree, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @return Rect2<float>: The fattened bounds of the collider.
+Rect2<float> PenguinAABBTree::get_fat_bounds(PenguinColliderId id) const {
+	const Bounds& bounds = nodes[get_leaf(id)].fat_bounds;
+	return Rect2<float>(bounds.min_x, bounds.min_y, bounds.max_x - bounds.min_x, bounds.max_y - bounds.min_y);
+}
+
+/// @brief Removes every collider.
+void PenguinAABBTree::clear() {
+	nodes.clear();
+	root = NULL_NODE;
+	free_list = NULL_NODE;
+	leaves.clear();
+	leaf_count = 0;
+}
+
+/// @brief Replaces every collider and builds the tree with the surface area heuristic (e.g., on level load).
+///
+/// If an id appears twice, an exception is thrown and the tree is left empty.
+///
+/// @param colliders: The id and bounds of each collider.
+/// @param is_static: True if the colliders never move.
+void PenguinAABBTree::build(const std::vector<std::pair<PenguinColliderId, Rect2<float>>>& colliders, bool is_static) {
+	clear();
+	nodes.reserve(colliders.size() * 2);
+
+	for (const auto& [id, bounds] : colliders) {
+		if (id == UINT32_MAX || (id < leaves.size() && leaves[id] != NULL_NODE)) {
+			clear();
+			Exception::throw_if(true, "The collider " + std::to_string(id) + " is reserved or appears twice.", RUNTIME_ERROR);
+		}
+		if (id >= leaves.size()) {
+			leaves.resize((size_t)id + 1, NULL_NODE);
+		}
+
+		int32_t leaf = allocate_node();
+		Node& node = nodes[leaf];
+		node.bounds = bounds;
+		node.fat_bounds = get_fat_bounds(bounds, Vector2<float>(), is_static);
+		node.id = id;
+		node.is_static = is_static;
+		leaves[id] = leaf;
+		leaf_count++;
+	}
+
+	rebuild();
+}
+
+/// @brief Rebuilds the tree over its current colliders with the surface area heuristic.
+void PenguinAABBTree::rebuild() {
+	std::vector<int32_t> leaf_nodes;
+	leaf_nodes.reserve(leaf_count);
+	for (int32_t node = 0; node < (int32_t)nodes.size(); node++) {
+		if (nodes[node].height == 0) {
+			leaf_nodes.push_back(node);
+		}
+		else if (nodes[node].height > 0) {
+			free_node(node);
+		}
+	}
+
+	root = leaf_nodes.empty() ? NULL_NODE : build_range(leaf_nodes.data(), leaf_nodes.size(), 0);
+	if (root != NULL_NODE) {
+		nodes[root].parent = NULL_NODE;
+	}
+}
+
+/// @brief Gets the height of the tree.
+/// @return int: The number of levels below the root, or -1 if the tree is empty.
+int PenguinAABBTree::get_height() const {
+	return root == NULL_NODE ? -1 : nodes[root].height;
+}
+
+/// @brief Gets the quality of the tree: the summed perimeter of every node over the root's perimeter.
+/// @return float: The ratio, lower is better (0 if the tree is empty).
+float PenguinAABBTree::get_perimeter_ratio() const {
+	if (root == NULL_NODE) {
+		return 0.0f;
+	}
+
+	double total_perimeter = 0.0;
+	for (const Node& node : nodes) {
+		if (node.height >= 0) {
+			total_perimeter += node.fat_bounds.get_perimeter();
+		}
+	}
+	float root_perimeter = nodes[root].fat_bounds.get_perimeter();
+	return root_perimeter > 0.0f ? (float)(total_perimeter / root_perimeter) : 0.0f;
+}
+
+/// @brief Finds every pair of colliders whose bounds overlap. Pairs of two static colliders are skipped.
+///
+/// Each dynamic collider is queried against the tree. A pair of dynamic colliders is kept
+/// by the one with the lower leaf index, so it is reported once.
+///
+/// @param pairs: Cleared, then filled with each overlapping pair once.
+void PenguinAABBTree::query_pairs(std::vector<PenguinColliderPair>& pairs) const {
+	pairs.clear();
+	if (root == NULL_NODE) {
+		return;
+	}
+
+	std::vector<int32_t> stack;
+	for (int32_t leaf = 0; leaf < (int32_t)nodes.size(); leaf++) {
+		const Node& collider = nodes[leaf];
+		if (collider.height != 0 || collider.is_static) {
+			continue;
+		}
+
+		Bounds query = to_bounds(collider.bounds);
+		stack.push_back(root);
+		while (!stack.empty()) {
+			const Node& node = nodes[stack.back()];
+			int32_t index = stack.back();
+			stack.pop_back();
+			if (!node.fat_bounds.overlaps(query)) {
+				continue;
+			}
+
+			if (node.is_leaf()) {
+				if (index != leaf && (node.is_static || index > leaf) && collider.bounds.has_intersection(node.bounds)) {
+					pairs.emplace_back(std::min(collider.id, node.id), std::max(collider.id, node.id));
+				}
+			}
+			else {
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+}
+
+/// @brief Finds every collider whose bounds overlap an area.
+/// @param area: The area to search.
+/// @param results: Cleared, then filled with each overlapping collider once.
+void PenguinAABBTree::query_rect(const Rect2<float>& area, std::vector<PenguinColliderId>& results) const {
+	results.clear();
+	if (root == NULL_NODE || !(area.size.x >= 0.0f && area.size.y >= 0.0f)) {
+		return;
+	}
+
+	Bounds query = to_bounds(area);
+	std::vector<int32_t> stack;
+	stack.push_back(root);
+	while (!stack.empty()) {
+		const Node& node = nodes[stack.back()];
+		stack.pop_back();
+		if (!node.fat_bounds.overlaps(query)) {
+			continue;
+		}
+
+		if (node.is_leaf()) {
+			if (area.has_intersection(node.bounds)) {
+				results.push_back(node.id);
+			}
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+/// @brief Finds every collider whose bounds contain a point, edges included.
+/// @param point: The point to search.
+/// @param results: Cleared, then filled with each collider containing the point.
+void PenguinAABBTree::query_point(Vector2<float> point, std::vector<PenguinColliderId>& results) const {
+	query_rect(Rect2<float>(point, Vector2<float>(0.0f, 0.0f)), results);
+}
+
+/// @brief Finds the first collider hit by a line segment.
+/// @param start: The start of the segment.
+/// @param end: The end of the segment.
+/// @param hit: Set to the first hit, if any.
+/// @return bool: True if a collider was hit, otherwise false.
+bool PenguinAABBTree::ray_cast(Vector2<float> start, Vector2<float> end, PenguinRayHit& hit) const {
+	return cast(start, end - start, Vector2<float>(0.0f, 0.0f), hit);
+}
+
+/// @brief Finds the first collider hit by a box moving in a straight line.
+/// @param box: The box at the start of its movement.
+/// @param displacement: The movement of the box.
+/// @param hit: Set to the first hit, if any. The hit point is the box's position when it hits.
+/// @return bool: True if a collider was hit, otherwise false.
+bool PenguinAABBTree::sweep(const Rect2<float>& box, Vector2<float> displacement, PenguinRayHit& hit) const {
+	if (!(box.size.x >= 0.0f && box.size.y >= 0.0f)) {
+		return false;
+	}
+	return cast(box.position, displacement, box.size, hit);
+}
+
+/// @brief Takes a node from the free list, or appends one.
+/// @return int32_t: The node, reset to an unlinked leaf.
+int32_t PenguinAABBTree::allocate_node() {
+	int32_t node;
+	if (free_list != NULL_NODE) {
+		node = free_list;
+		free_list = nodes[node].parent;
+		nodes[node] = Node{};
+	}
+	else {
+		node = (int32_t)nodes.size();
+		nodes.emplace_back();
+	}
+	return node;
+}
+
+/// @brief Returns a node to the free list.
+/// @param node: The node.
+void PenguinAABBTree::free_node(int32_t node) {
+	nodes[node].parent = free_list;
+	nodes[node].child1 = NULL_NODE;
+	nodes[node].child2 = NULL_NODE;
+	nodes[node].height = -1;
+	free_list = node;
+}
+
+/// @brief Links a leaf into the tree next to the sibling that grows the tree's perimeter least.
+///
+/// The descent stops at a branch when pairing the leaf with the whole branch is cheaper
+/// than pushing it into either child. Every ancestor is then refitted and rebalanced.
+///
+/// @param leaf: The leaf.
+void PenguinAABBTree::insert_leaf(int32_t leaf) {
+	if (root == NULL_NODE) {
+		root = leaf;
+		nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	Bounds leaf_bounds = nodes[leaf].fat_bounds;
+	int32_t index = root;
+	while (!nodes[index].is_leaf()) {
+		const Node& node = nodes[index];
+		float combined_perimeter = Bounds::combine(node.fat_bounds, leaf_bounds).get_perimeter();
+
+		// The cost of pairing the leaf with this node, and the growth every ancestor pays for the leaf anyway.
+		float cost = 2.0f * combined_perimeter;
+		float inheritance_cost = 2.0f * (combined_perimeter - node.fat_bounds.get_perimeter());
+
+		auto descend_cost = [&](int32_t child) {
+			const Node& child_node = nodes[child];
+			float perimeter = Bounds::combine(leaf_bounds, child_node.fat_bounds).get_perimeter();
+			return (child_node.is_leaf() ? perimeter : perimeter - child_node.fat_bounds.get_perimeter()) + inheritance_cost;
+		};
+		float cost1 = descend_cost(node.child1);
+		float cost2 = descend_cost(node.child2);
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	int32_t sibling = index;
+	int32_t old_parent = nodes[sibling].parent;
+	int32_t new_parent = allocate_node();
+	nodes[new_parent].parent = old_parent;
+	nodes[new_parent].fat_bounds = Bounds::combine(leaf_bounds, nodes[sibling].fat_bounds);
+	nodes[new_parent].height = nodes[sibling].height + 1;
+	nodes[new_parent].child1 = sibling;
+	nodes[new_parent].child2 = leaf;
+	nodes[sibling].parent = new_parent;
+	nodes[leaf].parent = new_parent;
+
+	if (old_parent == NULL_NODE) {
+		root = new_parent;
+	}
+	else if (nodes[old_parent].child1 == sibling) {
+		nodes[old_parent].child1 = new_parent;
+	}
+	else {
+		nodes[old_parent].child2 = new_parent;
+	}
+
+	for (index = nodes[leaf].parent; index != NULL_NODE; index = nodes[index].parent) {
+		index = balance(index);
+		Node& node = nodes[index];
+		node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+		node.fat_bounds = Bounds::combine(nodes[node.child1].fat_bounds, nodes[node.child2].fat_bounds);
+	}
+}
+
+/// @brief Unlinks a leaf from the tree, replacing its parent with its sibling.
+/// @param leaf: The leaf.
+void PenguinAABBTree::remove_leaf(int32_t leaf) {
+	if (leaf == root) {
+		root = NULL_NODE;
+		return;
+	}
+
+	int32_t parent = nodes[leaf].parent;
+	int32_t grand_parent = nodes[parent].parent;
+	int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	free_node(parent);
+	nodes[sibling].parent = grand_parent;
+	if (grand_parent == NULL_NODE) {
+		root = sibling;
+		return;
+	}
+
+	if (nodes[grand_parent].child1 == parent) {
+		nodes[grand_parent].child1 = sibling;
+	}
+	else {
+		nodes[grand_parent].child2 = sibling;
+	}
+
+	for (int32_t index = grand_parent; index != NULL_NODE; index = nodes[index].parent) {
+		index = balance(index);
+		Node& node = nodes[index];
+		node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+		node.fat_bounds = Bounds::combine(nodes[node.child1].fat_bounds, nodes[node.child2].fat_bounds);
+	}
+}
+
+/// @brief Rotates the taller child of a node up if the children's heights differ by more than one.
+/// @param a: The node.
+/// @return int32_t: The node now in a's place.
+int32_t PenguinAABBTree::balance(int32_t a) {
+	if (nodes[a].is_leaf() || nodes[a].height < 2) {
+		return a;
+	}
+
+	int32_t b = nodes[a].child1;
+	int32_t c = nodes[a].child2;
+	int32_t difference = nodes[c].height - nodes[b].height;
+	if (difference >= -1 && difference <= 1) {
+		return a;
+	}
+
+	// Rotate the taller child (up) above a. Of up's children, the taller stays with up and the
+	// shorter takes up's place under a.
+	bool rotate_c = difference > 1;
+	int32_t up = rotate_c ? c : b;
+	int32_t other = rotate_c ? b : c;
+	int32_t f = nodes[up].child1;
+	int32_t g = nodes[up].child2;
+
+	nodes[up].child1 = a;
+	nodes[up].parent = nodes[a].parent;
+	nodes[a].parent = up;
+	if (nodes[up].parent == NULL_NODE) {
+		root = up;
+	}
+	else if (nodes[nodes[up].parent].child1 == a) {
+		nodes[nodes[up].parent].child1 = up;
+	}
+	else {
+		nodes[nodes[up].parent].child2 = up;
+	}
+
+	int32_t kept = nodes[f].height > nodes[g].height ? f : g;
+	int32_t moved = kept == f ? g : f;
+	nodes[up].child2 = kept;
+	if (rotate_c) {
+		nodes[a].child2 = moved;
+	}
+	else {
+		nodes[a].child1 = moved;
+	}
+	nodes[moved].parent = a;
+
+	nodes[a].fat_bounds = Bounds::combine(nodes[other].fat_bounds, nodes[moved].fat_bounds);
+	nodes[a].height = 1 + std::max(nodes[other].height, nodes[moved].height);
+	nodes[up].fat_bounds = Bounds::combine(nodes[a].fat_bounds, nodes[kept].fat_bounds);
+	nodes[up].height = 1 + std::max(nodes[a].height, nodes[kept].height);
+	return up;
+}
+
+/// @brief Builds a subtree over a range of leaves by splitting it with the binned surface area heuristic.
+///
+/// The leaves' centroids are sorted into bins along the longer axis of their bounds, and
+/// the range is split between the two bins that minimise the children's perimeters
+/// weighted by their leaf counts. The range is split at the median when the centroids
+/// coincide, when a split would leave a side empty, or deeper than MAX_SAH_DEPTH.
+///
+/// @param first: The first leaf of the range, reordered in place.
+/// @param count: The number of leaves in the range.
+/// @param depth: The depth of the subtree's root.
+/// @return int32_t: The root of the subtree.
+int32_t PenguinAABBTree::build_range(int32_t* first, size_t count, int32_t depth) {
+	if (count == 1) {
+		return first[0];
+	}
+
+	auto centroid = [this](int32_t node, bool x_axis) {
+		const Bounds& bounds = nodes[node].fat_bounds;
+		return x_axis ? bounds.min_x + bounds.max_x : bounds.min_y + bounds.max_y;
+	};
+
+	float min_x = centroid(first[0], true), max_x = min_x;
+	float min_y = centroid(first[0], false), max_y = min_y;
+	for (size_t i = 1; i < count; i++) {
+		float x = centroid(first[i], true);
+		float y = centroid(first[i], false);
+		min_x = std::min(min_x, x);
+		max_x = std::max(max_x, x);
+		min_y = std::min(min_y, y);
+		max_y = std::max(max_y, y);
+	}
+
+	bool x_axis = max_x - min_x >= max_y - min_y;
+	float axis_min = x_axis ? min_x : min_y;
+	float axis_extent = x_axis ? max_x - min_x : max_y - min_y;
+	size_t split = 0;
+
+	if (axis_extent > 0.0f && depth < MAX_SAH_DEPTH) {
+		constexpr int BIN_COUNT = 16;
+		auto get_bin = [&](int32_t node) {
+			return std::min(BIN_COUNT - 1, (int)((centroid(node, x_axis) - axis_min) / axis_extent * BIN_COUNT));
+		};
+
+		Bounds bin_bounds[BIN_COUNT];
+		size_t bin_counts[BIN_COUNT] = {};
+		for (size_t i = 0; i < count; i++) {
+			int bin = get_bin(first[i]);
+			bin_bounds[bin] = bin_counts[bin] == 0 ? nodes[first[i]].fat_bounds : Bounds::combine(bin_bounds[bin], nodes[first[i]].fat_bounds);
+			bin_counts[bin]++;
+		}
+
+		// Sweep from the right to get the bounds of every right side, then from the left to price each split.
+		float right_perimeters[BIN_COUNT] = {};
+		Bounds right_bounds;
+		size_t right_count = 0;
+		for (int bin = BIN_COUNT - 1; bin > 0; bin--) {
+			if (bin_counts[bin] > 0) {
+				right_bounds = right_count == 0 ? bin_bounds[bin] : Bounds::combine(right_bounds, bin_bounds[bin]);
+				right_count += bin_counts[bin];
+			}
+			right_perimeters[bin] = right_count > 0 ? right_bounds.get_perimeter() * right_count : 0.0f;
+		}
+
+		float best_cost = 0.0f;
+		int best_bin = -1;
+		Bounds left_bounds;
+		size_t left_count = 0;
+		for (int bin = 0; bin < BIN_COUNT - 1; bin++) {
+			if (bin_counts[bin] > 0) {
+				left_bounds = left_count == 0 ? bin_bounds[bin] : Bounds::combine(left_bounds, bin_bounds[bin]);
+				left_count += bin_counts[bin];
+			}
+			if (left_count == 0 || left_count == count) {
+				continue;
+			}
+
+			float cost = left_bounds.get_perimeter() * left_count + right_perimeters[bin + 1];
+			if (best_bin < 0 || cost < best_cost) {
+				best_cost = cost;
+				best_bin = bin;
+			}
+		}
+
+		if (best_bin >= 0) {
+			split = std::partition(first, first + count, [&](int32_t node) { return get_bin(node) <= best_bin; }) - first;
+		}
+	}
+
+	if (split == 0 || split == count) {
+		split = count / 2;
+		std::nth_element(first, first + split, first + count, [&](int32_t a, int32_t b) { return centroid(a, x_axis) < centroid(b, x_axis); });
+	}
+
+	int32_t child1 = build_range(first, split, depth + 1);
+	int32_t child2 = build_range(first + split, count - split, depth + 1);
+
+	int32_t node = allocate_node();
+	nodes[node].child1 = child1;
+	nodes[node].child2 = child2;
+	nodes[node].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+	nodes[node].fat_bounds = Bounds::combine(nodes[child1].fat_bounds, nodes[child2].fat_bounds);
+	nodes[child1].parent = node;
+	nodes[child2].parent = node;
+	return node;
+}
+
+/// @brief Gets the leaf of a collider.
+///
+/// If the id is not in the tree, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @return int32_t: The leaf.
+int32_t PenguinAABBTree::get_leaf(PenguinColliderId id) const {
+	Exception::throw_if(!contains(id), "The collider " + std::to_string(id) + " is not in the AABB tree.", RUNTIME_ERROR);
+	return leaves[id];
+}
+
+/// @brief Gets the bounds stored in a leaf for a collider's bounds.
+/// @param bounds: The bounds of the collider.
+/// @param displacement: The expected movement of the collider, added ahead of it.
+/// @param is_static: True if the collider never moves, so the bounds are not fattened.
+/// @return Bounds: The fattened bounds.
+PenguinAABBTree::Bounds PenguinAABBTree::get_fat_bounds(const Rect2<float>& bounds, Vector2<float> displacement, bool is_static) const {
+	Bounds fat_bounds = to_bounds(bounds);
+	if (is_static) {
+		return fat_bounds;
+	}
+
+	fat_bounds.min_x -= margin - std::min(0.0f, displacement.x);
+	fat_bounds.min_y -= margin - std::min(0.0f, displacement.y);
+	fat_bounds.max_x += margin + std::max(0.0f, displacement.x);
+	fat_bounds.max_y += margin + std::max(0.0f, displacement.y);
+	return fat_bounds;
+}
+
+/// @brief Finds the first collider hit by a box of some extent moving along a segment.
+///
+/// A box with its top-left corner at p overlaps a collider when p lies in the collider's
+/// bounds grown by the box's size to the left and up, so the sweep is a ray cast against
+/// the grown bounds. Subtrees the ray cannot reach before the closest hit so far are skipped.
+///
+/// @param start: The start of the segment (the box's top-left corner).
+/// @param delta: The segment, from its start to its end.
+/// @param extent: The size of the box, (0, 0) for a ray.
+/// @param hit: Set to the first hit, if any.
+/// @return bool: True if a collider was hit, otherwise false.
+bool PenguinAABBTree::cast(Vector2<float> start, Vector2<float> delta, Vector2<float> extent, PenguinRayHit& hit) const {
+	if (root == NULL_NODE) {
+		return false;
+	}
+
+	bool found = false;
+	float max_fraction = 1.0f;
+	std::vector<int32_t> stack;
+	stack.push_back(root);
+	while (!stack.empty()) {
+		const Node& node = nodes[stack.back()];
+		stack.pop_back();
+
+		Bounds bounds = node.is_leaf() ? to_bounds(node.bounds) : node.fat_bounds;
+		bounds.min_x -= extent.x;
+		bounds.min_y -= extent.y;
+
+		float fraction;
+		Vector2<float> normal;
+		if (!intersect_segment(bounds, start, delta, max_fraction, fraction, normal)) {
+			continue;
+		}
+
+		if (!node.is_leaf()) {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+		else if (node.bounds.size.x >= 0.0f && node.bounds.size.y >= 0.0f && (!found || fraction < max_fraction)) {
+			found = true;
+			max_fraction = fraction;
+			hit.id = node.id;
+			hit.fraction = fraction;
+			hit.point = Vector2<float>(start.x + delta.x * fraction, start.y + delta.y * fraction);
+			hit.normal = normal;
+		}
+	}
+	return found;
+}
+
+/// @brief Converts a rectangle to its corners. A negative size is treated as zero.
+/// @param rect: The rectangle.
+/// @return Bounds: The corners of the rectangle.
+PenguinAABBTree::Bounds PenguinAABBTree::to_bounds(const Rect2<float>& rect) {
+	return Bounds{ rect.position.x, rect.position.y,
+		rect.position.x + std::max(0.0f, rect.size.x), rect.position.y + std::max(0.0f, rect.size.y) };
+}
+
+/// @brief Intersects a segment with a box using the slab method.
+/// @param bounds: The box.
+/// @param start: The start of the segment.
+/// @param delta: The segment, from its start to its end.
+/// @param max_fraction: How far along the segment to look (0 to 1).
+/// @param fraction: Set to how far along the segment it enters the box (0 if it starts inside).
+/// @param normal: Set to the normal of the face the segment enters through, or (0, 0) if it starts inside.
+/// @return bool: True if the segment reaches the box within max_fraction, otherwise false.
+bool PenguinAABBTree::intersect_segment(const Bounds& bounds, Vector2<float> start, Vector2<float> delta, float max_fraction, float& fraction, Vector2<float>& normal) {
+	float enter = 0.0f;
+	float exit = max_fraction;
+	normal = Vector2<float>(0.0f, 0.0f);
+
+	const float starts[2] = { start.x, start.y };
+	const float deltas[2] = { delta.x, delta.y };
+	const float mins[2] = { bounds.min_x, bounds.min_y };
+	const float maxs[2] = { bounds.max_x, bounds.max_y };
+	for (int axis = 0; axis < 2; axis++) {
+		if (std::abs(deltas[axis]) < 1.0e-12f) {
+			if (starts[axis] < mins[axis] || starts[axis] > maxs[axis]) {
+				return false;
+			}
+			continue;
+		}
+
+		float inverse = 1.0f / deltas[axis];
+		float near_t = ((inverse > 0.0f ? mins[axis] : maxs[axis]) - starts[axis]) * inverse;
+		float far_t = ((inverse > 0.0f ? maxs[axis] : mins[axis]) - starts[axis]) * inverse;
+		if (near_t > enter) {
+			enter = near_t;
+			normal = axis == 0 ? Vector2<float>(inverse > 0.0f ? -1.0f : 1.0f, 0.0f) : Vector2<float>(0.0f, inverse > 0.0f ? -1.0f : 1.0f);
+		}
+		exit = std::min(exit, far_t);
+		if (enter > exit) {
+			return false;
+		}
+	}
+
+	fraction = enter;
+	return true;
+}
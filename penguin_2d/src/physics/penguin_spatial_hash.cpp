@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File: penguin_spatial_hash.cpp                                              ///
+///                                                                             ///
+/// PenguinSpatialHash lists each collider in the cells its bounds touch. A     ///
+/// pair, or a collider found by an area query, may share several cells. It is  ///
+/// only reported from the first of them (the one with the smallest x and y),   ///
+/// so results need no de-duplication.                                          ///
+///                                                                             ///
+/// Colliders in the overflow list are in no cell. Queries test them directly,  ///
+/// and query_pairs() tests each against every collider.                        ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_spatial_hash.hpp"
+#include "exception.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <cmath>
+
+using namespace Penguin2D;
+
+namespace {
+	constexpr int32_t MAX_CELL = 1000000000; /// The largest cell index, so far away bounds cannot overflow one.
+
+	/// @brief Converts a coordinate in cells to a cell index, clamped to MAX_CELL. NaN maps to cell 0.
+	int32_t to_cell(float coordinate) {
+		if (std::isnan(coordinate)) {
+			return 0;
+		}
+		return (int32_t)std::clamp(std::floor((double)coordinate), -(double)MAX_CELL, (double)MAX_CELL);
+	}
+}
+
+/// @brief Constructs an empty PenguinSpatialHash.
+///
+/// If the cell size is not positive, an exception is thrown.
+///
+/// @param cell_size: The width and height of a grid cell.
+PenguinSpatialHash::PenguinSpatialHash(float cell_size)
+	: cell_size(cell_size), inverse_cell_size(1.0f / cell_size) {
+	Exception::throw_if(!(cell_size > 0.0f), "The cell size of a spatial hash must be positive.", RUNTIME_ERROR);
+}
+
+/// @brief Adds a collider.
+///
+/// If the id is already in the hash, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @param bounds: The bounds of the collider.
+void PenguinSpatialHash::insert(PenguinColliderId id, const Rect2<float>& bounds) {
+	Exception::throw_if(id == NO_SLOT, "The collider id " + std::to_string(id) + " is reserved.", RUNTIME_ERROR);
+	if (id >= slots.size()) {
+		slots.resize((size_t)id + 1, NO_SLOT);
+	}
+	Exception::throw_if(slots[id] != NO_SLOT, "The collider " + std::to_string(id) + " is already in the spatial hash.", RUNTIME_ERROR);
+
+	CellRange range = get_cell_range(bounds);
+	bool too_large = range.is_too_large();
+	if (too_large) {
+		range = CellRange{};
+		overflow.push_back(id);
+	}
+	slots[id] = (uint32_t)colliders.size();
+	colliders.push_back(Collider{ id, bounds, range, too_large });
+
+	for (int32_t y = range.min_y; y <= range.max_y; y++) {
+		for (int32_t x = range.min_x; x <= range.max_x; x++) {
+			add_to_cell(x, y, id);
+		}
+	}
+}
+
+/// @brief Updates the bounds of a collider. Only the cells it enters or leaves are changed.
+///
+/// If the id is not in the hash, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @param bounds: The new bounds of the collider.
+void PenguinSpatialHash::move(PenguinColliderId id, const Rect2<float>& bounds) {
+	Collider& collider = colliders[get_slot(id)];
+	collider.bounds = bounds;
+
+	CellRange old_range = collider.cells;
+	CellRange new_range = get_cell_range(bounds);
+	bool too_large = new_range.is_too_large();
+	if (too_large) {
+		new_range = CellRange{};
+	}
+	if (too_large != collider.overflow) {
+		if (too_large) {
+			overflow.push_back(id);
+		}
+		else {
+			remove_from_overflow(id);
+		}
+		collider.overflow = too_large;
+	}
+	if (new_range == old_range) {
+		return;
+	}
+
+	for (int32_t y = old_range.min_y; y <= old_range.max_y; y++) {
+		for (int32_t x = old_range.min_x; x <= old_range.max_x; x++) {
+			if (!new_range.contains(x, y)) {
+				remove_from_cell(x, y, id);
+			}
+		}
+	}
+	for (int32_t y = new_range.min_y; y <= new_range.max_y; y++) {
+		for (int32_t x = new_range.min_x; x <= new_range.max_x; x++) {
+			if (!old_range.contains(x, y)) {
+				add_to_cell(x, y, id);
+			}
+		}
+	}
+	collider.cells = new_range;
+}
+
+/// @brief Removes a collider.
+///
+/// If the id is not in the hash, an exception is thrown.
+///
+/// @param id: The id of the collider.
+void PenguinSpatialHash::remove(PenguinColliderId id) {
+	uint32_t slot = get_slot(id);
+	if (colliders[slot].overflow) {
+		remove_from_overflow(id);
+	}
+	CellRange range = colliders[slot].cells;
+	for (int32_t y = range.min_y; y <= range.max_y; y++) {
+		for (int32_t x = range.min_x; x <= range.max_x; x++) {
+			remove_from_cell(x, y, id);
+		}
+	}
+
+	// Keep the colliders packed by moving the last one into the gap.
+	if (slot + 1 != colliders.size()) {
+		colliders[slot] = colliders.back();
+		slots[colliders[slot].id] = slot;
+	}
+	colliders.pop_back();
+	slots[id] = NO_SLOT;
+}
+
+/// @brief Checks if a collider is in the hash.
+/// @param id: The id of the collider.
+/// @return bool: True if the collider is in the hash, otherwise false.
+bool PenguinSpatialHash::contains(PenguinColliderId id) const {
+	return id < slots.size() && slots[id] != NO_SLOT;
+}
+
+/// @brief Gets the bounds of a collider.
+///
+/// If the id is not in the hash, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @return const Rect2<float>&: The bounds of the collider.
+const Rect2<float>& PenguinSpatialHash::get_bounds(PenguinColliderId id) const {
+	return colliders[get_slot(id)].bounds;
+}
+
+/// @brief Removes every collider.
+void PenguinSpatialHash::clear() {
+	colliders.clear();
+	slots.clear();
+	cells.clear();
+	spare_cells.clear();
+	overflow.clear();
+}
+
+/// @brief Changes the cell size and re-indexes every collider.
+///
+/// If the cell size is not positive, an exception is thrown.
+///
+/// @param cell_size: The width and height of a grid cell.
+void PenguinSpatialHash::set_cell_size(float cell_size) {
+	Exception::throw_if(!(cell_size > 0.0f), "The cell size of a spatial hash must be positive.", RUNTIME_ERROR);
+
+	std::vector<Collider> old_colliders;
+	old_colliders.swap(colliders);
+	clear();
+
+	this->cell_size = cell_size;
+	inverse_cell_size = 1.0f / cell_size;
+	for (const Collider& collider : old_colliders) {
+		insert(collider.id, collider.bounds);
+	}
+}
+
+/// @brief Finds every pair of colliders whose bounds overlap.
+///
+/// Each cell tests the pairs listed in it, and keeps the pairs for which it is the first
+/// cell both colliders share. Each collider in the overflow list is then tested against
+/// every collider.
+///
+/// @param pairs: Cleared, then filled with each overlapping pair once.
+void PenguinSpatialHash::query_pairs(std::vector<PenguinColliderPair>& pairs) const {
+	pairs.clear();
+	for (const auto& [key, ids] : cells) {
+		int32_t x = (int32_t)(uint32_t)(key >> 32);
+		int32_t y = (int32_t)(uint32_t)key;
+
+		for (size_t i = 0; i < ids.size(); i++) {
+			const Collider& a = colliders[slots[ids[i]]];
+			for (size_t j = i + 1; j < ids.size(); j++) {
+				const Collider& b = colliders[slots[ids[j]]];
+				if (std::max(a.cells.min_x, b.cells.min_x) == x && std::max(a.cells.min_y, b.cells.min_y) == y && a.bounds.has_intersection(b.bounds)) {
+					pairs.emplace_back(std::min(a.id, b.id), std::max(a.id, b.id));
+				}
+			}
+		}
+	}
+
+	for (PenguinColliderId id : overflow) {
+		const Collider& a = colliders[slots[id]];
+		for (const Collider& b : colliders) {
+			// A pair of overflow colliders is reported by the one with the smaller id.
+			if ((b.overflow && b.id <= a.id) || !a.bounds.has_intersection(b.bounds)) {
+				continue;
+			}
+			pairs.emplace_back(std::min(a.id, b.id), std::max(a.id, b.id));
+		}
+	}
+}
+
+/// @brief Finds every collider whose bounds overlap an area.
+/// @param area: The area to search.
+/// @param results: Cleared, then filled with each overlapping collider once.
+void PenguinSpatialHash::query_rect(const Rect2<float>& area, std::vector<PenguinColliderId>& results) const {
+	results.clear();
+	CellRange range = get_cell_range(area);
+	if (range.min_x > range.max_x) {
+		return;
+	}
+
+	// An area spanning more cells than there are colliders is cheaper to test collider by collider.
+	if (((int64_t)range.max_x - range.min_x + 1) * ((int64_t)range.max_y - range.min_y + 1) > (int64_t)colliders.size()) {
+		for (const Collider& collider : colliders) {
+			if (area.has_intersection(collider.bounds)) {
+				results.push_back(collider.id);
+			}
+		}
+		return;
+	}
+
+	for (PenguinColliderId id : overflow) {
+		if (area.has_intersection(colliders[slots[id]].bounds)) {
+			results.push_back(id);
+		}
+	}
+
+	for (int32_t y = range.min_y; y <= range.max_y; y++) {
+		for (int32_t x = range.min_x; x <= range.max_x; x++) {
+			auto cell = cells.find(get_cell_key(x, y));
+			if (cell == cells.end()) {
+				continue;
+			}
+
+			for (PenguinColliderId id : cell->second) {
+				const Collider& collider = colliders[slots[id]];
+				if (std::max(range.min_x, collider.cells.min_x) == x && std::max(range.min_y, collider.cells.min_y) == y && area.has_intersection(collider.bounds)) {
+					results.push_back(id);
+				}
+			}
+		}
+	}
+}
+
+/// @brief Finds every collider whose bounds contain a point, edges included.
+/// @param point: The point to search.
+/// @param results: Cleared, then filled with each collider containing the point.
+void PenguinSpatialHash::query_point(Vector2<float> point, std::vector<PenguinColliderId>& results) const {
+	results.clear();
+	Rect2<float> point_rect(point, Vector2<float>(0.0f, 0.0f));
+	for (PenguinColliderId id : overflow) {
+		if (point_rect.has_intersection(colliders[slots[id]].bounds)) {
+			results.push_back(id);
+		}
+	}
+
+	auto cell = cells.find(get_cell_key(to_cell(point.x * inverse_cell_size), to_cell(point.y * inverse_cell_size)));
+	if (cell == cells.end()) {
+		return;
+	}
+
+	for (PenguinColliderId id : cell->second) {
+		if (point_rect.has_intersection(colliders[slots[id]].bounds)) {
+			results.push_back(id);
+		}
+	}
+}
+
+/// @brief Gets how colliders are spread over the cells, to help choose a cell size.
+/// @return PenguinSpatialHashStats: The statistics of the hash.
+PenguinSpatialHashStats PenguinSpatialHash::get_stats() const {
+	PenguinSpatialHashStats stats;
+	stats.colliders = colliders.size();
+	stats.cells = cells.size();
+	stats.overflow_colliders = overflow.size();
+	for (const auto& [key, ids] : cells) {
+		stats.entries += ids.size();
+		stats.max_cell_colliders = std::max(stats.max_cell_colliders, ids.size());
+	}
+	stats.mean_cell_colliders = stats.cells > 0 ? (double)stats.entries / stats.cells : 0.0;
+	return stats;
+}
+
+/// @brief Gets the cells that bounds touch. A cell edge on the bounds' far edge counts as touched.
+/// @param bounds: The bounds.
+/// @return CellRange: The cells, or an empty range if the bounds have a negative size. Bounds with
+/// a NaN position span every cell, so they go to the overflow list.
+PenguinSpatialHash::CellRange PenguinSpatialHash::get_cell_range(const Rect2<float>& bounds) const {
+	if (!(bounds.size.x >= 0.0f && bounds.size.y >= 0.0f)) {
+		return CellRange{};
+	}
+	if (std::isnan(bounds.position.x) || std::isnan(bounds.position.y)) {
+		return CellRange{ -MAX_CELL, -MAX_CELL, MAX_CELL, MAX_CELL };
+	}
+
+	return CellRange{
+		to_cell(bounds.position.x * inverse_cell_size),
+		to_cell(bounds.position.y * inverse_cell_size),
+		to_cell((bounds.position.x + bounds.size.x) * inverse_cell_size),
+		to_cell((bounds.position.y + bounds.size.y) * inverse_cell_size)
+	};
+}
+
+/// @brief Takes a collider out of the overflow list.
+/// @param id: The id of the collider.
+void PenguinSpatialHash::remove_from_overflow(PenguinColliderId id) {
+	auto it = std::find(overflow.begin(), overflow.end(), id);
+	if (it != overflow.end()) {
+		*it = overflow.back();
+		overflow.pop_back();
+	}
+}
+
+/// @brief Lists a collider in a cell, creating the cell from a spare list if needed.
+/// @param x: The x index of the cell.
+/// @param y: The y index of the cell.
+/// @param id: The id of the collider.
+void PenguinSpatialHash::add_to_cell(int32_t x, int32_t y, PenguinColliderId id) {
+	auto [cell, created] = cells.try_emplace(get_cell_key(x, y));
+	if (created && !spare_cells.empty()) {
+		cell->second.swap(spare_cells.back());
+		spare_cells.pop_back();
+	}
+	cell->second.push_back(id);
+}
+
+/// @brief Unlists a collider from a cell, and removes the cell once it is empty.
+/// @param x: The x index of the cell.
+/// @param y: The y index of the cell.
+/// @param id: The id of the collider.
+void PenguinSpatialHash::remove_from_cell(int32_t x, int32_t y, PenguinColliderId id) {
+	auto cell = cells.find(get_cell_key(x, y));
+	if (cell == cells.end()) {
+		return;
+	}
+
+	std::vector<PenguinColliderId>& ids = cell->second;
+	auto it = std::find(ids.begin(), ids.end(), id);
+	if (it != ids.end()) {
+		*it = ids.back();
+		ids.pop_back();
+	}
+	if (ids.empty()) {
+		spare_cells.push_back(std::move(ids));
+		cells.erase(cell);
+	}
+}
+
+/// @brief Gets the index of a collider in the packed colliders.
+///
+/// If the id is not in the hash, an exception is thrown.
+///
+/// @param id: The id of the collider.
+/// @return uint32_t: The index of the collider.
+uint32_t PenguinSpatialHash::get_slot(PenguinColliderId id) const {
+	Exception::throw_if(!contains(id), "The collider " + std::to_string(id) + " is not in the spatial hash.", RUNTIME_ERROR);
+	return slots[id];
+}
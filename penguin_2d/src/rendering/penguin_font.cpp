@@ -20,7 +20,8 @@ using namespace Penguin2D;
 /// @param font_path: The file path to the font.
 /// @param font_size: The desired font size.
 PenguinFont::PenguinFont(const std::string& font_path, float font_size)
-	: font(TTF_OpenFont(font_path.c_str(), font_size), &TTF_CloseFont) {
+	: font_data(nullptr),
+	font(TTF_OpenFont(font_path.c_str(), font_size), &TTF_CloseFont) {
 
 	Exception::throw_if(
 		!font,
@@ -29,13 +30,37 @@ PenguinFont::PenguinFont(const std::string& font_path, float font_size)
 	);
 }
 
+/// @brief Constructs a PenguinFont from font file contents that are already loaded.
+/// 
+/// SDL_ttf reads glyphs from the file contents on demand, so the font keeps a
+/// reference to them. Fonts of different sizes and styles can share the same
+/// contents without reading or copying the file again. If the font cannot be
+/// opened, an exception is thrown.
+/// 
+/// @param font_data: The contents of the font file.
+/// @param font_size: The desired font size.
+PenguinFont::PenguinFont(std::shared_ptr<const PenguinFontData> font_data, float font_size)
+	: font_data(std::move(font_data)),
+	font(nullptr, &TTF_CloseFont) {
+
+	Exception::throw_if(!this->font_data, "The font data has not been loaded.", TEXT_ERROR);
+
+	// The stream is closed with the font, but the memory it reads from is owned by font_data.
+	font.reset(TTF_OpenFontIO(SDL_IOFromConstMem(this->font_data->bytes.get(), this->font_data->size), true, font_size));
+	Exception::throw_if(
+		!font,
+		"The font could not be initialized. Please ensure that the file is a valid font.",
+		TEXT_ERROR
+	);
+}
+
 /// @brief Retrieves the internal SDL font object.
 /// 
 /// This function returns a pointer to the loaded font. If the font has not been 
 /// initialized, an exception is thrown.
 /// 
 /// @return A pointer to the internal TTF_Font object.
-TTF_Font* PenguinFont::get_font() {
+TTF_Font* PenguinFont::get_font() const {
 	Exception::throw_if(
 		!font,
 		"The font has not been initialized.",
@@ -64,7 +89,7 @@ void PenguinFont::set_font_size(float font_size) {
 /// If the font size cannot be determined, an exception is thrown.
 /// 
 /// @return The current font size.
-float PenguinFont::get_font_size() {
+float PenguinFont::get_font_size() const {
 	float font_size = TTF_GetFontSize(font.get());
 	Exception::throw_if(
 		font_size == 0.0f,
@@ -92,7 +117,7 @@ void PenguinFont::set_font_outline_size(int outline_size) {
 /// @brief Retrieves the current font outline size.
 /// 
 /// @return The current outline size of the font.
-int PenguinFont::get_font_outline_size() {
+int PenguinFont::get_font_outline_size() const {
 	return TTF_GetFontOutline(font.get());
 }
 
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_font_registry.cpp                                        ///
+///                                                                             ///
+/// PenguinFontRegistry reads each font file once and opens each combination   ///
+/// of size, style, and outline once, sharing the fonts between their users.   ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_font_registry.hpp"
+#include "file_path.hpp"
+
+using namespace Penguin2D;
+
+/// @brief Retrieves a font, opening it if no font with the same settings is open.
+///
+/// Paths that refer to the same file share the file contents and fonts. The font is
+/// shared, so it is read-only. If the font file cannot be read or opened, or its style
+/// or outline cannot be set, an exception is thrown.
+///
+/// @param path: The file path to the font.
+/// @param size: The size of the font in pixels.
+/// @param style: The styles applied to the font.
+/// @param outline: The outline size of the font in pixels.
+/// @return const PenguinFont&: A read-only reference to the shared font.
+const PenguinFont& PenguinFontRegistry::get_font(const std::string& path, float size, TTF_FontStyleFlags style, int outline) {
+	std::string canonical = get_canonical_path(path);
+	PenguinFontKey key{ canonical, size, style, outline };
+
+	auto cached = fonts.find(key);
+	if (cached != fonts.end()) {
+		return *cached->second;
+	}
+
+	auto font = std::make_unique<PenguinFont>(load_file(path, canonical), size);
+	if (style != TTF_STYLE_NORMAL) {
+		// TTF_SetFontStyle() does not report errors, so read the style back to check it was applied.
+		TTF_SetFontStyle(font->get_font(), style);
+		Exception::throw_if(
+			TTF_GetFontStyle(font->get_font()) != style,
+			"The font style could not be set.",
+			TEXT_ERROR
+		);
+	}
+	if (outline != 0) {
+		font->set_font_outline_size(outline);
+	}
+
+	return *fonts.emplace(std::move(key), std::move(font)).first->second;
+}
+
+/// @brief Gets the number of open fonts.
+/// @return size_t: The number of fonts.
+size_t PenguinFontRegistry::get_font_count() const {
+	return fonts.size();
+}
+
+/// @brief Gets the number of font files loaded into memory.
+/// @return size_t: The number of font files.
+size_t PenguinFontRegistry::get_file_count() const {
+	return files.size();
+}
+
+/// @brief Retrieves the contents of a font file, reading it if it has not been read.
+/// @param path: The file path to the font.
+/// @param canonical: The canonical form of the path.
+/// @return The shared contents of the file.
+std::shared_ptr<const PenguinFontData> PenguinFontRegistry::load_file(const std::string& path, const std::string& canonical) {
+	auto cached = files.find(canonical);
+	if (cached != files.end()) {
+		return cached->second;
+	}
+
+	size_t size = 0;
+	void* bytes = SDL_LoadFile(path.c_str(), &size);
+	Exception::throw_if(
+		!bytes,
+		"The font could not be initialized. Please ensure that the file path exists in the project.",
+		TEXT_ERROR
+	);
+
+	auto data = std::make_shared<const PenguinFontData>(PenguinFontData{ std::unique_ptr<void, void(*)(void*)>(bytes, &SDL_free), size });
+	files.emplace(canonical, data);
+	return data;
+}
@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_glyph_atlas.cpp                                          ///
+///                                                                             ///
+/// PenguinGlyphAtlas rasterizes glyphs of a font on demand and packs them into ///
+/// page textures, so text can be drawn as batched textured quads.              ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_glyph_atlas.hpp"
+
+// C++ library files
+#include <algorithm>
+
+using namespace Penguin2D;
+
+/// @brief Constructs an empty PenguinGlyphAtlas.
+///
+/// No pages are created until the first visible glyph is rasterized. Lines are spaced by
+/// the font's line skip, so multi-line text keeps the font's line spacing.
+///
+/// @param renderer: The PenguinRenderer used to create the page textures.
+/// @param font: The font to rasterize glyphs from.
+/// @param page_size: The width and height of each shared page in pixels, or 0 to size pages from the font's height.
+PenguinGlyphAtlas::PenguinGlyphAtlas(PenguinRenderer& renderer, const PenguinFont& font, int page_size)
+	: renderer(renderer),
+	font(font),
+	page_size(page_size == 0 ? get_page_size_for(font) : page_size),
+	line_height((float)TTF_GetFontLineSkip(font.get_font())) {
+
+	Exception::throw_if(page_size < 0, "The glyph atlas page size must not be negative.", TEXT_ERROR);
+}
+
+/// @brief Retrieves a glyph, rasterizing it if it has not been requested before.
+/// @param codepoint: The Unicode codepoint of the glyph.
+/// @return const PenguinGlyph&: The location and metrics of the glyph.
+const PenguinGlyph& PenguinGlyphAtlas::get_glyph(uint32_t codepoint) {
+	auto cached = glyphs.find(codepoint);
+	if (cached != glyphs.end()) {
+		return cached->second;
+	}
+
+	return glyphs.emplace(codepoint, rasterize(codepoint)).first->second;
+}
+
+/// @brief Gets the kerning between two glyphs.
+/// @param previous_codepoint: The codepoint of the glyph before.
+/// @param codepoint: The codepoint of the glyph after.
+/// @return float: The horizontal adjustment in pixels (0 if the font has no kerning for the pair).
+float PenguinGlyphAtlas::get_kerning(uint32_t previous_codepoint, uint32_t codepoint) {
+	int kerning = 0;
+	if (!TTF_GetGlyphKerning(font.get_font(), previous_codepoint, codepoint, &kerning)) {
+		return 0.0f;
+	}
+	return (float)kerning;
+}
+
+/// @brief Gets the distance between the tops of two lines of text.
+/// @return float: The line height in pixels.
+float PenguinGlyphAtlas::get_line_height() const {
+	return line_height;
+}
+
+/// @brief Gets the width and height of the pages shared by glyphs.
+/// @return int: The page size in pixels.
+int PenguinGlyphAtlas::get_page_size() const {
+	return page_size;
+}
+
+/// @brief Gets the width and height of a page.
+///
+/// Pages shared by glyphs are get_page_size() pixels, while a glyph too large to share
+/// a page has a page sized to fit it. If the page does not exist, an exception is thrown.
+///
+/// @param page: The index of the page.
+/// @return int: The page size in pixels.
+int PenguinGlyphAtlas::get_page_size(int page) const {
+	Exception::throw_if(page < 0 || page >= (int)page_sizes.size(), "The glyph atlas does not contain the requested page.", TEXT_ERROR);
+	return page_sizes[page];
+}
+
+/// @brief Retrieves the texture of a page.
+/// @param page: The index of the page.
+/// @return SDL_Texture*: A pointer to the page texture.
+SDL_Texture* PenguinGlyphAtlas::get_page(int page) const {
+	Exception::throw_if(page < 0 || page >= (int)pages.size(), "The glyph atlas does not contain the requested page.", TEXT_ERROR);
+	return pages[page].get();
+}
+
+/// @brief Gets the number of glyphs rasterized so far.
+/// @return size_t: The number of glyphs.
+size_t PenguinGlyphAtlas::get_glyph_count() const {
+	return glyphs.size();
+}
+
+/// @brief Renders a glyph and uploads it into the current page.
+///
+/// Glyphs are rendered white so that text colour can be applied per vertex. The
+/// rendered surface spans the glyph's full line height, so glyphs can be placed at
+/// the top of their line without further offsets. Glyphs are packed left to right
+/// on shelves, starting a new shelf or page when the current one is full. A glyph
+/// too large for a shared page is given a page of its own. If the glyph cannot be
+/// rendered or uploaded, an exception is thrown.
+///
+/// @param codepoint: The Unicode codepoint of the glyph.
+/// @return The location and metrics of the glyph.
+PenguinGlyph PenguinGlyphAtlas::rasterize(uint32_t codepoint) {
+	PenguinGlyph glyph;
+
+	int advance = 0;
+	if (TTF_GetGlyphMetrics(font.get_font(), codepoint, nullptr, nullptr, nullptr, nullptr, &advance)) {
+		glyph.advance = (float)advance;
+	}
+
+	// Blank glyphs (e.g., spaces) have nothing to render, only an advance.
+	std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)> rendered(
+		TTF_RenderGlyph_Blended(font.get_font(), codepoint, SDL_Color{ 255, 255, 255, 255 }),
+		&SDL_DestroySurface);
+	if (!rendered || rendered->w == 0 || rendered->h == 0) {
+		return glyph;
+	}
+
+	int width = rendered->w;
+	int height = rendered->h;
+
+	std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)> converted(
+		SDL_ConvertSurface(rendered.get(), SDL_PIXELFORMAT_RGBA32),
+		&SDL_DestroySurface);
+	Exception::throw_if(!converted, "The glyph could not be converted for the glyph atlas.", TEXT_ERROR);
+
+	SDL_Rect destination = { GLYPH_PADDING, GLYPH_PADDING, width, height };
+	bool oversized = width + GLYPH_PADDING > page_size || height + GLYPH_PADDING > page_size;
+	if (oversized) {
+		glyph.page = add_page(std::max(width, height) + 2 * GLYPH_PADDING);
+	}
+	else {
+		// Move to the next shelf, or the next page, if the glyph does not fit.
+		if (shelf_page < 0) {
+			add_shelf_page();
+		}
+		if (shelf_x + width + GLYPH_PADDING > page_size) {
+			shelf_x = 0;
+			shelf_y += shelf_height;
+			shelf_height = 0;
+		}
+		if (shelf_y + height + GLYPH_PADDING > page_size) {
+			add_shelf_page();
+		}
+		glyph.page = shelf_page;
+		destination.x += shelf_x;
+		destination.y += shelf_y;
+	}
+
+	Exception::throw_if(
+		!SDL_UpdateTexture(pages[glyph.page].get(), &destination, converted->pixels, converted->pitch),
+		"The glyph could not be uploaded to the glyph atlas.",
+		TEXT_ERROR
+	);
+	glyph.source = { (float)destination.x, (float)destination.y, (float)width, (float)height };
+
+	if (!oversized) {
+		shelf_x += width + GLYPH_PADDING;
+		shelf_height = std::max(shelf_height, height + GLYPH_PADDING);
+	}
+	return glyph;
+}
+
+/// @brief Creates a new, fully transparent page.
+///
+/// If the page texture cannot be created, an exception is thrown.
+///
+/// @param size: The width and height of the page in pixels.
+/// @return int: The index of the page.
+int PenguinGlyphAtlas::add_page(int size) {
+	std::unique_ptr<SDL_Texture, void(*)(SDL_Texture*)> page(
+		SDL_CreateTexture(renderer.get_renderer(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, size, size),
+		&SDL_DestroyTexture);
+	Exception::throw_if(!page, "The glyph atlas page could not be created.", TEXT_ERROR);
+
+	// Static textures start with undefined contents, so clear the padding between glyphs.
+	std::vector<uint32_t> transparent((size_t)size * (size_t)size, 0);
+	SDL_UpdateTexture(page.get(), nullptr, transparent.data(), size * (int)sizeof(uint32_t));
+	SDL_SetTextureBlendMode(page.get(), SDL_BLENDMODE_BLEND);
+
+	pages.push_back(std::move(page));
+	page_sizes.push_back(size);
+	return (int)pages.size() - 1;
+}
+
+/// @brief Creates a new shared page and starts packing glyphs into it.
+void PenguinGlyphAtlas::add_shelf_page() {
+	shelf_page = add_page(page_size);
+	shelf_x = 0;
+	shelf_y = 0;
+	shelf_height = 0;
+}
+
+/// @brief Chooses a page size that fits a few lines of a font.
+///
+/// The size is the smallest power of two that fits LINES_PER_PAGE font heights, within
+/// MIN_PAGE_SIZE and MAX_PAGE_SIZE. Glyphs of very large fonts may still not fit, and
+/// are given pages of their own.
+///
+/// @param font: The font the atlas rasterizes glyphs from.
+/// @return int: The page size in pixels.
+int PenguinGlyphAtlas::get_page_size_for(const PenguinFont& font) {
+	int wanted = std::max(TTF_GetFontHeight(font.get_font()), 0) * LINES_PER_PAGE;
+	int size = MIN_PAGE_SIZE;
+	while (size < wanted && size < MAX_PAGE_SIZE) {
+		size *= 2;
+	}
+	return size;
+}
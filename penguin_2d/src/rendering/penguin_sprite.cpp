@@ -13,21 +13,38 @@ using namespace Penguin2D;
 
 /// @brief Constructs a PenguinSprite from the given file path and renderer.            
 ///                                                                             
-/// This function loads the sprite texture from the specified file and attaches 
-/// it to the provided renderer. If the sprite cannot be loaded, an exception
-/// is thrown.                                         
+/// This function retrieves the sprite texture from the renderer's texture cache,
+/// which loads the file only if no other sprite has loaded it already. If the
+/// sprite cannot be loaded, an exception is thrown.
 ///                                                                             
 /// @param renderer: The renderer to associate with the sprite.                  
 /// @param path: The file path to the sprite texture.
 PenguinSprite::PenguinSprite(PenguinRenderer& renderer, const std::string& path)
 	: renderer(renderer), // Initializes the member reference with the parameter
-		sprite(IMG_LoadTexture(
-		renderer.get_renderer(), 
-		path.c_str()),
-		&SDL_DestroyTexture) {
+		sprite(renderer.get_texture_cache().load(path)) {
 
 	// Throw an exception if the sprite was not intialized.
 	Exception::throw_if(!sprite, "The sprite was not initialized. Ensure that the file path is a valid path.", RENDERER_ERROR); // TODO: Expand to add SDL_Error() for more information.
+
+	source_region = { 0.0f, 0.0f, (float)sprite->w, (float)sprite->h };
+}
+
+/// @brief Constructs a PenguinSprite from an image packed into a texture atlas.
+///
+/// The sprite references the atlas page texture rather than owning a texture, so
+/// sprites packed into the same page share one texture. The atlas must be built
+/// and must outlive the sprite. If the atlas does not contain the image, an
+/// exception is thrown.
+///
+/// @param renderer: The renderer to associate with the sprite.
+/// @param atlas: The texture atlas containing the image.
+/// @param name: The name of the image in the atlas.
+PenguinSprite::PenguinSprite(PenguinRenderer& renderer, const PenguinTextureAtlas& atlas, const std::string& name)
+	: renderer(renderer),
+		sprite(atlas.get_texture(name), [](SDL_Texture*) {}) { // The atlas owns the page texture.
+
+	const PenguinAtlasRegion& region = atlas.get_region(name);
+	source_region = { (float)region.x, (float)region.y, (float)region.width, (float)region.height };
 }
 
 /// @brief Retrieves the width of the sprite.                           
@@ -36,7 +53,7 @@ PenguinSprite::PenguinSprite(PenguinRenderer& renderer, const std::string& path)
 ///                                                                          
 /// @return int: The width of the sprite texture. 
 int PenguinSprite::get_sprite_width() {
-	return sprite.get()->w;
+	return (int)source_region.w;
 }
 
 /// @brief Retrieves the height of the sprite.                                  
@@ -45,7 +62,7 @@ int PenguinSprite::get_sprite_width() {
 ///                                                                             
 /// @return The height of the sprite texture.
 int PenguinSprite::get_sprite_height() {
-	return sprite.get()->h;
+	return (int)source_region.h;
 }
 
 /// @brief Retrieves the internal SDL_Texture pointer.                          
@@ -57,16 +74,62 @@ SDL_Texture* PenguinSprite::get_sprite_ptr() {
 	return sprite.get();
 }
 
+/// @brief Retrieves the region of the texture that the sprite covers.
+///
+/// For sprites created from a texture atlas, this is the image's region of the atlas page.
+///
+/// @return Rect2<float>: The sprite's region in its texture, in pixels.
+Rect2<float> PenguinSprite::get_source_region() const {
+	return Rect2<float>(source_region.x, source_region.y, source_region.w, source_region.h);
+}
+
+/// @brief Clips a region of the sprite to the sprite's region of its texture.
+///
+/// The region is offset into the texture and intersected with the sprite's region, so a
+/// region reaching past the sprite never samples the neighbouring images of an atlas page.
+/// The position is trimmed by the same amount, so the drawn pixels keep their scale.
+///
+/// @param clip_region: The region of the sprite, relative to the sprite's top-left corner.
+/// @param position: The position to draw the region at, trimmed along with the region.
+/// @param source: Set to the clipped region of the texture, in pixels.
+/// @return bool: True if any of the region lies within the sprite, otherwise false.
+bool PenguinSprite::clip_region(Rect2<float> clip_region, Rect2<float>& position, Rect2<float>& source) const {
+	Rect2<float> sprite_region = get_source_region();
+	Rect2<float> texture_region(
+		clip_region.position.x + sprite_region.position.x, // Offset into the sprite's region of the texture.
+		clip_region.position.y + sprite_region.position.y,
+		clip_region.size.x,
+		clip_region.size.y
+	);
+	if (!sprite_region.get_intersection(texture_region, source)) {
+		return false;
+	}
+
+	if (texture_region.size.x > 0.0f) {
+		float scale = position.size.x / texture_region.size.x;
+		position.position.x += (source.position.x - texture_region.position.x) * scale;
+		position.size.x = source.size.x * scale;
+	}
+	if (texture_region.size.y > 0.0f) {
+		float scale = position.size.y / texture_region.size.y;
+		position.position.y += (source.position.y - texture_region.position.y) * scale;
+		position.size.y = source.size.y * scale;
+	}
+	return true;
+}
+
 /// @brief Draws the sprite to the screen at a specified position.               
 ///                                                                             
 /// This function renders the sprite at the given position using the attached
-/// renderer. If the sprite fails to render, an exception is thrown.            
+/// renderer. Any primitives recorded by the renderer are flushed first so that
+/// the sprite is drawn on top of them. If the sprite fails to render, an exception is thrown.
 ///                                                                           
 /// @param position: The position to draw the sprite on the screen.            
 void PenguinSprite::draw_sprite(Rect2<float>position) {
+	renderer.flush();
 	auto sdl_position = (SDL_FRect)position;
 	Exception::throw_if(
-		!SDL_RenderTexture(renderer.get_renderer(), sprite.get(), NULL, &sdl_position),
+		!SDL_RenderTexture(renderer.get_renderer(), sprite.get(), &source_region, &sdl_position),
 		"Failed to render the sprite to the screen.",
 		RENDERER_ERROR
 	);
@@ -75,12 +138,20 @@ void PenguinSprite::draw_sprite(Rect2<float>position) {
 /// @brief Draws a region of the sprite to the screen at a specified position.
 ///                                                                             
 /// This function renders a specified region of the sprite to the given
-/// position. If the sprite region fails to render, an exception is thrown.   
+/// position. Any primitives recorded by the renderer are flushed first.
+/// Parts of the region outside the sprite are not drawn (see clip_region()).
+/// If the sprite region fails to render, an exception is thrown.   
 ///                                                                             
-/// @param clip_region: The region of the sprite to draw.                       
+/// @param clip_region: The region of the sprite to draw, relative to the sprite's top-left corner.
 /// @param position: The position to draw the sprite region on the screen.     
 void PenguinSprite::draw_sprite_region(Rect2<float> clip_region, Rect2<float>position) {
-	auto sdl_clip_region = (SDL_FRect)clip_region;
+	Rect2<float> source(0.0f, 0.0f, 0.0f, 0.0f);
+	if (!this->clip_region(clip_region, position, source)) {
+		return;
+	}
+
+	renderer.flush();
+	auto sdl_clip_region = (SDL_FRect)source;
 	auto sdl_position = (SDL_FRect)position;
 	Exception::throw_if(
 		!SDL_RenderTexture(renderer.get_renderer(), sprite.get(), &sdl_clip_region, &sdl_position),
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_sprite_batch.cpp                                         ///
+///                                                                             ///
+/// PenguinSpriteBatch collects sprite draws as quads and submits them sorted   ///
+/// by layer and texture, with one SDL_RenderGeometry call per texture run.     ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_sprite_batch.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numbers>
+
+using namespace Penguin2D;
+
+/// @brief Converts a Colour into the normalized colour used by SDL_Vertex.
+/// @param colour: The colour to convert.
+/// @return The colour with each component in the range 0-1.
+static SDL_FColor to_vertex_colour(Colour colour) {
+	return SDL_FColor{ colour.red / 255.0f, colour.green / 255.0f, colour.blue / 255.0f, colour.alpha / 255.0f };
+}
+
+/// @brief Constructs a PenguinSpriteBatch.
+/// @param renderer: The PenguinRenderer the batch draws onto.
+PenguinSpriteBatch::PenguinSpriteBatch(PenguinRenderer& renderer)
+	: renderer(renderer) {
+}
+
+/// @brief Starts a new batch, discarding any quads that were not submitted.
+void PenguinSpriteBatch::begin() {
+	quads.reset();
+}
+
+/// @brief Adds a sprite to the batch.
+/// @param sprite: The sprite to draw.
+/// @param position: The position and size to draw the sprite at.
+/// @param rotation: The clockwise rotation around the centre of the sprite, in degrees.
+/// @param colour: The colour to modulate the sprite by.
+/// @param layer: The layer of the sprite, lower layers are drawn first.
+void PenguinSpriteBatch::draw(PenguinSprite& sprite, Rect2<float> position, float rotation, Colour colour, int layer) {
+	quads.push_back(PenguinSpriteQuad{
+		sprite.get_sprite_ptr(),
+		(SDL_FRect)sprite.get_source_region(),
+		(SDL_FRect)position,
+		to_vertex_colour(colour),
+		rotation,
+		layer,
+		(uint32_t)quads.size()
+	});
+}
+
+/// @brief Adds a region of a sprite to the batch.
+///
+/// Parts of the region outside the sprite are not drawn (see PenguinSprite::clip_region()).
+///
+/// @param sprite: The sprite to draw.
+/// @param clip_region: The region of the sprite to draw, relative to the sprite's top-left corner.
+/// @param position: The position and size to draw the region at.
+/// @param rotation: The clockwise rotation around the centre of the region, in degrees.
+/// @param colour: The colour to modulate the region by.
+/// @param layer: The layer of the region, lower layers are drawn first.
+void PenguinSpriteBatch::draw_region(PenguinSprite& sprite, Rect2<float> clip_region, Rect2<float> position, float rotation, Colour colour, int layer) {
+	Rect2<float> source(0.0f, 0.0f, 0.0f, 0.0f);
+	if (!sprite.clip_region(clip_region, position, source)) {
+		return;
+	}
+
+	quads.push_back(PenguinSpriteQuad{
+		sprite.get_sprite_ptr(),
+		(SDL_FRect)source,
+		(SDL_FRect)position,
+		to_vertex_colour(colour),
+		rotation,
+		layer,
+		(uint32_t)quads.size()
+	});
+}
+
+/// @brief Sorts the batched quads and submits them to the renderer.
+///
+/// Quads are sorted by layer, then by texture, then by the order they were drawn in,
+/// and each run of quads sharing a texture is drawn with a single SDL_RenderGeometry call.
+/// Primitives recorded by the renderer are flushed first so that the sprites are drawn
+/// on top of them. If a draw call fails, an exception is thrown.
+void PenguinSpriteBatch::end() {
+	submitted_quads = quads.size();
+	draw_calls = 0;
+	if (quads.empty()) {
+		return;
+	}
+
+	renderer.flush();
+
+	// The draw order is part of the key, so an unstable sort gives a stable result without allocating.
+	std::sort(quads.data(), quads.data() + quads.size(), [](const PenguinSpriteQuad& a, const PenguinSpriteQuad& b) {
+		if (a.layer != b.layer) {
+			return a.layer < b.layer;
+		}
+		if (a.texture != b.texture) {
+			return std::less<SDL_Texture*>()(a.texture, b.texture);
+		}
+		return a.order < b.order;
+	});
+
+	// Build the vertices of every quad up front.
+	vertices.reset();
+	SDL_Vertex* quad_vertices = vertices.begin_write(quads.size() * 4);
+	for (size_t i = 0; i < quads.size(); i++) {
+		write_vertices(quads[i], quad_vertices + i * 4);
+	}
+	vertices.end_write(quads.size() * 4);
+
+	// The index pattern is the same for every quad, so it is only extended when the batch grows.
+	size_t built_quads = quad_indices.size() / 6;
+	if (built_quads < quads.size()) {
+		int* indices = quad_indices.begin_write((quads.size() - built_quads) * 6);
+		for (size_t quad = built_quads; quad < quads.size(); quad++) {
+			int first_vertex = (int)(quad * 4);
+			*indices++ = first_vertex;
+			*indices++ = first_vertex + 1;
+			*indices++ = first_vertex + 2;
+			*indices++ = first_vertex;
+			*indices++ = first_vertex + 2;
+			*indices++ = first_vertex + 3;
+		}
+		quad_indices.end_write((quads.size() - built_quads) * 6);
+	}
+
+	// Draw each run of quads that shares a texture. Indices are relative to the vertices
+	// passed in, so every run can use the start of the shared index buffer.
+	size_t run_start = 0;
+	while (run_start < quads.size()) {
+		size_t run_end = run_start + 1;
+		while (run_end < quads.size() && quads[run_end].texture == quads[run_start].texture && quads[run_end].layer == quads[run_start].layer) {
+			run_end++;
+		}
+
+		size_t run_length = run_end - run_start;
+		Exception::throw_if(
+			!SDL_RenderGeometry(renderer.get_renderer(), quads[run_start].texture,
+				vertices.data() + run_start * 4, (int)(run_length * 4),
+				quad_indices.data(), (int)(run_length * 6)),
+			"Failed to render the sprite batch to the screen.",
+			RENDERER_ERROR
+		);
+		draw_calls++;
+		run_start = run_end;
+	}
+
+	quads.reset();
+}
+
+/// @brief Gets the number of quads submitted by the last call to end().
+/// @return The number of quads.
+size_t PenguinSpriteBatch::get_quad_count() const {
+	return submitted_quads;
+}
+
+/// @brief Gets the number of draw calls made by the last call to end().
+/// @return The number of SDL_RenderGeometry calls.
+size_t PenguinSpriteBatch::get_draw_call_count() const {
+	return draw_calls;
+}
+
+/// @brief Writes the four corners of a quad, rotated around the centre of its destination.
+///
+/// Corners are written clockwise from the top-left, with texture coordinates normalized
+/// by the size of the quad's texture.
+///
+/// @param quad: The quad to write.
+/// @param quad_vertices: The four vertices to write to.
+void PenguinSpriteBatch::write_vertices(const PenguinSpriteQuad& quad, SDL_Vertex* quad_vertices) const {
+	const SDL_FRect& destination = quad.destination;
+	const SDL_FRect& source = quad.source;
+
+	float inverse_width = 1.0f / (float)quad.texture->w;
+	float inverse_height = 1.0f / (float)quad.texture->h;
+	float u0 = source.x * inverse_width;
+	float v0 = source.y * inverse_height;
+	float u1 = (source.x + source.w) * inverse_width;
+	float v1 = (source.y + source.h) * inverse_height;
+
+	float half_width = destination.w * 0.5f;
+	float half_height = destination.h * 0.5f;
+	float centre_x = destination.x + half_width;
+	float centre_y = destination.y + half_height;
+
+	// Corner offsets from the centre, clockwise from the top-left.
+	const SDL_FPoint offsets[4] = {
+		{ -half_width, -half_height },
+		{ half_width, -half_height },
+		{ half_width, half_height },
+		{ -half_width, half_height }
+	};
+	const SDL_FPoint tex_coords[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+	float cosine = 1.0f;
+	float sine = 0.0f;
+	if (quad.rotation != 0.0f) {
+		float radians = quad.rotation * std::numbers::pi_v<float> / 180.0f;
+		cosine = std::cos(radians);
+		sine = std::sin(radians);
+	}
+
+	for (int corner = 0; corner < 4; corner++) {
+		float x = offsets[corner].x * cosine - offsets[corner].y * sine;
+		float y = offsets[corner].x * sine + offsets[corner].y * cosine;
+		quad_vertices[corner] = SDL_Vertex{ { centre_x + x, centre_y + y }, quad.colour, tex_coords[corner] };
+	}
+}
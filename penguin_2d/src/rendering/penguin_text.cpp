@@ -15,7 +15,9 @@ using namespace Penguin2D;
 /// @brief Creates a PenguinText object from the text renderer.
 /// 
 /// This constructor initializes a text object that can be rendered onto the game window.
-/// It loads the specified font and sets the text string, color, and position.
+/// It retrieves the specified font from the text renderer's font registry, so texts using
+/// the same font file, size, style, and outline share one font, and sets the text string,
+/// color, and position.
 /// 
 /// @param text_renderer: The text renderer responsible for managing text rendering.
 /// @param font_path: The file path to the font to be used.
@@ -23,22 +25,19 @@ using namespace Penguin2D;
 /// @param font_size: The size of the font in pixels (optional, defaults to 12.0f).
 /// @param colour: The color of the text (optional, defaults to white).
 /// @param position: The position of the text in the window (optional, defaults to (0,0)).
-PenguinText::PenguinText(PenguinTextRenderer& text_renderer, const std::string& font_path, const std::string& text_str, float font_size, Colour colour, Vector2<int> position)
-    : font(font_path, font_size), 
-      text(nullptr, &TTF_DestroyText) {
+/// @param font_style: The styles applied to the font (optional, defaults to NORMAL).
+/// @param font_outline: The outline size of the font in pixels (optional, defaults to 0).
+PenguinText::PenguinText(PenguinTextRenderer& text_renderer, const std::string& font_path, const std::string& text_str, float font_size, Colour colour, Vector2<int> position, TTF_FontStyleFlags font_style, int font_outline)
+    : text_renderer(text_renderer),
+      font_path(font_path),
+      font_size(font_size),
+      font_style(font_style),
+      font_outline(font_outline),
+      font(&text_renderer.get_font_registry().get_font(font_path, font_size, font_style, font_outline)),
+      layout(text_renderer.get_glyph_atlas(*font)) {
 
-    // Initialize the text pointer
-    text.reset(TTF_CreateText(
-        text_renderer.get_text_renderer(),
-        font.get_font(),
-        text_str.c_str(),
-        0));
-
-    Exception::throw_if(
-        !text,
-        "The text could not be created due to one of the following objects: PenguinTextRenderer.",
-        INIT_ERROR
-    );
+    // Set the text string.
+    set_text_string(text_str);
 
     // Set the text colour.
     set_text_colour(colour);
@@ -49,11 +48,14 @@ PenguinText::PenguinText(PenguinTextRenderer& text_renderer, const std::string&
 
 /// @brief Draws the text onto the renderer.
 /// 
-/// This function renders the text onto the game window at the specified position.
+/// This function renders the text onto the game window at the specified position, offset by
+/// the text's position. Any primitives recorded by the renderer are flushed first so that
+/// the text is drawn on top of them.
 /// @param position: The position to draw the text.
 void PenguinText::draw_text(Vector2<float> position) {
+    text_renderer.get_renderer().flush();
     Exception::throw_if(
-        !TTF_DrawRendererText(text.get(), position.x, position.y),
+        !layout.draw(text_renderer.get_renderer(), position + (Vector2<float>)this->position),
         "The text could not be rendered onto the screen.",
         TEXT_ERROR
     );
@@ -61,14 +63,11 @@ void PenguinText::draw_text(Vector2<float> position) {
 
 /// @brief Sets the text content.
 /// 
-/// Updates the displayed text to a new string.
+/// Updates the displayed text to a new string. Only glyphs that differ from the
+/// previous string, or that moved, are rebuilt.
 /// @param new_text: The new string to be displayed.
 void PenguinText::set_text_string(const std::string& new_text) {
-    Exception::throw_if(
-        !TTF_SetTextString(text.get(), new_text.c_str(), 0),
-        "The contents of the text could not be changed.",
-        TEXT_ERROR
-    );
+    layout.set_text(new_text);
 }
 
 /// @brief Sets the text color.
@@ -76,11 +75,7 @@ void PenguinText::set_text_string(const std::string& new_text) {
 /// Changes the color of the displayed text.
 /// @param new_colour: The new color of the text.
 void PenguinText::set_text_colour(Colour new_colour) {
-    Exception::throw_if(
-        !TTF_SetTextColor(text.get(), new_colour.red, new_colour.green, new_colour.blue, new_colour.alpha),
-        "The colour of the text could not be changed.",
-        TEXT_ERROR
-    );
+    layout.set_colour(new_colour);
 }
 
 /// @brief Sets the text position.
@@ -88,9 +83,44 @@ void PenguinText::set_text_colour(Colour new_colour) {
 /// Updates the position of the text on the screen.
 /// @param position: The new position of the text.
 void PenguinText::set_text_position(Vector2<int> position) {
-    Exception::throw_if(
-        !TTF_SetTextPosition(text.get(), position.x, position.y),
-        "The position of the text could not be changed.",
-        TEXT_ERROR
-    );
-}
\ No newline at end of file
+    this->position = position;
+}
+
+/// @brief Sets the font size of the text.
+/// 
+/// Fonts are shared between texts, so rather than resizing its font, the text switches
+/// to the registry's font of the new size, with the same style and outline, and lays itself
+/// out again with that font's glyph atlas.
+/// @param font_size: The new font size in pixels.
+void PenguinText::set_font_size(float font_size) {
+    if (font_size == this->font_size) {
+        return;
+    }
+
+    font = &text_renderer.get_font_registry().get_font(font_path, font_size, font_style, font_outline);
+    this->font_size = font_size;
+    layout.set_atlas(text_renderer.get_glyph_atlas(*font));
+}
+
+/// @brief Gets the font size of the text.
+/// @return The font size in pixels.
+float PenguinText::get_font_size() const {
+    return font_size;
+}
+
+/// @brief Retrieves the font used to render the text.
+/// 
+/// The font is shared with other texts using the same font file, size, style, and
+/// outline, so it is read-only. Changing it would change every text that uses it.
+/// @return const PenguinFont&: The font of the text.
+const PenguinFont& PenguinText::get_font() const {
+    return *font;
+}
+
+/// @brief Retrieves the layout of the text.
+/// 
+/// The layout reports how many glyphs were rebuilt by the last change to the text.
+/// @return const PenguinTextLayout&: The layout used to draw the text.
+const PenguinTextLayout& PenguinText::get_layout() const {
+    return layout;
+}
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_text_layout.cpp                                          ///
+///                                                                             ///
+/// PenguinTextLayout lays out strings as quads from a glyph atlas, rebuilding  ///
+/// only the glyphs that change between strings.                                ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_text_layout.hpp"
+
+using namespace Penguin2D;
+
+/// @brief Constructs an empty PenguinTextLayout.
+/// @param atlas: The glyph atlas to lay out glyphs from.
+PenguinTextLayout::PenguinTextLayout(PenguinGlyphAtlas& atlas)
+	: atlas(&atlas) {
+}
+
+/// @brief Sets the string to lay out.
+///
+/// The new string is laid out glyph by glyph. A glyph keeps its existing quad when
+/// both its codepoint and position are unchanged, so replacing "120" with "121"
+/// only rebuilds the last glyph, and text after a change of the same width is kept.
+///
+/// @param new_text: The UTF-8 string to lay out.
+void PenguinTextLayout::set_text(const std::string& new_text) {
+	if (new_text == text) {
+		rebuilt_glyphs = 0;
+		return;
+	}
+	text = new_text;
+
+	decode_utf8(text, codepoints);
+	size_t previous_count = glyphs.size();
+	glyphs.resize(codepoints.size());
+	pages.resize(codepoints.size());
+	vertices.resize(codepoints.size() * 4);
+
+	rebuilt_glyphs = 0;
+	float pen_x = 0.0f;
+	float pen_y = 0.0f;
+	for (size_t i = 0; i < codepoints.size(); i++) {
+		uint32_t codepoint = codepoints[i];
+		if (codepoint == '\n') {
+			pen_x = 0.0f;
+			pen_y += atlas->get_line_height();
+		}
+		else if (i > 0 && codepoints[i - 1] != '\n') {
+			pen_x += atlas->get_kerning(codepoints[i - 1], codepoint);
+		}
+
+		bool unchanged = i < previous_count && glyphs[i].codepoint == codepoint && glyphs[i].x == pen_x && glyphs[i].y == pen_y;
+		const PenguinGlyph& glyph = atlas->get_glyph(codepoint);
+		if (!unchanged) {
+			glyphs[i] = PenguinPlacedGlyph{ codepoint, pen_x, pen_y };
+			write_glyph(i, glyph);
+			rebuilt_glyphs++;
+		}
+
+		if (codepoint != '\n') {
+			pen_x += glyph.advance;
+		}
+	}
+
+	if (rebuilt_glyphs > 0 || glyphs.size() != previous_count) {
+		placed_valid = false;
+	}
+}
+
+/// @brief Switches to a different glyph atlas, rebuilding every glyph.
+/// @param new_atlas: The glyph atlas to lay out glyphs from.
+void PenguinTextLayout::set_atlas(PenguinGlyphAtlas& new_atlas) {
+	atlas = &new_atlas;
+	std::string current_text = std::move(text);
+	text.clear();
+	glyphs.clear();
+	set_text(current_text);
+}
+
+/// @brief Sets the colour of every glyph.
+/// @param new_colour: The new colour of the text.
+void PenguinTextLayout::set_colour(Colour new_colour) {
+	colour = SDL_FColor{ new_colour.red / 255.0f, new_colour.green / 255.0f, new_colour.blue / 255.0f, new_colour.alpha / 255.0f };
+	for (SDL_Vertex& vertex : vertices) {
+		vertex.color = colour;
+	}
+	placed_valid = false;
+}
+
+/// @brief Draws the laid out text.
+///
+/// The translated vertices are kept between draws, so a label drawn at the same
+/// position every frame is submitted without touching its vertices. Consecutive
+/// glyphs on the same atlas page are drawn with a single SDL_RenderGeometry call,
+/// so text that fits in one page is a single call.
+///
+/// @param renderer: The PenguinRenderer to draw onto.
+/// @param position: The position of the top-left of the text.
+/// @return bool: True if every draw call succeeded, otherwise false.
+bool PenguinTextLayout::draw(PenguinRenderer& renderer, Vector2<float> position) {
+	if (glyphs.empty()) {
+		return true;
+	}
+
+	if (!placed_valid || position != placed_position) {
+		placed_vertices.resize(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++) {
+			placed_vertices[i] = vertices[i];
+			placed_vertices[i].position.x += position.x;
+			placed_vertices[i].position.y += position.y;
+		}
+		placed_position = position;
+		placed_valid = true;
+	}
+
+	// The index pattern is the same for every glyph, so it is only extended when the text grows.
+	size_t built_quads = quad_indices.size() / 6;
+	for (size_t quad = built_quads; quad < glyphs.size(); quad++) {
+		int first_vertex = (int)(quad * 4);
+		quad_indices.insert(quad_indices.end(), { first_vertex, first_vertex + 1, first_vertex + 2, first_vertex, first_vertex + 2, first_vertex + 3 });
+	}
+
+	// Blank glyphs have empty quads, so they join whichever run they are in rather than splitting it.
+	bool succeeded = true;
+	size_t run_start = 0;
+	while (run_start < glyphs.size()) {
+		int run_page = pages[run_start];
+		size_t run_end = run_start + 1;
+		while (run_end < glyphs.size() && (pages[run_end] == run_page || pages[run_end] == -1 || run_page == -1)) {
+			run_page = run_page == -1 ? pages[run_end] : run_page;
+			run_end++;
+		}
+
+		if (run_page >= 0) {
+			size_t run_length = run_end - run_start;
+			succeeded &= SDL_RenderGeometry(renderer.get_renderer(), atlas->get_page(run_page),
+				placed_vertices.data() + run_start * 4, (int)(run_length * 4),
+				quad_indices.data(), (int)(run_length * 6));
+		}
+		run_start = run_end;
+	}
+	return succeeded;
+}
+
+/// @brief Gets the number of glyphs in the layout.
+/// @return size_t: The number of glyphs, including blank glyphs and line breaks.
+size_t PenguinTextLayout::get_glyph_count() const {
+	return glyphs.size();
+}
+
+/// @brief Gets the number of glyphs rebuilt by the last change to the layout.
+/// @return size_t: The number of glyphs rebuilt.
+size_t PenguinTextLayout::get_rebuilt_glyph_count() const {
+	return rebuilt_glyphs;
+}
+
+/// @brief Writes the quad of a placed glyph.
+///
+/// Blank glyphs and line breaks are given the page -1 and an empty quad, so they draw nothing.
+///
+/// @param index: The index of the glyph in the layout.
+/// @param glyph: The atlas glyph to write.
+void PenguinTextLayout::write_glyph(size_t index, const PenguinGlyph& glyph) {
+	const PenguinPlacedGlyph& placed = glyphs[index];
+	SDL_Vertex* quad = vertices.data() + index * 4;
+
+	bool blank = placed.codepoint == '\n' || glyph.source.w == 0.0f || glyph.source.h == 0.0f;
+	pages[index] = blank ? -1 : glyph.page;
+	if (blank) {
+		for (int corner = 0; corner < 4; corner++) {
+			quad[corner] = SDL_Vertex{ { placed.x, placed.y }, colour, { 0.0f, 0.0f } };
+		}
+		return;
+	}
+
+	float inverse_size = 1.0f / (float)atlas->get_page_size(glyph.page);
+	float u0 = glyph.source.x * inverse_size;
+	float v0 = glyph.source.y * inverse_size;
+	float u1 = (glyph.source.x + glyph.source.w) * inverse_size;
+	float v1 = (glyph.source.y + glyph.source.h) * inverse_size;
+	float x0 = placed.x;
+	float y0 = placed.y;
+	float x1 = placed.x + glyph.source.w;
+	float y1 = placed.y + glyph.source.h;
+
+	quad[0] = SDL_Vertex{ { x0, y0 }, colour, { u0, v0 } };
+	quad[1] = SDL_Vertex{ { x1, y0 }, colour, { u1, v0 } };
+	quad[2] = SDL_Vertex{ { x1, y1 }, colour, { u1, v1 } };
+	quad[3] = SDL_Vertex{ { x0, y1 }, colour, { u0, v1 } };
+}
+
+/// @brief Decodes a UTF-8 string into codepoints.
+///
+/// Malformed sequences are decoded as U+FFFD (the replacement character).
+///
+/// @param text: The UTF-8 string to decode.
+/// @param codepoints: Receives the decoded codepoints, replacing its contents.
+void PenguinTextLayout::decode_utf8(const std::string& text, std::vector<uint32_t>& codepoints) {
+	constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+	codepoints.clear();
+
+	size_t i = 0;
+	while (i < text.size()) {
+		uint8_t lead = (uint8_t)text[i];
+		int length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+		if (length == 0 || i + length > text.size()) {
+			codepoints.push_back(REPLACEMENT_CHARACTER);
+			i++;
+			continue;
+		}
+
+		uint32_t codepoint = length == 1 ? lead : lead & (0x7F >> length);
+		bool valid = true;
+		for (int byte = 1; byte < length; byte++) {
+			uint8_t continuation = (uint8_t)text[i + byte];
+			valid &= (continuation & 0xC0) == 0x80;
+			codepoint = (codepoint << 6) | (continuation & 0x3F);
+		}
+
+		codepoints.push_back(valid ? codepoint : REPLACEMENT_CHARACTER);
+		i += valid ? length : 1;
+	}
+}
@@ -0,0 +1,383 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// File name: penguin_texture_atlas.cpp                                        ///
+///                                                                             ///
+/// PenguinTextureAtlas packs images into large page textures using a skyline  ///
+/// bottom-left packer, and can save and load the packed layout.               ///
+///                                                                             ///
+/// Layout files are plain text: a header line followed by one tab separated   ///
+/// line per image (name, page, x, y, width, height, path).                     ///
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "penguin_texture_atlas.hpp"
+
+// C++ library files
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <sstream>
+
+using namespace Penguin2D;
+
+/// @brief Constructs an empty texture atlas.
+///
+/// @param renderer: The renderer used to create the page textures.
+/// @param page_size: The width and height of each page in pixels.
+/// @param padding: The empty space left between packed images in pixels.
+PenguinTextureAtlas::PenguinTextureAtlas(PenguinRenderer& renderer, int page_size, int padding)
+	: renderer(renderer), page_size(page_size), padding(padding) {
+
+	Exception::throw_if(page_size <= 0 || padding < 0, "The texture atlas page size must be positive and its padding must not be negative.", RENDERER_ERROR);
+}
+
+/// @brief Loads an image and queues it to be packed into the atlas.
+///
+/// The image is packed and uploaded the next time build() is called. Images cannot be added
+/// once the atlas is built, since packing them would move the images sprites already use.
+/// If the atlas is built, the image cannot be loaded, or the name is already in use, an
+/// exception is thrown.
+///
+/// @param name: The name used to look up the image.
+/// @param path: The file path to the image.
+void PenguinTextureAtlas::add_image(const std::string& name, const std::string& path) {
+	Exception::throw_if(!pages.empty(), "The image " + name + " cannot be added to a texture atlas that has already been built. Add every image before calling build().", RENDERER_ERROR);
+	Exception::throw_if(regions.contains(name), "An image named " + name + " has already been added to the texture atlas.", RENDERER_ERROR);
+
+	std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)> image(IMG_Load(path.c_str()), &SDL_DestroySurface);
+	Exception::throw_if(!image, "The image " + path + " could not be loaded into the texture atlas. Ensure that the file path is a valid path.", RENDERER_ERROR);
+
+	PenguinAtlasRegion region;
+	region.path = path;
+	region.width = image->w;
+	region.height = image->h;
+	regions[name] = region;
+	pending_images.emplace(name, std::move(image));
+}
+
+/// @brief Packs the added images into pages and uploads the page textures.
+///
+/// If a layout was loaded with load_layout(), the images listed in it are loaded from their
+/// paths and copied to their saved positions without packing. Images cannot be added on top
+/// of a loaded layout. Building an atlas that is already built does nothing. If an image does
+/// not fit in a page, or a texture cannot be created, an exception is thrown.
+void PenguinTextureAtlas::build() {
+	if (!pages.empty()) {
+		return;
+	}
+
+	bool has_placed = false;
+	bool has_unplaced = false;
+
+	for (auto& [name, region] : regions) {
+		// Images listed in a loaded layout are only loaded when the atlas is built.
+		if (!pending_images.contains(name)) {
+			std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)> image(IMG_Load(region.path.c_str()), &SDL_DestroySurface);
+			Exception::throw_if(!image, "The image " + region.path + " in the texture atlas layout could not be loaded.", RENDERER_ERROR);
+			Exception::throw_if(
+				image->w != region.width || image->h != region.height,
+				"The image " + region.path + " does not match the size stored in the texture atlas layout.",
+				RENDERER_ERROR
+			);
+			pending_images.emplace(name, std::move(image));
+		}
+
+		if (region.page >= 0) {
+			has_placed = true;
+		}
+		else {
+			has_unplaced = true;
+		}
+	}
+
+	Exception::throw_if(has_placed && has_unplaced, "Images cannot be added to a texture atlas built from a loaded layout.", RENDERER_ERROR);
+	if (has_unplaced) {
+		pack();
+	}
+
+	// Copy every image into its page, then upload each page as a single texture.
+	std::vector<std::unique_ptr<SDL_Surface, void(*)(SDL_Surface*)>> page_surfaces;
+	for (int page = 0; page < page_count; page++) {
+		page_surfaces.emplace_back(SDL_CreateSurface(page_size, page_size, SDL_PIXELFORMAT_RGBA32), &SDL_DestroySurface);
+		Exception::throw_if(!page_surfaces.back(), "A texture atlas page could not be created.", RENDERER_ERROR);
+	}
+
+	for (auto& [name, image] : pending_images) {
+		const PenguinAtlasRegion& region = regions.at(name);
+		SDL_Rect destination = { region.x, region.y, region.width, region.height };
+
+		// Copy the alpha channel as-is instead of blending onto the empty page.
+		SDL_SetSurfaceBlendMode(image.get(), SDL_BLENDMODE_NONE);
+		Exception::throw_if(
+			!SDL_BlitSurface(image.get(), NULL, page_surfaces[region.page].get(), &destination),
+			"The image " + region.path + " could not be copied into the texture atlas.",
+			RENDERER_ERROR
+		);
+	}
+
+	pages.clear();
+	for (auto& page_surface : page_surfaces) {
+		pages.emplace_back(SDL_CreateTextureFromSurface(renderer.get_renderer(), page_surface.get()), &SDL_DestroyTexture);
+		Exception::throw_if(!pages.back(), "A texture atlas page could not be uploaded to the renderer.", RENDERER_ERROR);
+	}
+
+	pending_images.clear();
+}
+
+/// @brief Saves the packed layout of the atlas to a file.
+///
+/// If the atlas has not been built, or the file cannot be written, an exception is thrown.
+///
+/// @param path: The file path to write the layout to.
+void PenguinTextureAtlas::save_layout(const std::string& path) const {
+	Exception::throw_if(pages.empty() && !regions.empty(), "The texture atlas must be built before its layout can be saved.", RENDERER_ERROR);
+
+	std::ofstream file(path);
+	Exception::throw_if(!file, "The texture atlas layout could not be written to " + path + ".", RUNTIME_ERROR);
+
+	// Sort the images by name so that the same atlas always produces the same file.
+	std::vector<std::string> names;
+	for (const auto& [name, region] : regions) {
+		names.push_back(name);
+	}
+	std::sort(names.begin(), names.end());
+
+	file << "penguin_atlas 1 " << page_size << ' ' << padding << ' ' << page_count << '\n';
+	for (const std::string& name : names) {
+		const PenguinAtlasRegion& region = regions.at(name);
+		file << name << '\t' << region.page << '\t' << region.x << '\t' << region.y << '\t'
+			<< region.width << '\t' << region.height << '\t' << region.path << '\n';
+	}
+}
+
+/// @brief Loads a previously saved layout, replacing the contents of the atlas.
+///
+/// The images listed in the layout are loaded and uploaded when build() is called. A layout
+/// cannot be loaded once the atlas is built, since replacing the pages would free the textures
+/// sprites already use. If the atlas is built, the file cannot be read, or it is not a valid
+/// layout, an exception is thrown.
+///
+/// @param path: The file path to read the layout from.
+void PenguinTextureAtlas::load_layout(const std::string& path) {
+	Exception::throw_if(!pages.empty(), "The layout " + path + " cannot be loaded into a texture atlas that has already been built. Load the layout before calling build().", RENDERER_ERROR);
+
+	std::ifstream file(path);
+	Exception::throw_if(!file, "The texture atlas layout could not be read from " + path + ".", RUNTIME_ERROR);
+
+	std::string magic;
+	int version = 0;
+	int loaded_page_size = 0;
+	int loaded_padding = 0;
+	int loaded_page_count = 0;
+	file >> magic >> version >> loaded_page_size >> loaded_padding >> loaded_page_count;
+	Exception::throw_if(
+		!file || magic != "penguin_atlas" || version != 1 || loaded_page_size <= 0 || loaded_padding < 0 || loaded_page_count < 0,
+		"The file " + path + " is not a valid texture atlas layout.",
+		RUNTIME_ERROR
+	);
+	file.ignore(INT_MAX, '\n');
+
+	std::unordered_map<std::string, PenguinAtlasRegion> loaded_regions;
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty()) {
+			continue;
+		}
+
+		std::istringstream fields(line);
+		std::string name;
+		std::string number;
+		PenguinAtlasRegion region;
+		bool valid = static_cast<bool>(std::getline(fields, name, '\t'));
+		for (int* value : { &region.page, &region.x, &region.y, &region.width, &region.height }) {
+			valid = valid && std::getline(fields, number, '\t');
+			if (valid) {
+				*value = std::atoi(number.c_str());
+			}
+		}
+		valid = valid && std::getline(fields, region.path);
+
+		Exception::throw_if(
+			!valid || region.page < 0 || region.page >= loaded_page_count || region.x < 0 || region.y < 0
+				|| region.width < 0 || region.height < 0
+				|| region.width > loaded_page_size - region.x || region.height > loaded_page_size - region.y,
+			"The texture atlas layout " + path + " contains an invalid line: " + line,
+			RUNTIME_ERROR
+		);
+		loaded_regions[name] = region;
+	}
+
+	page_size = loaded_page_size;
+	padding = loaded_padding;
+	page_count = loaded_page_count;
+	regions = std::move(loaded_regions);
+	pending_images.clear();
+}
+
+/// @brief Checks if the atlas contains an image.
+///
+/// @param name: The name of the image.
+/// @return bool: True if the image was added or loaded from a layout, otherwise false.
+bool PenguinTextureAtlas::has_image(const std::string& name) const {
+	return regions.contains(name);
+}
+
+/// @brief Retrieves the location of an image in the atlas.
+///
+/// If the atlas does not contain the image, an exception is thrown.
+///
+/// @param name: The name of the image.
+/// @return const PenguinAtlasRegion&: The region of the image.
+const PenguinAtlasRegion& PenguinTextureAtlas::get_region(const std::string& name) const {
+	auto it = regions.find(name);
+	Exception::throw_if(it == regions.end(), "The texture atlas does not contain an image named " + name + ".", RENDERER_ERROR);
+	return it->second;
+}
+
+/// @brief Retrieves the page texture that an image is packed into.
+///
+/// If the atlas does not contain the image or has not been built, an exception is thrown.
+///
+/// @param name: The name of the image.
+/// @return SDL_Texture*: A pointer to the texture of the image's page.
+SDL_Texture* PenguinTextureAtlas::get_texture(const std::string& name) const {
+	const PenguinAtlasRegion& region = get_region(name);
+	Exception::throw_if(region.page < 0 || region.page >= (int)pages.size(), "The texture atlas must be built before its textures can be used.", RENDERER_ERROR);
+	return pages[region.page].get();
+}
+
+/// @brief Retrieves the number of pages in the atlas.
+///
+/// @return int: The number of pages.
+int PenguinTextureAtlas::get_page_count() const {
+	return page_count;
+}
+
+/// @brief Packs every added image into as few pages as possible.
+///
+/// Images are packed from tallest to shortest, each into the first page with room for it,
+/// using a skyline bottom-left packer. If an image is larger than a page, an exception is thrown.
+void PenguinTextureAtlas::pack() {
+	std::vector<std::string> names;
+	for (const auto& [name, region] : regions) {
+		names.push_back(name);
+	}
+
+	// Tall images first keeps the skyline flat, ties are broken by width then name for a stable layout.
+	std::sort(names.begin(), names.end(), [this](const std::string& a, const std::string& b) {
+		const PenguinAtlasRegion& region_a = regions.at(a);
+		const PenguinAtlasRegion& region_b = regions.at(b);
+		if (region_a.height != region_b.height) {
+			return region_a.height > region_b.height;
+		}
+		if (region_a.width != region_b.width) {
+			return region_a.width > region_b.width;
+		}
+		return a < b;
+	});
+
+	std::vector<std::vector<SkylineNode>> skylines;
+	for (const std::string& name : names) {
+		PenguinAtlasRegion& region = regions.at(name);
+		int padded_width = region.width + padding;
+		int padded_height = region.height + padding;
+		Exception::throw_if(
+			region.width > page_size || region.height > page_size,
+			"The image " + region.path + " is larger than a texture atlas page.",
+			RENDERER_ERROR
+		);
+
+		region.page = -1;
+		for (size_t page = 0; page < skylines.size() && region.page < 0; page++) {
+			if (skyline_insert(skylines[page], page_size, padded_width, padded_height, region.x, region.y)) {
+				region.page = (int)page;
+			}
+		}
+
+		// Start a new page when no existing page has room.
+		if (region.page < 0) {
+			skylines.push_back({ SkylineNode{ 0, 0, page_size } });
+			if (!skyline_insert(skylines.back(), page_size, padded_width, padded_height, region.x, region.y)) {
+				// The padding does not fit next to an image the size of the page, so place it unpadded.
+				skyline_insert(skylines.back(), page_size, region.width, region.height, region.x, region.y);
+			}
+			region.page = (int)skylines.size() - 1;
+		}
+	}
+	page_count = (int)skylines.size();
+}
+
+/// @brief Finds the lowest position for a rectangle on a skyline and adds it to the skyline.
+///
+/// @param skyline: The skyline of the page, sorted by x.
+/// @param page_size: The width and height of the page.
+/// @param width: The width of the rectangle.
+/// @param height: The height of the rectangle.
+/// @param out_x: Set to the x position of the rectangle if it fits.
+/// @param out_y: Set to the y position of the rectangle if it fits.
+/// @return bool: True if the rectangle fits in the page, otherwise false.
+bool PenguinTextureAtlas::skyline_insert(std::vector<SkylineNode>& skyline, int page_size, int width, int height, int& out_x, int& out_y) {
+	size_t best_index = skyline.size();
+	int best_bottom = INT_MAX;
+	int best_width = INT_MAX;
+	int best_y = 0;
+
+	for (size_t i = 0; i < skyline.size(); i++) {
+		int x = skyline[i].x;
+		if (x + width > page_size) {
+			break; // Every following segment starts further right.
+		}
+
+		// The rectangle rests on the highest segment it spans.
+		int y = 0;
+		int remaining = width;
+		for (size_t j = i; remaining > 0 && j < skyline.size(); j++) {
+			y = std::max(y, skyline[j].y);
+			remaining -= skyline[j].width;
+		}
+
+		if (y + height > page_size) {
+			continue;
+		}
+		if (y + height < best_bottom || (y + height == best_bottom && skyline[i].width < best_width)) {
+			best_index = i;
+			best_bottom = y + height;
+			best_width = skyline[i].width;
+			best_y = y;
+		}
+	}
+
+	if (best_index == skyline.size()) {
+		return false;
+	}
+
+	out_x = skyline[best_index].x;
+	out_y = best_y;
+	skyline.insert(skyline.begin() + best_index, SkylineNode{ out_x, best_y + height, width });
+
+	// Trim the segments now covered by the new one.
+	for (size_t i = best_index + 1; i < skyline.size();) {
+		const SkylineNode& previous = skyline[i - 1];
+		int overlap = previous.x + previous.width - skyline[i].x;
+		if (overlap <= 0) {
+			break;
+		}
+
+		skyline[i].x += overlap;
+		skyline[i].width -= overlap;
+		if (skyline[i].width > 0) {
+			break;
+		}
+		skyline.erase(skyline.begin() + i);
+	}
+
+	// Merge neighbouring segments at the same height.
+	for (size_t i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else {
+			i++;
+		}
+	}
+	return true;
+}